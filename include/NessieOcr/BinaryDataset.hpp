@@ -0,0 +1,114 @@
+/// @file
+/// @brief Declaration of BinaryDataset class
+
+#if !defined(_BINARY_DATASET_H)
+#define _BINARY_DATASET_H
+
+#include "Dataset.hpp"
+#include <string>
+#include <cstddef>
+
+
+///	@brief		Dataset built by reading a binary file of the filesystem.
+///
+///	@details	A PlainTextDataset has to parse every feature of every sample from text, which makes loading a large dataset slow. This class reads
+///	a binary file instead with a single read, and converts its samples into feature vectors without any parsing. Only the parsing is saved:
+///	like any other dataset, every process keeps its own copy of the samples in memory.
+///
+///	@details	The file starts with a header of BinaryDataset::headerSize bytes: an identifier, the version of the format, a value to detect a
+///	different byte order, the number of features, samples and classes, the size of the table of classes, the offset of the matrix of features
+///	and a FNV-1a checksum of everything after the header. The table of classes follows, with the code, the length and the bytes of the
+///	character of every class. Then, at an offset aligned to BinaryDataset::alignment bytes, come the features of every sample as single precision
+///	numbers, one sample after another, and finally the label of every sample. The file is in the byte order of the machine that wrote it.
+///
+///	@details	Features are stored in single precision, which keeps every digit of the features written by PlainTextDataset. A file can be written
+///	from any dataset with BinaryDataset::save(), which leaves out the rows removed, and a binary dataset is saved again when it is destroyed if
+///	samples were added or removed.
+///	The projection and the geometry model are kept in the same files next to the dataset as in a PlainTextDataset.
+///
+///	@see		Dataset, PlainTextDataset, DatasetEngine
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class BinaryDataset : public Dataset
+{
+	public:
+
+		///	@brief	Number of bytes of the header of a binary dataset file.
+		static const unsigned int headerSize = 40;
+
+		///	@brief	Number of bytes the matrix of features is aligned to inside the file.
+		static const unsigned int alignment = 64;
+
+		///	@brief		Constructor.
+		///
+		///	@param		filename	Path in the filesystem to the file containing the dataset.
+		///
+		///	@exception	NessieException	The file cannot be read, is not a valid binary dataset or its checksum does not match.
+		explicit BinaryDataset (const std::string& filename);
+
+		///	@brief	Destructor.
+		///
+		///	@post	The file is written again if samples were added or removed, and the geometry model is saved next to it if it is not empty.
+		virtual ~BinaryDataset ();
+
+		///	@brief		Add a sample to the dataset.
+		///
+		///	@param		sample Sample to add.
+		///
+		///	@post		The sample is appended to the end of the dataset.
+		///
+		///	@exception	NessieException	The number of features in the sample does not match with the dataset.
+		void addSample (const Sample& sample);
+
+		///	@brief		Remove a sample from the dataset.
+		///
+		///	@param		n	Row in the dataset where remove the sample.
+		///
+		///	@post		The row is marked as removed.
+		///
+		///	@exception	NessieException	The row is beyond the size of the dataset or it was already removed.
+		void removeSample (const unsigned int& n);
+
+		///	@brief		Write a dataset in the binary format.
+		///
+		///	@param		dataset		Dataset to write, whose rows removed are left out.
+		///	@param		filename	Name of the file, which is replaced atomically once completely written.
+		///
+		///	@post		The projection and the geometry model of the dataset are saved next to the file if they are not empty.
+		///
+		///	@exception	NessieException	The file could not be written.
+		static void save (const Dataset& dataset, const std::string& filename);
+
+		///	@brief	Check whether a file begins like a binary dataset file.
+		///
+		///	@param	filename	Path in the filesystem to the file.
+		///
+		///	@return	True if the file can be read and starts with the identifier of the format, false otherwise.
+		static bool recognizes (const std::string& filename);
+
+		///	@brief	Compute the FNV-1a checksum of some bytes.
+		///
+		///	@param	bytes	First byte.
+		///	@param	length	Number of bytes.
+		///	@param	hash	Checksum of the bytes that precede these ones, so that a checksum can be computed over several blocks of memory.
+		///
+		///	@return	The checksum.
+		static unsigned int checksum (const char* bytes, const std::size_t& length, unsigned int hash = 2166136261u);
+
+	private:
+
+		std::string	filename_;	///< File path where the data set is stored in the filesystem.
+
+		bool		modified_;	///< Whether samples were added or removed since the file was read.
+
+		///	@brief		Read the samples and the classes of a file loaded into memory.
+		///
+		///	@param		file	First byte of the file.
+		///	@param		length	Number of bytes of the file.
+		///
+		///	@exception	NessieException	The file is not a valid binary dataset or its checksum does not match.
+		void read (const char* file, const std::size_t& length);
+};
+
+#endif
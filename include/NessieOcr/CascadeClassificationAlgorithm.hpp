@@ -0,0 +1,126 @@
+/// @file
+/// @brief Declaration of CascadeClassificationAlgorithm class
+
+#if !defined(_CASCADE_CLASSIFICATION_ALGORITHM_H)
+#define _CASCADE_CLASSIFICATION_ALGORITHM_H
+
+class DatasetEngine;
+class FeatureVector;
+class Text;
+#include "ClassificationAlgorithm.hpp"
+#include "KnnClassificationAlgorithm.hpp"
+#include "ClassFilterIndex.hpp"
+#include "SearchEngine.hpp"
+#include "DistanceMetric.hpp"
+#include "GlyphGeometry.hpp"
+#include <vector>
+#include <string>
+
+
+///	@brief		Classification algorithm that resolves the easy feature vectors with a nearest class mean model and the rest with KNN.
+///
+///	@details	Most characters of a press clip are far from any class but their own, and comparing them with every sample of the dataset is a
+///	waste. This class first compares each feature vector with the mean of every class. If the nearest mean is clearly nearer than the second
+///	one, the feature vector is assigned to its class at once. The margin is measured as 1 - d1/d2, being d1 and d2 the Euclidean distances to the
+///	nearest and the second nearest means, so it ranges from 0 (a tie) to 1 (right on a mean). The feature vectors whose margin falls below a
+///	threshold are classified together by a KnnClassificationAlgorithm, which keeps its batches and threads.
+///
+///	@details	A threshold of 1 sends every feature vector to the KNN stage, and a threshold of 0 resolves all of them by the nearest mean. Training
+///	is delegated to the KNN stage, and the class means are updated with the samples it adds. The geometry of the characters is passed on to the
+///	KNN stage, restricted to the feature vectors that fall through to it.
+///
+///	@details	The distance metric is applied by the KNN stage, and the class means are computed over the samples it has transformed, so the
+///	weighted and Mahalanobis distances hold in both stages. The Manhattan distance is only used by the KNN stage, since the class means are
+///	compared by their Euclidean distance.
+///
+///	@see		KnnClassificationAlgorithm, ClassFilterIndex, CascadeClassifier
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class CascadeClassificationAlgorithm : public ClassificationAlgorithm
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		kNeighbours	Number of neighbours to take in the KNN stage.
+		/// @param		engine		A dataset engine information to load a dataset.
+		///	@param		threshold	Margin below which a feature vector falls through to the KNN stage.
+		///	@param		threads		Number of threads to use in the KNN stage.
+		///	@param		search		Engine used to search the nearest neighbours in the KNN stage.
+		///	@param		metric		Metric used to compare the queries with the samples.
+		///
+		///	@exception	NessieException	The threshold is not between 0 and 1.
+		explicit CascadeClassificationAlgorithm (const unsigned int& kNeighbours, DatasetEngine engine, const double& threshold, const unsigned int& threads = 1,
+												 SearchEngine search = SearchEngine::Exact(), DistanceMetric metric = DistanceMetric::Euclidean());
+
+		///	@brief	Destructor.
+		~CascadeClassificationAlgorithm ();
+
+		/// @brief	Classify a set of feature vectors into their most probably classes.
+		///
+		/// @param	featureVectors	An array of feature vectors.
+		///
+		/// @return An array of characters, one character per feature vector passed.
+		std::vector<std::string> classify (const std::vector<FeatureVector>& featureVectors) const;
+
+		/// @brief	Train the KNN stage, comparing each classification decision with a reference text.
+		///
+		/// @param	featureVectors	An array of feature vectors.
+		/// @param	characters		An array of std::string objects with characters that match the feature vectors.
+		/// @param	referenceText	A text to compare with the characters passed.
+		///
+		///	@return	The hit rate achieved after training (e.g. 0,9 for 90%).
+		double train (const std::vector<FeatureVector>& featureVectors, const std::vector<std::string>& characters, const Text& referenceText);
+
+		/// @brief	Train the KNN stage, comparing the classification decision for a single pattern with an ASCII code.
+		///
+		///	@param	featureVector	A feature vector that matches a character previously classified.
+		/// @param	character		A std::string object with sample character.
+		/// @param	asciiCode		An ASCII code to compare with the classification result.
+		///
+		///	@return	The hit rate achieved after training (e.g. 0,9 for 90%).
+		double train (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode);
+
+		///	@brief	Copy the fraction of feature vectors resolved by each stage in the last classification, and the statistics of the KNN stage,
+		///			into a statistics object.
+		///
+		///	@param	statistics	Statistics of the classification stage to update.
+		void updateStatistics (ClassifierStatistics& statistics) const;
+
+		///	@brief	Get the projection the feature vectors must be transformed with before they are classified.
+		///
+		///	@return	The projection of the dataset, which is empty if the dataset holds the image moments themselves.
+		const FeatureProjection* projection () const;
+
+		///	@brief	Get the time the last training of the KNN stage spent exchanging samples with the storage of the dataset.
+		///
+		///	@return	Elapsed time in seconds.
+		double storageTime () const;
+
+		///	@brief	Set the geometry of the characters the next feature vectors classified and trained come from.
+		///
+		///	@param	geometries	Geometry of every character, in the same order as the feature vectors.
+		void geometries (const std::vector<GlyphGeometry>& geometries);
+
+	private:
+
+		KnnClassificationAlgorithm	knn_;				///< Second stage.
+
+		ClassFilterIndex			means_;				///< Mean of every class of the dataset, used by the first stage.
+
+		double						threshold_;			///< Margin below which a feature vector falls through to the second stage.
+
+		std::vector<GlyphGeometry>	geometries_;		///< Geometry of the characters of the next feature vectors classified.
+
+		unsigned int				rows_;				///< Number of samples of the dataset already taken into account by the class means.
+
+		mutable double				firstStageRate_;	///< Percentage of feature vectors resolved by the first stage in the last classification.
+
+		mutable bool				secondStageUsed_;	///< Whether the second stage classified any feature vector in the last classification.
+
+		///	@brief	Update the class means with the samples added to the dataset since the last update.
+		void updateMeans ();
+};
+
+#endif
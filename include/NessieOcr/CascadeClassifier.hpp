@@ -0,0 +1,71 @@
+/// @file
+/// @brief Declaration of CascadeClassifier class
+
+#if !defined(_CASCADE_CLASSIFIER_H)
+#define _CASCADE_CLASSIFIER_H
+
+class FeatureVector;
+class Text;
+class DatasetEngine;
+#include "Classifier.hpp"
+#include "SearchEngine.hpp"
+#include "DistanceMetric.hpp"
+#include <string>
+#include <vector>
+
+
+///	@brief		Classifier of NessieOcr that resolves the easy characters by the nearest class mean and the rest by KNN.
+/// 
+///	@details	This class implements the Classifier class using a CascadeClassificationAlgorithm. Besides the parameters of a KnnClassifier, it
+///	needs the margin below which a character is sent to the KNN search. The fraction of characters resolved by each stage is reported in the
+///	classification statistics.
+/// 
+/// @see		Classifier, KnnClassifier, CascadeClassificationAlgorithm
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class CascadeClassifier : public Classifier
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		nNeighbours	Number of neighbours to search for every sample.
+		///	@param		engine		Dataset engine to use in classification and training methods.
+		///	@param		threshold	Margin between 0 and 1 below which a character is classified by the KNN search.
+		///	@param		threads		Number of threads to use when classifying.
+		///	@param		search		Engine used to search the nearest neighbours.
+		///	@param		metric		Metric used to compare the feature vectors with the samples.
+		///
+		explicit CascadeClassifier (const unsigned int& nNeighbours, DatasetEngine engine, const double& threshold, const unsigned int& threads = 1, SearchEngine search = SearchEngine::Exact(),
+									DistanceMetric metric = DistanceMetric::Euclidean());
+
+		///	@brief	Destructor.
+		virtual ~CascadeClassifier ();
+
+		///	@brief	Classify each feature vector passed into its most probably class (character).
+		///
+		/// @param	featureVectors	An array of feature vectors to classify.
+		///
+		///	@return	An array of std::string objects with the characters found, one character per vector in the array passed.
+		std::vector<std::string> performClassification (const std::vector<FeatureVector>& featureVectors);
+
+		/// @brief	Train the classifier, comparing each classification decision with a reference text.
+		/// 
+		///	@param	featureVectors	An array of feature vectors that matches the array of characters previously classified.
+		/// @param	characters		An array of std::string objects with classified characters for training.
+		/// @param	referenceText	A text to compare with the classificatios results to control the training decision.
+		///
+		///	@pre	The size of all input parameters must be equal.
+		void performTraining (const std::vector<FeatureVector>& featureVectors, const std::vector<std::string>& characters, const Text& referenceText);
+		
+		/// @brief	Train the classifier, comparing the classification decision for a single pattern with an ASCII code.
+		///
+		///	@param	featureVector	A feature vector that matches a character previously classified.
+		/// @param	character		A std::string object with sample character.
+		/// @param	asciiCode		An ASCII code to compare with the classification result.
+		void performTraining (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode);
+};
+
+#endif
+
@@ -0,0 +1,153 @@
+/// @file
+/// @brief Declaration of ClassFilterIndex class
+
+#if !defined(_CLASS_FILTER_INDEX_H)
+#define _CLASS_FILTER_INDEX_H
+
+class SampleMatrix;
+class NeighbourList;
+#include "KnnIndex.hpp"
+#include <string>
+#include <vector>
+#include <map>
+
+
+///	@brief		Nearest neighbour index that only scans the classes whose mean is nearest to the query.
+///
+///	@details	The samples are grouped by class, and the mean and the bounding box of the samples of every class are kept. A query ranks the
+///	classes by the distance to their mean and scans the samples of the nearest <em>C</em> classes, which usually hold the nearest neighbours since
+///	the samples of a character gather around its mean.
+///
+///	@details	In exact mode the remaining classes are then visited by increasing distance from the query to their bounding box, which is a lower
+///	bound of the distance to any of their samples. The search stops as soon as that bound exceeds the distance of the worst neighbour kept, so
+///	the result is the same as the one of a linear scan. Otherwise only the nearest <em>C</em> classes are scanned.
+///
+///	@details	Samples added after the index is built update the mean and the bounding box of their class, or create a new class. When the
+///	matrix is purged, only the classes that lost samples compute their mean and bounding box again, and the classes left without samples are
+///	dropped. Until then, a class whose samples have all been removed is left out of the searches.
+///
+///	@see		KnnIndex, SampleMatrix, SearchEngine
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class ClassFilterIndex : public KnnIndex
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		classes	Number of classes scanned first for every query.
+		///	@param		exact	Whether the rest of classes are visited while their bounding box does not prove them too far.
+		///
+		///	@exception	NessieException	The number of classes is zero.
+		explicit ClassFilterIndex (const unsigned int& classes, const bool& exact);
+
+		///	@brief	Destructor.
+		virtual ~ClassFilterIndex ();
+
+		///	@brief	Group the rows of a matrix by class and compute the mean and the bounding box of every class.
+		///
+		///	@param	matrix	Matrix of samples to index.
+		void build (const SampleMatrix& matrix);
+
+		///	@brief	Add a row that has been appended to the matrix to its class.
+		///
+		///	@param	matrix	Matrix of samples the index was built over.
+		///	@param	n		Row to add.
+		void append (const SampleMatrix& matrix, const unsigned int& n);
+
+		///	@brief	Take a row that has been marked as removed in the matrix out of the count of its class.
+		///
+		///	@param	matrix	Matrix of samples the index was built over.
+		///	@param	n		Row removed.
+		void remove (const SampleMatrix& matrix, const unsigned int& n);
+
+		///	@brief	Drop the rows purged from their classes.
+		///
+		///	@param	matrix	Matrix of samples the index was built over, already purged.
+		///	@param	rows	New number of every row before the purge.
+		void remap (const SampleMatrix& matrix, const std::vector<unsigned int>& rows);
+
+		///	@brief	Search the nearest rows of a query.
+		///
+		///	@param	matrix		Matrix of samples the index was built over.
+		///	@param	query		Query features padded by SampleMatrix::load().
+		///	@param	neighbours	List that receives the nearest rows, using squared distances.
+		///
+		///	@return	Number of distances to samples computed.
+		unsigned int search (const SampleMatrix& matrix, const double* query, NeighbourList& neighbours) const;
+
+		///	@brief	Get the two classes whose mean is nearest to a query.
+		///
+		///	@param	query			Query features padded by SampleMatrix::load().
+		///	@param	first			Label of the class with the nearest mean.
+		///	@param	firstDistance	Squared distance to the nearest mean, or infinity if there are no classes.
+		///	@param	second			Label of the class with the second nearest mean.
+		///	@param	secondDistance	Squared distance to the second nearest mean, or infinity if there are less than two classes.
+		///
+		///	@post	The classes whose samples have all been removed are not taken into account.
+		void nearestMeans (const double* query, unsigned int& first, double& firstDistance, unsigned int& second, double& secondDistance) const;
+
+	protected:
+
+		///	@brief	Get the identifier of a class filter index, which is written in its files.
+		///
+		///	@return	The identifier.
+		unsigned int identifier () const;
+
+		///	@brief	Append the samples, the mean and the bounding box of every class to a buffer.
+		///
+		///	@param	buffer	Buffer that receives the content.
+		void write (std::string& buffer) const;
+
+		///	@brief	Read the samples, the mean and the bounding box of every class appended by write().
+		///
+		///	@param	position	First byte of the content, which is advanced past it.
+		///	@param	end			End of the buffer.
+		///	@param	matrix		Matrix of samples the index was built over.
+		///
+		///	@return	True if the content is complete and matches the matrix, false otherwise.
+		bool read (const char*& position, const char* end, const SampleMatrix& matrix);
+
+	private:
+
+		unsigned int								classes_;	///< Number of classes scanned first.
+
+		bool										exact_;		///< Whether the search is exact.
+
+		unsigned int								stride_;	///< Padded number of features of the indexed matrix.
+
+		std::map<unsigned int, unsigned int>		index_;		///< Position of every label in the arrays below.
+
+		std::vector<unsigned int>					labels_;	///< Label of every class.
+
+		std::vector< std::vector<unsigned int> >	rows_;		///< Rows of the samples of every class.
+
+		std::vector<unsigned int>					live_;		///< Number of rows of every class that have not been removed.
+
+		std::vector<double>							sums_;		///< Sum of the samples of every class, one padded row after another.
+
+		std::vector<double>							means_;		///< Mean of the samples of every class, one padded row after another.
+
+		std::vector<double>							lower_;		///< Lowest value of every feature in every class, one padded row after another.
+
+		std::vector<double>							upper_;		///< Highest value of every feature in every class, one padded row after another.
+
+		///	@brief	Scan the samples of a class.
+		///
+		///	@param	matrix		Matrix of samples.
+		///	@param	query		Query features.
+		///	@param	c			Position of the class.
+		///	@param	neighbours	List that receives the nearest rows.
+		///
+		///	@return	Number of distances computed, which leaves out the rows removed.
+		unsigned int scan (const SampleMatrix& matrix, const double* query, const unsigned int& c, NeighbourList& neighbours) const;
+
+		///	@brief	Compute the sum, the mean and the bounding box of a class from its samples.
+		///
+		///	@param	matrix	Matrix of samples.
+		///	@param	c		Position of the class, which must have some sample.
+		void summarize (const SampleMatrix& matrix, const unsigned int& c);
+};
+
+#endif
@@ -7,6 +7,11 @@
 
 class FeatureVector;
 class Text;
+class ClassifierStatistics;
+class Dataset;
+class DatasetEngine;
+class FeatureProjection;
+class GlyphGeometry;
 #include <vector>
 #include <string>
 
@@ -54,6 +59,42 @@ class ClassificationAlgorithm
 		///
 		///	@return	The hit rate achieved after training (e.g. 0,9 for 90%).
 		virtual double train (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode) = 0;
+
+		///	@brief	Copy the statistics gathered by the algorithm during its last classification into a statistics object.
+		///
+		///	@param	statistics	Statistics of the classification stage to update.
+		///
+		///	@post	Only the fields the algorithm knows about are set. The default implementation leaves <em>statistics</em> untouched.
+		virtual void updateStatistics (ClassifierStatistics& statistics) const;
+
+		///	@brief	Get the time the last training spent exchanging samples with the storage of the dataset.
+		///
+		///	@return	Elapsed time in seconds. The default implementation returns 0.0.
+		virtual double storageTime () const;
+
+		///	@brief	Get the projection the feature vectors must be transformed with before they are classified.
+		///
+		///	@return	The projection of the dataset used, or a null value if the feature vectors are classified as they are. The default
+		///			implementation returns a null value.
+		virtual const FeatureProjection* projection () const;
+
+		///	@brief	Set the geometry of the characters the next feature vectors classified come from.
+		///
+		///	@param	geometries	Geometry of every character, in the same order as the feature vectors that will be classified and trained.
+		///
+		///	@post	The default implementation ignores the geometry.
+		virtual void geometries (const std::vector<GlyphGeometry>& geometries);
+
+	protected:
+
+		///	@brief		Create the dataset managed by a dataset engine.
+		///
+		///	@param		engine	A dataset engine information to load a dataset.
+		///
+		///	@return		A new dataset that the caller must delete.
+		///
+		///	@exception	NessieException	The engine requested is not supported by this build of the library.
+		static Dataset* createDataset (DatasetEngine engine);
 };
 
 #endif
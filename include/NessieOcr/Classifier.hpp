@@ -7,6 +7,8 @@
 class FeatureVector;
 class Text;
 class ClassificationAlgorithm;
+class FeatureProjection;
+class GlyphGeometry;
 #include "ClassifierStatistics.hpp"
 #include <string>
 #include <vector>
@@ -39,6 +41,17 @@ class Classifier
 		/// @return A ClassifierStatistics object.
 		virtual const ClassifierStatistics& statistics () const;
 
+		///	@brief	Get the projection the feature vectors must be transformed with before they are classified.
+		///
+		///	@return	A projection that might be empty, or a null value if the feature vectors are classified as they are.
+		const FeatureProjection* projection () const;
+
+		///	@brief	Set the geometry of the characters the next feature vectors classified come from, so that the algorithm can rule out the
+		///			classes that do not fit it.
+		///
+		///	@param	geometries	Geometry of every character, in the same order as the feature vectors.
+		void geometries (const std::vector<GlyphGeometry>& geometries);
+
 		///	@brief	Classify each feature vector passed into its most probably class (character).
 		///
 		/// @param	featureVectors	An array of feature vectors to classify.
@@ -64,6 +64,67 @@ class ClassifierStatistics : public Statistics
 		///	@return Miss rate in %.
 		double missRate ();
 
+		///	@brief	Set the number of threads used while classifying the feature vectors.
+		///
+		///	@param	threads	Number of threads.
+		void classificationThreads (const unsigned int& threads);
+
+		///	@brief	Get the number of threads used while classifying the feature vectors.
+		///
+		///	@return	Number of threads.
+		unsigned int classificationThreads ();
+
+		///	@brief	Set the average number of threads that were busy while the feature vectors were classified in parallel.
+		///
+		///	@param	concurrency	Ratio between the time spent by all the threads and the elapsed wall-clock time. It measures how busy the threads
+		///						were, not how much faster than a single thread they classified.
+		void concurrency (const double& concurrency);
+
+		///	@brief	Get the average number of threads that were busy while the feature vectors were classified in parallel.
+		///
+		///	@return	Ratio between the time spent by all the threads and the elapsed wall-clock time.
+		double concurrency ();
+
+		///	@brief	Set the number of distance evaluations that a search index avoided compared with a linear scan.
+		///
+		///	@param	distances	Number of distances not computed.
+		void avoidedDistances (const long unsigned int& distances);
+
+		///	@brief	Get the number of distance evaluations that a search index avoided compared with a linear scan.
+		///
+		///	@return	Number of distances not computed.
+		long unsigned int avoidedDistances ();
+
+		///	@brief	Set the percentage of feature vectors resolved by the first stage of a cascade classifier.
+		///
+		///	@param	rate	Percentage of feature vectors in %.
+		void firstStageRate (const double& rate);
+
+		///	@brief	Get the percentage of feature vectors resolved by the first stage of a cascade classifier.
+		///
+		///	@return	Percentage of feature vectors in %.
+		double firstStageRate ();
+
+		///	@brief	Set the percentage of feature vectors resolved by the second stage of a cascade classifier.
+		///
+		///	@param	rate	Percentage of feature vectors in %.
+		void secondStageRate (const double& rate);
+
+		///	@brief	Get the percentage of feature vectors resolved by the second stage of a cascade classifier.
+		///
+		///	@return	Percentage of feature vectors in %.
+		double secondStageRate ();
+
+		///	@brief	Set the elapsed time while exchanging samples with the storage of the dataset during the last training.
+		///
+		///	@param	elapsedTime	Elapsed time in seconds.
+		void storageTime (const double& elapsedTime);
+
+		///	@brief	Get the elapsed time while exchanging samples with the storage of the dataset during the last training.
+		///
+		///	@return Elapsed time in seconds.
+		double storageTime ();
+
 		/// @brief	Print the statistics gathered.
 		void print () const;
 
@@ -75,6 +136,18 @@ class ClassifierStatistics : public Statistics
 
 		std::auto_ptr<double>		missRate_;				///< Miss rate during training stage.
 
+		std::auto_ptr<unsigned int>	classificationThreads_;	///< Number of threads used while classifying the feature vectors.
+
+		std::auto_ptr<double>		concurrency_;		///< Average number of threads busy while classifying in parallel.
+
+		std::auto_ptr<long unsigned int>	avoidedDistances_;	///< Number of distance evaluations avoided by a search index.
+
+		std::auto_ptr<double>		firstStageRate_;		///< Percentage of feature vectors resolved by the first stage of a cascade.
+
+		std::auto_ptr<double>		secondStageRate_;		///< Percentage of feature vectors resolved by the second stage of a cascade.
+
+		std::auto_ptr<double>		storageTime_;			///< Elapsed time while exchanging samples with the storage of the dataset.
+
 		/// @brief	Update the total elapsed time.
 		///
 		/// @post	#totalTime_ is set by summing all the individual timers.
@@ -88,6 +161,9 @@ inline void ClassifierStatistics::updateTotalTime ()
 
 	if ( classificationTime_.get() != 0 )
 		totalTime_ += *classificationTime_;
+
+	if ( storageTime_.get() != 0 )
+		totalTime_ += *storageTime_;
 }
 
 inline void ClassifierStatistics::classificationTime (const double& elapsedTime)
@@ -121,5 +197,66 @@ inline double ClassifierStatistics::missRate ()
 	return *missRate_;
 }
 
+inline void ClassifierStatistics::classificationThreads (const unsigned int& threads)
+{
+	classificationThreads_.reset(new unsigned int(threads));
+}
+
+inline unsigned int ClassifierStatistics::classificationThreads ()
+{
+	return *classificationThreads_;
+}
+
+inline void ClassifierStatistics::concurrency (const double& concurrency)
+{
+	concurrency_.reset(new double(concurrency));
+}
+
+inline double ClassifierStatistics::concurrency ()
+{
+	return *concurrency_;
+}
+
+inline void ClassifierStatistics::avoidedDistances (const long unsigned int& distances)
+{
+	avoidedDistances_.reset(new long unsigned int(distances));
+}
+
+inline long unsigned int ClassifierStatistics::avoidedDistances ()
+{
+	return *avoidedDistances_;
+}
+
+inline void ClassifierStatistics::firstStageRate (const double& rate)
+{
+	firstStageRate_.reset(new double(rate));
+}
+
+inline double ClassifierStatistics::firstStageRate ()
+{
+	return *firstStageRate_;
+}
+
+inline void ClassifierStatistics::secondStageRate (const double& rate)
+{
+	secondStageRate_.reset(new double(rate));
+}
+
+inline double ClassifierStatistics::secondStageRate ()
+{
+	return *secondStageRate_;
+}
+
+inline void ClassifierStatistics::storageTime (const double& elapsedTime)
+{
+	storageTime_.reset(new double(elapsedTime));
+	updateTotalTime();
+}
+
+inline double ClassifierStatistics::storageTime ()
+{
+	return *storageTime_;
+}
+
 #endif
 
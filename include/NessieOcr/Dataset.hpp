@@ -9,6 +9,9 @@
 #include <string>
 #include <map>
 #include "FeatureVector.hpp"
+#include "FeatureProjection.hpp"
+#include "GeometryModel.hpp"
+class GlyphGeometry;
 
 
 /// @typedef	Sample.
@@ -25,9 +28,12 @@ typedef std::pair<FeatureVector, unsigned int> Sample;
 ///	previously recognized characters. A sample is composed of two fields: a feature vector and its code. The code is a numeric identifier that indicates the class
 /// where the feature vector belongs to. Any sample in the dataset can be read, and adding or deleting samples is also supported.
 ///
-///	@see		FeatureVector, Sample
+///	@details	Removing a sample only marks its row as removed, so it costs the same whatever the size of the dataset and the rows of the other
+///	samples do not change. The rows removed are still counted by Dataset::size() and can still be read, but every program that reads the whole
+///	dataset must skip them with Dataset::removed(). Dataset::purge() drops them all in a single pass and numbers the remaining samples again,
+///	which the owner of the dataset does when Dataset::needsPurge() tells that the rows removed are worth it.
 ///
-///	@todo		Implement a mechanism to condense the dataset by eliminating useless samples during training.
+///	@see		FeatureVector, Sample, DatasetCondenser
 ///
 /// @author Eliezer Talón (elitalon@gmail.com)
 /// @date 2009-02-12
@@ -50,9 +56,26 @@ class Dataset
 
 		///	@brief	Get the number of samples in the dataset.
 		///
-		///	@return	Number of samples in the dataset.
+		///	@return	Number of samples in the dataset, including the ones removed until the dataset is purged.
 		virtual const long unsigned int& size () const;
 
+		///	@brief	Check whether a row has been removed.
+		///
+		///	@param	n	Row in the dataset.
+		///
+		///	@return	True if the sample of the row has been removed and the dataset has not been purged since.
+		bool removed (const unsigned int& n) const;
+
+		///	@brief	Get the number of rows removed since the dataset was last purged.
+		///
+		///	@return	Number of rows removed.
+		const unsigned int& removedSamples () const;
+
+		///	@brief	Check whether the rows removed are enough to purge the dataset.
+		///
+		///	@return	True if the rows removed are at least a fourth of the rows of the dataset.
+		bool needsPurge () const;
+
 		///	@brief	Get the number of features per sample.
 		///
 		/// @return	Number of features per sample.
@@ -72,6 +95,32 @@ class Dataset
 		/// @return The character associated to the code or an empty string if there is no association.
 		virtual std::string character (const unsigned int& code) const;
 
+		///	@brief	Get the map of classes of the dataset.
+		///
+		///	@return	Map that associates every character with its code.
+		const std::map<std::string, unsigned int>& classes () const;
+
+		///	@brief	Get the projection that maps the features computed by FeatureExtractor into the features of the samples.
+		///
+		///	@return	The projection the samples were transformed with, or an empty projection if they hold the image moments themselves.
+		const FeatureProjection& projection () const;
+
+		///	@brief	Get the range of the geometry of the characters of every class.
+		///
+		///	@return	The geometry model of the dataset, which is empty if no character has been trained with a known geometry.
+		const GeometryModel& geometry () const;
+
+		///	@brief	Get the time spent exchanging samples with the storage of the dataset since it was built.
+		///
+		///	@return	Elapsed time in seconds, which only datasets stored in a database measure.
+		const double& storageTime () const;
+
+		///	@brief	Extend the range of the geometry of a class with the geometry of a character trained.
+		///
+		///	@param	code		Class of the character.
+		///	@param	geometry	Geometry of the character, which is ignored if it is unknown.
+		virtual void learnGeometry (const unsigned int& code, const GlyphGeometry& geometry);
+
 		///	@brief	Add a sample to the dataset.
 		///
 		///	@param	sample Sample to add.
@@ -84,8 +133,22 @@ class Dataset
 		///	@brief	Remove a sample from the dataset.
 		///
 		///	@param	n	Row in the dataset where remove the sample.
+		///
+		///	@post	The row is marked as removed, and every other sample keeps its row until the dataset is purged.
 		virtual void removeSample (const unsigned int& n) = 0;
 
+		///	@brief	Drop the rows removed from the dataset.
+		///
+		///	@post	The remaining samples keep their order and are numbered again from zero, and no row is marked as removed.
+		virtual void purge ();
+
+		///	@brief		Write the changes buffered by the dataset to where it is stored.
+		///
+		///	@details	Datasets that store every change as soon as it is made have nothing to write, which is the default.
+		///
+		///	@exception	NessieException	The changes could not be written.
+		virtual void flush ();
+
 	protected:
 
 		std::vector<Sample>					samples_;	///< Samples of the dataset.
@@ -95,6 +158,27 @@ class Dataset
 		long unsigned int					size_;		///< Number of samples.
 
 		unsigned int						features_;	///< Number of features per sample.
+
+		FeatureProjection					projection_;	///< Projection applied to the feature vectors before they are stored or classified.
+
+		GeometryModel						geometry_;	///< Range of the geometry of the characters of every class.
+
+		double								storageTime_;	///< Time spent exchanging samples with the storage of the dataset, in seconds.
+
+		std::vector<bool>					removed_;	///< Whether every row has been removed, which is empty until a row is.
+
+		unsigned int						removedSamples_;	///< Number of rows removed since the dataset was last purged.
+
+		///	@brief	Mark a row as removed.
+		///
+		///	@param	n	Row in the dataset, which must be within its size and not removed yet.
+		void markRemoved (const unsigned int& n);
+
+		///	@brief	Drop from an array the elements of the rows removed, keeping the order of the rest.
+		///
+		///	@param	rows	Array with an element for every row of the dataset, or for the first rows of it.
+		template <class T>
+		void purgeRows (std::vector<T>& rows) const;
 };
 
 
@@ -108,9 +192,57 @@ inline const long unsigned int& Dataset::size () const
 	return size_;
 }
 
+inline bool Dataset::removed (const unsigned int& n) const
+{
+	return n < removed_.size() and removed_[n];
+}
+
+inline const unsigned int& Dataset::removedSamples () const
+{
+	return removedSamples_;
+}
+
 inline const unsigned int& Dataset::features () const
 {
 	return features_;
 }
 
+inline const std::map<std::string, unsigned int>& Dataset::classes () const
+{
+	return classes_;
+}
+
+inline const FeatureProjection& Dataset::projection () const
+{
+	return projection_;
+}
+
+inline const GeometryModel& Dataset::geometry () const
+{
+	return geometry_;
+}
+
+inline const double& Dataset::storageTime () const
+{
+	return storageTime_;
+}
+
+template <class T>
+inline void Dataset::purgeRows (std::vector<T>& rows) const
+{
+	std::size_t kept = 0;
+	for ( std::size_t i = 0; i < rows.size(); ++i )
+	{
+		if ( not removed(i) )
+		{
+			if ( kept != i )
+				rows[kept] = rows[i];
+
+			++kept;
+		}
+	}
+
+	rows.erase(rows.begin() + kept, rows.end());
+}
+
 #endif
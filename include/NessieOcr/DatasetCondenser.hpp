@@ -0,0 +1,138 @@
+/// @file
+/// @brief Declaration of DatasetCondenser class
+
+#if !defined(_DATASET_CONDENSER_H)
+#define _DATASET_CONDENSER_H
+
+class Dataset;
+class NeighbourList;
+#include "SampleMatrix.hpp"
+#include <vector>
+
+
+///	@brief		Reduction of a KNN dataset to a smaller set of weighted prototypes.
+///
+///	@details	The datasets gathered by training repeat the same characters over and over, and a KNN classifier pays for every copy. This class
+///	selects a subset of the samples, the prototypes, that classifies the original samples as well as the whole dataset does. Every prototype has
+///	a weight, i.e. the number of original samples it stands for, that counts as that many votes when classifying. Three reductions are provided,
+///	and they are usually applied in the order below:
+///
+///	- DatasetCondenser::collapseDuplicates() merges the samples with exactly the same features and class into a single prototype.
+///	- DatasetCondenser::edit() applies Wilson's editing: a prototype that is misclassified by its nearest prototypes is removed, which cleans the
+///	class boundaries from noisy or mislabelled samples.
+///	- DatasetCondenser::condense() applies Hart's condensed nearest neighbour rule: only the prototypes needed to classify the rest correctly by
+///	the nearest neighbour are kept, and each removed prototype gives its weight to the nearest kept prototype of its class.
+///
+///	@details	The quality of the reduction is measured by DatasetCondenser::accuracy(), a leave-one-out estimate over the original samples: each
+///	sample is classified by the prototypes after taking its own vote away from the prototype that stands for it.
+///
+///	@see		Dataset, SampleMatrix, KnnClassificationAlgorithm
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class DatasetCondenser
+{
+	public:
+
+		///	@brief	Constructor.
+		///
+		///	@param	dataset	Dataset to reduce.
+		///
+		///	@post	Every sample of the dataset is a prototype with weight 1, and the rows removed from it are left out, so the samples are numbered
+		///			like the dataset once purged.
+		explicit DatasetCondenser (const Dataset& dataset);
+
+		///	@brief	Merge the prototypes that have exactly the same features and class.
+		///
+		///	@post	The first prototype of every group of duplicates is kept, with the sum of the weights of the group.
+		void collapseDuplicates ();
+
+		///	@brief		Remove the prototypes misclassified by their nearest prototypes (Wilson's editing).
+		///
+		///	@param		kNeighbours	Number of neighbours used to classify every prototype.
+		///
+		///	@post		Every prototype is classified against the rest at once, and the misclassified ones are removed with their weight.
+		///
+		///	@exception	NessieException	The number of neighbours is zero.
+		void edit (const unsigned int& kNeighbours);
+
+		///	@brief	Keep only the prototypes needed to classify the rest correctly by the nearest neighbour (Hart's condensed nearest neighbour).
+		///
+		///	@post	Every prototype removed gives its weight to the nearest kept prototype of the same class.
+		void condense ();
+
+		///	@brief		Estimate the accuracy of the prototypes by leave-one-out over the original samples.
+		///
+		///	@param		kNeighbours	Number of neighbours used to classify every sample.
+		///
+		///	@return		The hit rate achieved (e.g. 90.0 for 90%).
+		///
+		///	@exception	NessieException	The number of neighbours is zero.
+		double accuracy (const unsigned int& kNeighbours) const;
+
+		///	@brief	Get the number of original samples.
+		///
+		///	@return	Number of samples in the dataset reduced.
+		const unsigned int& samples () const;
+
+		///	@brief	Get the number of prototypes kept.
+		///
+		///	@return	Number of prototypes.
+		unsigned int prototypes () const;
+
+		///	@brief	Get the weight of an original sample.
+		///
+		///	@param	n	Row of the sample in the dataset reduced.
+		///
+		///	@return	The number of samples the sample stands for if it is a prototype, or 0 otherwise.
+		const unsigned int& weight (const unsigned int& n) const;
+
+		///	@brief		Add the prototypes to another dataset.
+		///
+		///	@param		dataset	Dataset that receives the prototypes, in the order they appear in the dataset reduced.
+		///
+		///	@exception	NessieException	The number of features of the dataset does not match.
+		void copyTo (Dataset& dataset) const;
+
+	private:
+
+		SampleMatrix				matrix_;	///< Samples of the dataset reduced.
+
+		std::vector<unsigned int>	weights_;	///< Weight of every sample, being 0 for the samples that are not prototypes.
+
+		std::vector<unsigned int>	owners_;	///< Prototype that carries the vote of every sample, or the number of samples if its vote was removed.
+
+		///	@brief	Get the rows of the prototypes kept.
+		///
+		///	@return	Rows of the prototypes in ascending order.
+		std::vector<unsigned int> prototypeRows () const;
+
+		///	@brief	Remove some prototypes and move the votes they carry to other ones.
+		///
+		///	@param	heirs	For every row, the prototype that receives its votes, the row itself to keep it, or the number of samples to remove
+		///					its votes. An heir must be a prototype that is kept.
+		void transfer (const std::vector<unsigned int>& heirs);
+
+		///	@brief	Classify a sample with the prototypes, taking its own vote away.
+		///
+		///	@param	reduced		Matrix with the prototypes in the order given by DatasetCondenser::prototypeRows().
+		///	@param	rows		Row of every prototype in the original matrix.
+		///	@param	sample		Row of the sample in the original matrix.
+		///	@param	neighbours	List of <em>k</em> + 1 neighbours used as scratch space, where <em>k</em> is the number of neighbours that vote.
+		///
+		///	@return	The most voted label. Ties are resolved in favour of the lowest label.
+		unsigned int classify (const SampleMatrix& reduced, const std::vector<unsigned int>& rows, const unsigned int& sample, NeighbourList& neighbours) const;
+};
+
+
+inline const unsigned int& DatasetCondenser::samples () const
+{
+	return matrix_.rows();
+}
+
+inline const unsigned int& DatasetCondenser::weight (const unsigned int& n) const
+{
+	return weights_.at(n);
+}
+
+#endif
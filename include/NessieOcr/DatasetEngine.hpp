@@ -5,6 +5,7 @@
 #define _DATASET_ENGINE_H
 
 #include <string>
+#include <vector>
 
 
 ///	@brief		Identifier of the engine that is used to manage the dataset.
@@ -29,6 +30,15 @@ class DatasetEngineType
 		///	@brief Get the unique identifier of a PostgreSQL-based dataset engine.
 		static DatasetEngineType PostgreSql () { return DatasetEngineType(3); };
 
+		///	@brief Get the unique identifier of a dataset engine split into several plain text files.
+		static DatasetEngineType Sharded () { return DatasetEngineType(4); };
+
+		///	@brief Get the unique identifier of a dataset engine based on a binary file.
+		static DatasetEngineType Binary () { return DatasetEngineType(5); };
+
+		///	@brief Get the unique identifier of a SQLite-based dataset engine.
+		static DatasetEngineType Sqlite () { return DatasetEngineType(6); };
+
 		///	@brief Equality operator overloading.
 		///
 		///	@param	engine	DatasetEngineType object to compare with.
@@ -73,11 +83,12 @@ class DatasetEngine
 		///	@param	database	Database where the dataset is stored.
 		///	@param	username	Name of the user who has access to the database.
 		///	@param	password	Password of the user who has access to the database.
+		///	@param	batchSize	Number of rows of every INSERT statement.
 		///
 		///	@return A DatasetEngine object properly initialized.
-		static DatasetEngine MySql (const std::string& database, const std::string& username, const std::string& password)
+		static DatasetEngine MySql (const std::string& database, const std::string& username, const std::string& password, const unsigned int& batchSize = 256)
 		{
-			return DatasetEngine(DatasetEngineType::MySql(), database, username, password);
+			return DatasetEngine(DatasetEngineType::MySql(), database, username, password, batchSize, "");
 		};
 
 		///	@brief	Get a PostgreSQL-based dataset engine.
@@ -85,13 +96,35 @@ class DatasetEngine
 		///	@param	database	Database where the dataset is stored.
 		///	@param	username	Name of the user who has access to the database.
 		///	@param	password	Password of the user who has access to the database.
+		///	@param	snapshot	File where a local copy of the samples is kept between runs, or an empty string to load them all every time.
 		///
 		///	@return A DatasetEngine object properly initialized.
-		static DatasetEngine PostgreSql (const std::string& database, const std::string& username, const std::string& password)
+		static DatasetEngine PostgreSql (const std::string& database, const std::string& username, const std::string& password, const std::string& snapshot = "")
 		{
-			return DatasetEngine(DatasetEngineType::PostgreSql(), database, username, password);
+			return DatasetEngine(DatasetEngineType::PostgreSql(), database, username, password, 0, snapshot);
 		};
 
+		///	@brief	Get a dataset engine whose samples are split into several plain text files, e.g. one per font or per newspaper.
+		///
+		///	@param	filenames	Filenames of the plain text files, which must have the same number of features.
+		///
+		///	@return A DatasetEngine object properly initialized.
+		static DatasetEngine Sharded (const std::vector<std::string>& filenames) { return DatasetEngine(DatasetEngineType::Sharded(), filenames); };
+
+		///	@brief	Get a dataset engine based on a binary file, which loads much faster than a plain text file.
+		///
+		///	@param	filename	Filename of the binary file that stores the dataset.
+		///
+		///	@return A DatasetEngine object properly initialized.
+		static DatasetEngine Binary (const std::string& filename) { return DatasetEngine(DatasetEngineType::Binary(), filename); };
+
+		///	@brief	Get a SQLite-based dataset engine, which writes the samples trained incrementally without a database server.
+		///
+		///	@param	filename	Filename of the SQLite database that stores the dataset.
+		///
+		///	@return A DatasetEngine object properly initialized.
+		static DatasetEngine Sqlite (const std::string& filename) { return DatasetEngine(DatasetEngineType::Sqlite(), filename); };
+
 		///	@brief	Get the unique identifier of the dataset engine.
 		///
 		///	@return	A DatasetEngineType object with its associated ID.
@@ -101,6 +134,11 @@ class DatasetEngine
 		///
 		///	@return A STL string with the filename.
 		const std::string& filename () const;
+
+		///	@brief	Get the names of the files where a sharded dataset is stored.
+		///
+		///	@return A STL vector with the filenames.
+		const std::vector<std::string>& filenames () const;
 		
 		///	@brief	Get the name of the database where the dataset is stored.
 		///
@@ -116,14 +154,30 @@ class DatasetEngine
 		///
 		///	@return A STL string with the password.
 		const std::string& password () const;
+
+		///	@brief	Get the number of samples a database-based dataset inserts at once.
+		///
+		///	@return	Number of samples, or zero if the dataset decides it.
+		const unsigned int& batchSize () const;
+
+		///	@brief	Get the file where a database-based dataset keeps a local copy of its samples.
+		///
+		///	@return	A STL string with the filename, which is empty if no copy is kept.
+		const std::string& snapshot () const;
 	
 	private:
 
 		///	@brief	Constructor.
 		///
 		///	@param	type		Identifier of the engine.
-		///	@param	filename	Filename of the plain text file that stores the dataset.
+		///	@param	filename	Filename of the file that stores the dataset.
 		explicit DatasetEngine (DatasetEngineType type, const std::string& filename);
+
+		///	@brief	Constructor.
+		///
+		///	@param	type		Identifier of the engine.
+		///	@param	filenames	Filenames of the plain text files that store the dataset.
+		explicit DatasetEngine (DatasetEngineType type, const std::vector<std::string>& filenames);
 		
 		///	@brief	Constructor.
 		///
@@ -131,18 +185,27 @@ class DatasetEngine
 		///	@param	database	Database where the dataset is stored.
 		///	@param	username	Name of the user who has access to the database.
 		///	@param	password	Password of the user who has access to the database.
-		explicit DatasetEngine (DatasetEngineType type, const std::string& database, const std::string& username, const std::string& password);
+		///	@param	batchSize	Number of samples inserted at once in the database.
+		///	@param	snapshot	File where a local copy of the samples is kept.
+		explicit DatasetEngine (DatasetEngineType type, const std::string& database, const std::string& username, const std::string& password,
+								const unsigned int& batchSize, const std::string& snapshot);
 
 
 		DatasetEngineType	type_;		///< Engine type
 
-		std::string			filename_;	///< File name when the engine is PlainText.
+		std::string			filename_;	///< File name when the engine is PlainText, Binary or Sqlite.
+
+		std::vector<std::string>	filenames_;	///< File names when the engine is Sharded.
 
 		std::string			database_;	///< Database name when the engine is a database, e.g. MySql.
 
 		std::string			username_;	///< Database user.
 
 		std::string			password_;	///< Database password.
+
+		unsigned int		batchSize_;	///< Number of samples inserted at once in the database.
+
+		std::string			snapshot_;	///< File where a local copy of the samples of a database is kept.
 };
 
 
@@ -156,6 +219,11 @@ inline const std::string& DatasetEngine::filename () const
 	return filename_;
 }
 
+inline const std::vector<std::string>& DatasetEngine::filenames () const
+{
+	return filenames_;
+}
+
 inline const std::string& DatasetEngine::database () const
 {
 	return database_;
@@ -170,5 +238,15 @@ inline const std::string& DatasetEngine::password () const
 {
 	return password_;
 }
+
+inline const unsigned int& DatasetEngine::batchSize () const
+{
+	return batchSize_;
+}
+
+inline const std::string& DatasetEngine::snapshot () const
+{
+	return snapshot_;
+}
 	
 #endif
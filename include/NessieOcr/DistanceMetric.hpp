@@ -0,0 +1,148 @@
+/// @file
+/// @brief Declaration of DistanceMetric class
+
+#if !defined(_DISTANCE_METRIC_H)
+#define _DISTANCE_METRIC_H
+
+class Dataset;
+#include <vector>
+
+
+///	@brief		Identifier of the metric used to compare feature vectors.
+///
+///	@details	This class provides a simple ID mechanism to identify the type of the metric whose parameters are stored in a DistanceMetric object.
+///
+///	@see		DistanceMetric
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class DistanceMetricType
+{
+	public:
+
+		///	@brief Get the unique identifier of the Euclidean distance.
+		static DistanceMetricType Euclidean () { return DistanceMetricType(1); };
+
+		///	@brief Get the unique identifier of the Manhattan distance, i.e. the sum of the absolute differences of the features.
+		static DistanceMetricType Manhattan () { return DistanceMetricType(2); };
+
+		///	@brief Get the unique identifier of the Euclidean distance with a weight for every feature.
+		static DistanceMetricType WeightedEuclidean () { return DistanceMetricType(3); };
+
+		///	@brief Get the unique identifier of the Mahalanobis distance, which takes into account the covariance of the features.
+		static DistanceMetricType Mahalanobis () { return DistanceMetricType(4); };
+
+		///	@brief Equality operator overloading.
+		///
+		///	@param	metric	DistanceMetricType object to compare with.
+		///
+		///	@return True if both identifiers are equal, false otherwise.
+		bool operator== (const DistanceMetricType& metric) const;
+
+	private:
+
+		///	@brief Constructor.
+		///
+		///	@param	type	Identifier of the metric type.
+		explicit DistanceMetricType (const unsigned int& type);
+
+
+		unsigned int id_;	///< Metric type identifier.
+};
+
+
+
+///	@brief		Metric used to compare a query with the samples of a dataset in the KNN classifier.
+///
+///	@details	This class provides a simple way to specify how KnnClassifier must measure the distance between two feature vectors, in the same
+///	fashion SearchEngine specifies how the dataset is searched. The metric is chosen once, when the classifier is built.
+///
+///	@details	The weighted Euclidean and the Mahalanobis distances are the Euclidean distance after a linear transformation of the features: the
+///	square roots of the weights in the first case, and the inverse of the Cholesky factor of the covariance of the dataset in the second one.
+///	SampleMatrix applies that transformation once to every sample and query, so both metrics cost the same as the plain Euclidean distance and
+///	every search engine works with them. The Manhattan distance needs its own kernel and is only available to the exact search engines that
+///	scan the samples.
+///
+///	@see		KnnClassifier, KnnClassificationAlgorithm, SampleMatrix
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class DistanceMetric
+{
+	public:
+
+		///	@brief	Get the Euclidean distance.
+		///
+		///	@return A DistanceMetric object properly initialized.
+		static DistanceMetric Euclidean () { return DistanceMetric(DistanceMetricType::Euclidean(), std::vector<double>(0)); };
+
+		///	@brief	Get the Manhattan distance.
+		///
+		///	@return A DistanceMetric object properly initialized.
+		static DistanceMetric Manhattan () { return DistanceMetric(DistanceMetricType::Manhattan(), std::vector<double>(0)); };
+
+		///	@brief	Get the Euclidean distance with a weight for every feature.
+		///
+		///	@param	weights	Weight of every feature, which multiplies its squared difference.
+		///
+		///	@return A DistanceMetric object properly initialized.
+		static DistanceMetric WeightedEuclidean (const std::vector<double>& weights)
+		{
+			return DistanceMetric(DistanceMetricType::WeightedEuclidean(), weights);
+		};
+
+		///	@brief	Get the Mahalanobis distance, whose covariance is estimated from the samples of the dataset.
+		///
+		///	@return A DistanceMetric object properly initialized.
+		static DistanceMetric Mahalanobis () { return DistanceMetric(DistanceMetricType::Mahalanobis(), std::vector<double>(0)); };
+
+		///	@brief	Get the unique identifier of the metric.
+		///
+		///	@return	A DistanceMetricType object with its associated ID.
+		DistanceMetricType type () const;
+
+		///	@brief	Get the weights of a weighted Euclidean distance.
+		///
+		///	@return	Weight of every feature.
+		const std::vector<double>& weights () const;
+
+		///	@brief		Compute the linear transformation of the features that turns the metric into the Euclidean distance.
+		///
+		///	@param		dataset	Dataset with the samples, whose covariance is used by the Mahalanobis distance.
+		///
+		///	@return		Lower triangular matrix with as many rows and columns as features, stored by rows, or an empty array if the features must not
+		///				be transformed.
+		///
+		///	@post		Features with no variance are ignored by the Mahalanobis distance, as well as the ones that are a linear combination of the
+		///				previous features.
+		///
+		///	@exception	NessieException	The number of weights does not match the number of features or a weight is negative, or the dataset has
+		///				less than two samples and the Mahalanobis distance is used.
+		std::vector<double> transformation (const Dataset& dataset) const;
+
+	private:
+
+		///	@brief	Constructor.
+		///
+		///	@param	type	Identifier of the metric.
+		///	@param	weights	Weight of every feature.
+		explicit DistanceMetric (DistanceMetricType type, const std::vector<double>& weights);
+
+
+		DistanceMetricType	type_;		///< Metric type.
+
+		std::vector<double>	weights_;	///< Weight of every feature when the metric is WeightedEuclidean.
+};
+
+
+inline DistanceMetricType DistanceMetric::type () const
+{
+	return type_;
+}
+
+inline const std::vector<double>& DistanceMetric::weights () const
+{
+	return weights_;
+}
+
+#endif
@@ -6,6 +6,7 @@
 
 class FeatureVector;
 class Pattern;
+class FeatureProjection;
 #include "FeatureExtractorStatistics.hpp"
 #include <vector>
 
@@ -45,6 +46,14 @@ class FeatureExtractor
 		///	@post	An array of feature vectors becomes available through the FeatureExtractor::featureVectors() method.
 		void computeMoments (const std::vector<Pattern>& patterns);
 
+		///	@brief	Transform the feature vectors with the projection of the dataset they are going to be classified with.
+		///
+		///	@param	projection	A projection whose number of inputs matches the number of features of the feature vectors.
+		///
+		///	@pre	FeatureExtractor::computeMoments() must have been previously executed.
+		///	@post	The feature vectors available through the FeatureExtractor::featureVectors() method are replaced by their projections.
+		void project (const FeatureProjection& projection);
+
 	private:
 
 		FeatureExtractorStatistics		statistics_;		///< Statistics about the execution of algorithms.
@@ -45,6 +45,16 @@ class FeatureExtractorStatistics : public Statistics
 		///	@return	Elapsed time in seconds.
 		double momentsComputingTime () const;
 
+		///	@brief	Set the elapsed time while projecting the feature vectors.
+		///
+		///	@param	elapsedTime	Elapsed time in seconds.
+		void projectionTime (const double& elapsedTime);
+
+		///	@brief	Get the elapsed time while projecting the feature vectors.
+		///
+		///	@return	Elapsed time in seconds.
+		double projectionTime () const;
+
 		/// @brief	Print the statistics gathered.
 		void print () const;
 
@@ -52,6 +62,8 @@ class FeatureExtractorStatistics : public Statistics
 
 		std::auto_ptr<double>	momentsComputingTime_;	///< Elapsed time while computing the image moments of patterns.
 
+		std::auto_ptr<double>	projectionTime_;		///< Elapsed time while projecting the feature vectors.
+
 		/// @brief	Update the total elapsed time.
 		///
 		/// @post	#totalTime_ is set by summing all the individual timers.
@@ -65,6 +77,9 @@ inline void FeatureExtractorStatistics::updateTotalTime ()
 
 	if ( momentsComputingTime_.get() != 0 )
 		totalTime_ += *momentsComputingTime_;
+
+	if ( projectionTime_.get() != 0 )
+		totalTime_ += *projectionTime_;
 }
 
 inline void FeatureExtractorStatistics::momentsComputingTime (const double& elapsedTime)
@@ -78,5 +93,16 @@ inline double FeatureExtractorStatistics::momentsComputingTime () const
 	return *momentsComputingTime_;
 }
 
+inline void FeatureExtractorStatistics::projectionTime (const double& elapsedTime)
+{
+	projectionTime_.reset(new double(elapsedTime));
+	updateTotalTime();
+}
+
+inline double FeatureExtractorStatistics::projectionTime () const
+{
+	return *projectionTime_;
+}
+
 #endif
 
@@ -0,0 +1,122 @@
+/// @file
+/// @brief Declaration of FeatureProjection class
+
+#if !defined(_FEATURE_PROJECTION_H)
+#define _FEATURE_PROJECTION_H
+
+class Dataset;
+#include "FeatureVector.hpp"
+#include <vector>
+#include <string>
+
+
+///	@brief		Linear map of the image moments into a smaller space where every component has the same weight.
+///
+///	@details	The image moments computed by FeatureExtractor differ by orders of magnitude, so the largest ones decide the Euclidean distance
+///	alone. This class is fitted on the samples of a dataset: every feature is standardised to zero mean and unit variance, and then the principal
+///	components of the standardised features are computed. A feature vector is projected onto the components with the largest variance, and each
+///	projection is divided by the standard deviation along its component. The projected features are uncorrelated and have unit variance, and
+///	fewer of them are needed to describe a character, so distances are both cheaper and more balanced.
+///
+///	@details	Standardisation, rotation and whitening are folded into a single matrix, so projecting costs one matrix-vector product. A projection
+///	is saved as plain text: the first line holds the number of inputs and outputs, the second the mean of every input, and each following line
+///	holds the weights of one output.
+///
+///	@see		FeatureExtractor, PlainTextDataset
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class FeatureProjection
+{
+	public:
+
+		///	@brief	Constructor.
+		///
+		///	@post	The projection is empty.
+		explicit FeatureProjection ();
+
+		///	@brief		Fit the projection on the samples of a dataset.
+		///
+		///	@param		dataset		Dataset with the samples.
+		///	@param		components	Number of components to keep, or zero to keep every component with non-zero variance.
+		///
+		///	@return		Fraction of the variance of the standardised features explained by the components kept.
+		///
+		///	@post		Components with zero variance are never kept, so the projection may have fewer outputs than requested.
+		///
+		///	@exception	NessieException	The dataset has less than two samples, or the number of components exceeds the number of features.
+		double fit (const Dataset& dataset, const unsigned int& components);
+
+		///	@brief		Project a feature vector.
+		///
+		///	@param		features	Feature vector with as many features as inputs of the projection.
+		///
+		///	@return		The projected feature vector.
+		///
+		///	@exception	NessieException	The size of the feature vector does not match the number of inputs.
+		FeatureVector project (const FeatureVector& features) const;
+
+		///	@brief		Save the projection to a file.
+		///
+		///	@param		filename	Name of the file, which is overwritten.
+		///
+		///	@exception	NessieException	The file could not be written.
+		void save (const std::string& filename) const;
+
+		///	@brief		Load a projection from a file written by FeatureProjection::save().
+		///
+		///	@param		filename	Name of the file.
+		///
+		///	@exception	NessieException	The file could not be read or is not a valid projection.
+		void load (const std::string& filename);
+
+		///	@brief	Get the number of features of the feature vectors projected.
+		///
+		///	@return	Number of inputs, or zero if the projection is empty.
+		const unsigned int& inputs () const;
+
+		///	@brief	Get the number of features of the projected feature vectors.
+		///
+		///	@return	Number of outputs, or zero if the projection is empty.
+		const unsigned int& outputs () const;
+
+		///	@brief	Check whether the projection has been fitted or loaded.
+		///
+		///	@return	True if the projection is empty.
+		bool empty () const;
+
+	private:
+
+		unsigned int		inputs_;	///< Number of features of the feature vectors projected.
+
+		unsigned int		outputs_;	///< Number of features of the projected feature vectors.
+
+		std::vector<double>	means_;		///< Mean of every input in the samples the projection was fitted on.
+
+		std::vector<double>	weights_;	///< Weights of every output, one row of inputs after another.
+
+		///	@brief	Compute the eigenvalues and eigenvectors of a symmetric matrix by the cyclic Jacobi method.
+		///
+		///	@param	matrix			Symmetric matrix stored by rows, whose diagonal holds the eigenvalues on return.
+		///	@param	n				Number of rows.
+		///	@param	eigenvectors	Matrix whose column <em>i</em> is the eigenvector of the <em>i</em>-th eigenvalue on return.
+		static void diagonalise (std::vector<double>& matrix, const unsigned int& n, std::vector<double>& eigenvectors);
+};
+
+
+inline const unsigned int& FeatureProjection::inputs () const
+{
+	return inputs_;
+}
+
+inline const unsigned int& FeatureProjection::outputs () const
+{
+	return outputs_;
+}
+
+inline bool FeatureProjection::empty () const
+{
+	return outputs_ == 0;
+}
+
+#endif
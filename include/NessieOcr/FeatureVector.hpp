@@ -4,91 +4,214 @@
 #if !defined(_FEATUREVECTOR_H)
 #define _FEATUREVECTOR_H
 
-#include <vector>
+#include <stdexcept>
+
+
+///	@brief		Read-only array of features whose elements may be computed on demand.
+///
+///	@details	This class is the base of FeatureVector and of the expressions built by its arithmetic operators, following the curiously recurring
+///	template pattern. An expression such as <em>a + b - c</em> is not evaluated when it is written, but when it is assigned to a FeatureVector,
+///	which computes every feature in a single loop with no temporary vectors.
+///
+///	@see		FeatureVector
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+template <class Expression>
+class FeatureExpression
+{
+	public:
+
+		///	@brief	Get the expression as its actual type.
+		///
+		///	@return	The expression.
+		const Expression& expression () const { return static_cast<const Expression&>(*this); };
+
+		///	@brief	Get the value of a feature, without checking its position.
+		///
+		///	@param	n	Position of the feature.
+		///
+		///	@return	The feature at given position.
+		double operator[] (const unsigned int& n) const { return expression()[n]; };
+
+		///	@brief	Get the number of features.
+		///
+		///	@return	Number of features.
+		unsigned int size () const { return expression().size(); };
+};
+
+
+
+///	@brief		Feature-wise operation between two feature expressions.
+///
+///	@details	The operands are held by reference, so an expression must be assigned to a FeatureVector in the same statement it is written.
+///
+///	@see		FeatureExpression
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+template <class Left, class Operation, class Right>
+class FeatureOperation : public FeatureExpression< FeatureOperation<Left, Operation, Right> >
+{
+	public:
+
+		///	@brief	Constructor.
+		///
+		///	@param	left	Left operand.
+		///	@param	right	Right operand, with as many features as the left one.
+		FeatureOperation (const Left& left, const Right& right) : left_(left), right_(right) {};
+
+		///	@brief	Compute a feature of the result.
+		///
+		///	@param	n	Position of the feature.
+		///
+		///	@return	The feature at given position.
+		double operator[] (const unsigned int& n) const { return Operation::apply(left_[n], right_[n]); };
+
+		///	@brief	Get the number of features.
+		///
+		///	@return	Number of features.
+		unsigned int size () const { return left_.size(); };
+
+	private:
+
+		const Left&		left_;	///< Left operand.
+
+		const Right&	right_;	///< Right operand.
+};
+
+
+///	@brief	Sum of two features.
+struct FeatureSum
+{
+	static double apply (const double& a, const double& b) { return a + b; };
+};
+
+
+///	@brief	Difference of two features.
+struct FeatureDifference
+{
+	static double apply (const double& a, const double& b) { return a - b; };
+};
+
 
 
 ///	@brief		Array of characteristic features that identifies a pattern.
-/// 
-/// @details	This class stores a set of features computed from a pattern where the character's pixels has been mapped.
 ///
-/// @todo		Implement another method to compute distance between vectors (e.g. the Mahalanobis distance).
-/// 
+/// @details	This class stores a set of features computed from a pattern where the character's pixels has been mapped. Up to
+///	FeatureVector::capacity features are stored inside the object itself, which covers the image moments computed by FeatureExtractor, so the
+///	samples of a dataset lie in a single dense array instead of one heap block each. Longer vectors are still allowed and keep their features in
+///	the heap.
+///
+///	@details	FeatureVector::at() checks the position of the feature, whereas the subscript operator does not and is meant for the loops that
+///	already know the size of the vector. The sum and subtraction operators build a FeatureExpression that is evaluated when it is assigned.
+///
+/// @see		DistanceMetric, which provides the Manhattan, weighted Euclidean and Mahalanobis distances to the KNN classifier.
+///
 /// @author Eliezer Talón (elitalon@gmail.com)
 /// @date 2009-02-04
-class FeatureVector
+class FeatureVector : public FeatureExpression<FeatureVector>
 {
 	public:
 
+		///	@brief	Maximum number of features stored without a heap allocation.
+		static const unsigned int capacity = 16;
+
 		///	@brief	Constructor.
 		///
-		///	@post	An empty feature vector of zero size is initialized. 
+		///	@post	An empty feature vector of zero size is initialized.
 		FeatureVector ();
-		
+
 		///	@brief	Constructor.
-		/// 
+		///
 		/// @param	n Number of features to store in the vector.
 		///
 		///	@post	An empty feature vector of size <em>n</em> is initialized to 0.0.
 		explicit FeatureVector (const unsigned int& n);
 
-		/// @brief	Allow read-and-write access to a certain feature.
+		///	@brief	Copy constructor.
+		///
+		///	@param	featureVector	Feature vector to copy.
+		FeatureVector (const FeatureVector& featureVector);
+
+		///	@brief	Constructor that evaluates a feature expression.
+		///
+		///	@param	expression	Expression built with the arithmetic operators.
+		template <class Expression>
+		FeatureVector (const FeatureExpression<Expression>& expression);
+
+		///	@brief	Destructor.
+		~FeatureVector ();
+
+		///	@brief	Assignment operator.
+		///
+		///	@param	featureVector	Feature vector to copy.
+		///
+		///	@return	A reference to this feature vector.
+		FeatureVector& operator= (const FeatureVector& featureVector);
+
+		///	@brief	Evaluate a feature expression into this vector.
+		///
+		///	@param	expression	Expression built with the arithmetic operators. It may refer to this vector.
+		///
+		///	@return	A reference to this feature vector.
+		template <class Expression>
+		FeatureVector& operator= (const FeatureExpression<Expression>& expression);
+
+		/// @brief		Allow read-and-write access to a certain feature.
+		///
+		/// @param		n	Position inside the vector where the feature is.
+		///
+		/// @return		The feature at given position.
+		///
+		///	@exception	std::out_of_range	The position is beyond the size of the vector.
+		double& at (const unsigned int& n);
+
+		///	@brief		Allow read-only access to a certain feature.
+		///
+		/// @param		n	Position inside the vector where the feature is.
+		///
+		/// @return		The feature at given position.
+		///
+		///	@exception	std::out_of_range	The position is beyond the size of the vector.
+		const double& at (const unsigned int& n) const;
+
+		///	@brief	Allow read-and-write access to a certain feature, without checking its position.
 		///
 		/// @param	n	Position inside the vector where the feature is.
-		/// 
+		///
 		/// @return The feature at given position.
-		double& at (const unsigned int& n);
+		double& operator[] (const unsigned int& n);
 
-		///	@brief	Allow read-only access to a certain feature.
+		///	@brief	Allow read-only access to a certain feature, without checking its position.
 		///
 		/// @param	n	Position inside the vector where the feature is.
-		/// 
+		///
 		/// @return The feature at given position.
-		const double& at (const unsigned int& n) const;
+		const double& operator[] (const unsigned int& n) const;
 
-		/// @brief		Compute the sum of two feature vectors.
-		/// 
-		/// @param		featureVector	Feature vector to sum.
-		/// 
-		/// @return		A FeatureVector object as a result of summing both feature vectors.
-		/// 
-		///	@exception	NessieException
-		FeatureVector operator+ (const FeatureVector& featureVector) const;
-
-		///	@brief		Compute the subtraction of two feature vectors.
-		/// 
-		/// @param		featureVector	Feature vector to subtract.
-		/// 
-		/// @return		A FeatureVector object as a result of subtracting both feature vectors.
-		/// 
-		///	@exception	NessieException
-		FeatureVector operator- (const FeatureVector& featureVector) const;
-
-		/// @brief		Compute the dot product of two feature vectors.
-		/// 
-		/// @param		featureVector	Feature vector to multiplicate.
-		/// 
-		/// @return		The result of multiplicating both feature vectors.
-		/// 
-		///	@exception	NessieException
-		double operator* (const FeatureVector& featureVector) const;
+		///	@brief	Get read-only access to the features.
+		///
+		///	@return	Pointer to the first feature.
+		const double* data () const;
 
 		/// @brief	Get the number of features held.
-		/// 
+		///
 		/// @return Number of features held.
 		const unsigned int& size () const;
-		
+
 		/// @brief	Clear the vector content.
 		///
 		///	@post	The features are removed and the size becomes 0.
 		void clear ();
-		
+
 		/// @brief	Reset the vector content.
 		///
 		///	@post	The features are set to 0.0 but the vector size remains equal.
 		void reset ();
-		
+
 		/// @brief	Resize the vector to the specified size.
-		/// 
+		///
 		/// @param	n Number of features to store in the vector.
 		///
 		///	@post	The previous features are removed and an new vector of size <em>n</em> is initialized to 0.0.
@@ -101,22 +224,86 @@ class FeatureVector
 		///	@return	The Euclidean distance between this vector and the input vector.
 		double computeEuclideanDistance (const FeatureVector& featureVector) const;
 
+		///	@brief		Check that two operands of an arithmetic operator have the same size.
+		///
+		///	@param		left		Size of the left operand.
+		///	@param		right		Size of the right operand.
+		///	@param		operation	Name of the operator, for the message of the exception.
+		///
+		///	@exception	NessieException	The sizes are different.
+		static void checkSizes (const unsigned int& left, const unsigned int& right, const char* operation);
+
 	private:
 
-		std::vector<double>	features_;	///< Characteristic features of the pattern.
-		
-		unsigned int		size_;		///< Size of the vector.
+		double			buffer_[capacity];	///< Storage of the features when they fit in the object.
+
+		double*			features_;			///< Characteristic features of the pattern, either in the buffer or in the heap.
+
+		unsigned int	size_;				///< Size of the vector.
+
+		///	@brief	Release the features and make room for a new number of them, which are left uninitialized.
+		///
+		///	@param	n	Number of features.
+		void allocate (const unsigned int& n);
 };
 
 
+template <class Expression>
+FeatureVector::FeatureVector (const FeatureExpression<Expression>& expression)
+:	features_(buffer_),
+	size_(0)
+{
+	allocate(expression.size());
+
+	for ( unsigned int i = 0; i < size_; ++i )
+		features_[i] = expression[i];
+}
+
+template <class Expression>
+FeatureVector& FeatureVector::operator= (const FeatureExpression<Expression>& expression)
+{
+	// Every feature of the result only depends on the features at the same position, so the operands may include this vector
+	if ( expression.size() != size_ )
+	{
+		FeatureVector result(expression);
+		return *this = result;
+	}
+
+	for ( unsigned int i = 0; i < size_; ++i )
+		features_[i] = expression[i];
+
+	return *this;
+}
+
 inline double& FeatureVector::at (const unsigned int &n)
 {
-	return features_.at(n);
+	if ( n >= size_ )
+		throw std::out_of_range ("FeatureVector::at() : The position is beyond the size of the vector.");
+
+	return features_[n];
 }
 
 inline const double& FeatureVector::at (const unsigned int &n) const
 {
-	return features_.at(n);
+	if ( n >= size_ )
+		throw std::out_of_range ("FeatureVector::at() : The position is beyond the size of the vector.");
+
+	return features_[n];
+}
+
+inline double& FeatureVector::operator[] (const unsigned int &n)
+{
+	return features_[n];
+}
+
+inline const double& FeatureVector::operator[] (const unsigned int &n) const
+{
+	return features_[n];
+}
+
+inline const double* FeatureVector::data () const
+{
+	return features_;
 }
 
 inline const unsigned int& FeatureVector::size () const
@@ -126,20 +313,73 @@ inline const unsigned int& FeatureVector::size () const
 
 inline void FeatureVector::clear ()
 {
-	features_.clear();
-	size_ = 0;
+	allocate(0);
 }
 
 inline void FeatureVector::reset ()
 {
-	features_.assign(size_, 0.0);
+	for ( unsigned int i = 0; i < size_; ++i )
+		features_[i] = 0.0;
 }
 
 inline void FeatureVector::resize (const unsigned int& n)
 {
-	size_ = n;
+	allocate(n);
 	reset();
 }
 
-#endif
 
+///	@brief		Compute the sum of two feature vectors.
+///
+///	@param		left	First feature vector or expression.
+///	@param		right	Second feature vector or expression.
+///
+///	@return		An expression that is evaluated when assigned to a FeatureVector.
+///
+///	@exception	NessieException	The sizes of the operands are different.
+template <class Left, class Right>
+inline FeatureOperation<Left, FeatureSum, Right> operator+ (const FeatureExpression<Left>& left, const FeatureExpression<Right>& right)
+{
+	FeatureVector::checkSizes(left.size(), right.size(), "operator+");
+	return FeatureOperation<Left, FeatureSum, Right>(left.expression(), right.expression());
+}
+
+///	@brief		Compute the subtraction of two feature vectors.
+///
+///	@param		left	Feature vector or expression to subtract from.
+///	@param		right	Feature vector or expression to subtract.
+///
+///	@return		An expression that is evaluated when assigned to a FeatureVector.
+///
+///	@exception	NessieException	The sizes of the operands are different.
+template <class Left, class Right>
+inline FeatureOperation<Left, FeatureDifference, Right> operator- (const FeatureExpression<Left>& left, const FeatureExpression<Right>& right)
+{
+	FeatureVector::checkSizes(left.size(), right.size(), "operator-");
+	return FeatureOperation<Left, FeatureDifference, Right>(left.expression(), right.expression());
+}
+
+///	@brief		Compute the dot product of two feature vectors.
+///
+///	@param		left	First feature vector or expression.
+///	@param		right	Second feature vector or expression.
+///
+///	@return		The result of multiplicating both operands.
+///
+///	@exception	NessieException	The sizes of the operands are different.
+template <class Left, class Right>
+inline double operator* (const FeatureExpression<Left>& left, const FeatureExpression<Right>& right)
+{
+	FeatureVector::checkSizes(left.size(), right.size(), "operator*");
+
+	const Left& a	= left.expression();
+	const Right& b	= right.expression();
+
+	double result = 0.0;
+	for ( unsigned int i = 0; i < a.size(); ++i )
+		result += a[i] * b[i];
+
+	return result;
+}
+
+#endif
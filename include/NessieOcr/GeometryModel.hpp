@@ -0,0 +1,112 @@
+/// @file
+/// @brief Declaration of GeometryModel class
+
+#if !defined(_GEOMETRY_MODEL_H)
+#define _GEOMETRY_MODEL_H
+
+class GlyphGeometry;
+#include <map>
+#include <string>
+
+
+///	@brief		Range of the geometry of the characters of every class, learnt from the characters trained.
+///
+///	@details	Every time a character of a class is trained with a known GlyphGeometry, the range of ascents, descents and aspect ratios of the
+///	class is extended to include it. A class admits a geometry if it falls within the range of the class, widened by a tolerance of a quarter of
+///	the height of the lowercase letters for the ascent and the descent, and by a factor of 1.5 for the aspect ratio. A class that has been trained
+///	less than GeometryModel::minimumSamples times admits every geometry, as well as a class the model knows nothing about, so that the model only
+///	rules out the classes it has enough evidence against.
+///
+///	@details	A model is saved as plain text, with one class per line: the code of the class, the number of characters learnt, and the minimum
+///	and maximum of the ascent, the descent and the aspect ratio.
+///
+///	@see		GlyphGeometry, Dataset, KnnClassificationAlgorithm
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class GeometryModel
+{
+	public:
+
+		///	@brief	Number of characters of a class that must be learnt before the class rules out any geometry.
+		static const unsigned int minimumSamples = 5;
+
+		///	@brief	Constructor.
+		///
+		///	@post	The model is empty.
+		explicit GeometryModel ();
+
+		///	@brief	Extend the range of a class to include the geometry of a character.
+		///
+		///	@param	code		Class of the character.
+		///	@param	geometry	Geometry of the character, which is ignored if it is unknown.
+		void learn (const unsigned int& code, const GlyphGeometry& geometry);
+
+		///	@brief	Extend the range of every class to include the ranges of another model.
+		///
+		///	@param	model	Model to merge.
+		void merge (const GeometryModel& model);
+
+		///	@brief	Check whether a character of a class may have a geometry.
+		///
+		///	@param	code		Class of the character.
+		///	@param	geometry	Geometry of the character.
+		///
+		///	@return	False if the class has been trained enough and the geometry is known and falls out of its range, true otherwise.
+		bool admits (const unsigned int& code, const GlyphGeometry& geometry) const;
+
+		///	@brief	Check whether the model has learnt any character.
+		///
+		///	@return	True if the model is empty.
+		bool empty () const;
+
+		///	@brief		Save the model to a file.
+		///
+		///	@param		filename	Name of the file, which is overwritten.
+		///
+		///	@exception	NessieException	The file could not be written.
+		void save (const std::string& filename) const;
+
+		///	@brief		Load a model from a file written by GeometryModel::save().
+		///
+		///	@param		filename	Name of the file.
+		///
+		///	@exception	NessieException	The file could not be read or is not a valid model.
+		void load (const std::string& filename);
+
+	private:
+
+		///	@brief	Range of the geometry of the characters of a class.
+		struct Range
+		{
+			unsigned int	samples;		///< Number of characters learnt.
+
+			double			minAscent;		///< Minimum ascent.
+
+			double			maxAscent;		///< Maximum ascent.
+
+			double			minDescent;		///< Minimum descent.
+
+			double			maxDescent;		///< Maximum descent.
+
+			double			minAspectRatio;	///< Minimum aspect ratio.
+
+			double			maxAspectRatio;	///< Maximum aspect ratio.
+		};
+
+		std::map<unsigned int, Range>	ranges_;	///< Range of every class learnt.
+
+		///	@brief	Extend a range to include another one.
+		///
+		///	@param	range	Range to extend.
+		///	@param	other	Range to include.
+		static void extend (Range& range, const Range& other);
+};
+
+
+inline bool GeometryModel::empty () const
+{
+	return ranges_.empty();
+}
+
+#endif
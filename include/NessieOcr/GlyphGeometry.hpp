@@ -0,0 +1,94 @@
+/// @file
+/// @brief Declaration of GlyphGeometry class
+
+#if !defined(_GLYPH_GEOMETRY_H)
+#define _GLYPH_GEOMETRY_H
+
+
+///	@brief		Position and shape of a character within its line of text.
+///
+///	@details	Patterns are normalized to a constant size before their features are computed, so a comma and an apostrophe, or an <em>o</em>
+///	and an <em>O</em>, may end up with very similar image moments. The Preprocessor knows where every region lies within its line, and this class
+///	keeps that information, measured in units of the height of the lowercase letters of the line so that it does not depend on the font size:
+///
+///	- The ascent is how far the top of the region rises above the top of the lowercase letters, e.g. about 0 for an <em>x</em> and about
+///	0.5 for a <em>d</em> or a capital letter.
+///	- The descent is how far the bottom of the region sinks below the baseline, e.g. about 0 for an <em>x</em> and about 0.4 for a
+///	<em>p</em>.
+///	- The aspect ratio is the height of the region divided by its width.
+///
+///	@details	A geometry built with the default constructor is unknown, which happens for patterns that were not found within a line of text.
+///
+///	@see		Preprocessor, Pattern, GeometryModel
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class GlyphGeometry
+{
+	public:
+
+		///	@brief	Constructor.
+		///
+		///	@post	The geometry is unknown.
+		explicit GlyphGeometry ();
+
+		///	@brief	Constructor.
+		///
+		///	@param	ascent		Height of the region above the lowercase letters, relative to their height.
+		///	@param	descent		Depth of the region below the baseline, relative to the height of the lowercase letters.
+		///	@param	aspectRatio	Height of the region divided by its width.
+		explicit GlyphGeometry (const double& ascent, const double& descent, const double& aspectRatio);
+
+		///	@brief	Get the height of the region above the lowercase letters.
+		///
+		///	@return	Ascent relative to the height of the lowercase letters.
+		const double& ascent () const;
+
+		///	@brief	Get the depth of the region below the baseline.
+		///
+		///	@return	Descent relative to the height of the lowercase letters.
+		const double& descent () const;
+
+		///	@brief	Get the height of the region divided by its width.
+		///
+		///	@return	Aspect ratio.
+		const double& aspectRatio () const;
+
+		///	@brief	Check whether the geometry was measured.
+		///
+		///	@return	True if the region was found within a line of text.
+		const bool& known () const;
+
+	private:
+
+		double	ascent_;		///< Height of the region above the lowercase letters.
+
+		double	descent_;		///< Depth of the region below the baseline.
+
+		double	aspectRatio_;	///< Height of the region divided by its width.
+
+		bool	known_;			///< Whether the geometry was measured.
+};
+
+
+inline const double& GlyphGeometry::ascent () const
+{
+	return ascent_;
+}
+
+inline const double& GlyphGeometry::descent () const
+{
+	return descent_;
+}
+
+inline const double& GlyphGeometry::aspectRatio () const
+{
+	return aspectRatio_;
+}
+
+inline const bool& GlyphGeometry::known () const
+{
+	return known_;
+}
+
+#endif
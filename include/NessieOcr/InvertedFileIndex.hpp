@@ -0,0 +1,155 @@
+/// @file
+/// @brief Declaration of InvertedFileIndex class
+
+#if !defined(_INVERTED_FILE_INDEX_H)
+#define _INVERTED_FILE_INDEX_H
+
+class SampleMatrix;
+class NeighbourList;
+#include "KnnIndex.hpp"
+#include <string>
+#include <vector>
+
+
+///	@brief		Approximate nearest neighbour index based on an inverted file with product-quantized residuals.
+///
+///	@details	The samples are first divided into a number of coarse clusters by the k-means algorithm, and every sample is stored in the
+///	inverted list of its nearest cluster centroid. Instead of its features, each sample keeps a short code of its residual, i.e. the difference
+///	between the sample and its centroid: the padded feature space is split into <em>m</em> subspaces, every subspace has its own codebook of up to
+///	256 codewords learnt by k-means, and the residual is encoded as the index of the nearest codeword in each subspace, one byte per subspace.
+///
+///	@details	A query only visits the <em>probes</em> inverted lists whose centroids are nearest to it. For each visited list a table with the
+///	distance between the query residual and every codeword is computed once, and the distance to each sample is approximated by adding <em>m</em>
+///	values from that table. Increasing the number of probes or of subquantizers improves the recall at the cost of speed.
+///
+///	@details	Samples added after the index is built are assigned to the existing clusters and encoded with the existing codebooks. If the matrix
+///	was empty when the index was built there is nothing to train with, so the search falls back to a linear scan of the matrix. Since training
+///	the centroids and the codebooks is the slowest part, they can be saved to a file together with the inverted lists with KnnIndex::save(). For
+///	the same reason, purging the matrix only drops the rows purged from the inverted lists and keeps the centroids and the codebooks.
+///
+///	@see		KnnIndex, SampleMatrix, SearchEngine
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class InvertedFileIndex : public KnnIndex
+{
+	public:
+
+		///	@brief	Maximum number of codewords per subspace, so that a code fits in one byte.
+		static const unsigned int codewords = 256;
+
+		///	@brief	Number of iterations of the k-means algorithm when training centroids and codebooks.
+		static const unsigned int iterations = 10;
+
+		///	@brief		Constructor.
+		///
+		///	@param		lists			Number of coarse clusters.
+		///	@param		subquantizers	Number of subspaces, i.e. bytes per sample.
+		///	@param		probes			Number of inverted lists visited per query.
+		///
+		///	@exception	NessieException	Any of the parameters is zero.
+		explicit InvertedFileIndex (const unsigned int& lists, const unsigned int& subquantizers, const unsigned int& probes);
+
+		///	@brief	Destructor.
+		virtual ~InvertedFileIndex ();
+
+		///	@brief		Train the coarse centroids and the codebooks from every row of a matrix, and encode the rows.
+		///
+		///	@param		matrix	Matrix of samples to index.
+		///
+		///	@exception	NessieException	The number of subquantizers does not divide the padded number of features.
+		void build (const SampleMatrix& matrix);
+
+		///	@brief	Encode a row that has been appended to the matrix and add it to the inverted list of its nearest centroid.
+		///
+		///	@param	matrix	Matrix of samples the index was built over.
+		///	@param	n		Row to add.
+		void append (const SampleMatrix& matrix, const unsigned int& n);
+
+		///	@brief	Drop the rows purged from the inverted lists.
+		///
+		///	@param	matrix	Matrix of samples the index was built over, already purged.
+		///	@param	rows	New number of every row before the purge.
+		void remap (const SampleMatrix& matrix, const std::vector<unsigned int>& rows);
+
+		///	@brief	Search the approximate nearest rows of a query.
+		///
+		///	@param	matrix		Matrix of samples the index was built over.
+		///	@param	query		Query features padded by SampleMatrix::load().
+		///	@param	neighbours	List that receives the nearest rows, using approximate squared distances.
+		///
+		///	@return	Number of approximate distances computed.
+		unsigned int search (const SampleMatrix& matrix, const double* query, NeighbourList& neighbours) const;
+
+	protected:
+
+		///	@brief	Get the identifier of an inverted file index, which is written in its files.
+		///
+		///	@return	The identifier.
+		unsigned int identifier () const;
+
+		///	@brief	Append the centroids, the codebooks and the inverted lists to a buffer.
+		///
+		///	@param	buffer	Buffer that receives the content.
+		void write (std::string& buffer) const;
+
+		///	@brief	Read the centroids, the codebooks and the inverted lists appended by write().
+		///
+		///	@param	position	First byte of the content, which is advanced past it.
+		///	@param	end			End of the buffer.
+		///	@param	matrix		Matrix of samples the index was built over.
+		///
+		///	@return	True if the content is complete and was written with the same number of lists and subquantizers, false otherwise.
+		bool read (const char*& position, const char* end, const SampleMatrix& matrix);
+
+	private:
+
+		unsigned int								lists_;			///< Number of coarse clusters requested.
+
+		unsigned int								subquantizers_;	///< Number of subspaces.
+
+		unsigned int								probes_;		///< Number of inverted lists visited per query.
+
+		unsigned int								stride_;		///< Padded number of features of the indexed matrix.
+
+		unsigned int								subDimension_;	///< Number of features per subspace.
+
+		unsigned int								codewords_;		///< Number of codewords actually trained per subspace.
+
+		std::vector<double>							centroids_;		///< Coarse centroids, one padded row after another.
+
+		std::vector<double>							codebooks_;		///< Codewords of every subspace, subspace after subspace.
+
+		std::vector< std::vector<unsigned int> >	listRows_;		///< Rows of the matrix stored in every inverted list.
+
+		std::vector< std::vector<unsigned char> >	listCodes_;		///< Codes of the rows stored in every inverted list, <em>m</em> bytes per row.
+
+		///	@brief	Get the nearest of a set of points to a given point.
+		///
+		///	@param	points		Set of points, one after another.
+		///	@param	nPoints		Number of points.
+		///	@param	dimension	Number of coordinates per point.
+		///	@param	point		Point of reference.
+		///
+		///	@return	Index of the nearest point.
+		static unsigned int nearest (const double* points, const unsigned int& nPoints, const unsigned int& dimension, const double* point);
+
+		///	@brief	Cluster a set of points using the k-means algorithm.
+		///
+		///	@param	points		Set of points, one after another.
+		///	@param	nPoints		Number of points.
+		///	@param	dimension	Number of coordinates per point.
+		///	@param	k			Number of clusters.
+		///	@param	centroids	Array that receives the <em>k</em> centroids, one after another.
+		///
+		///	@post	The centroids are initialized with evenly spaced points, so that the result is deterministic.
+		static void kMeans (const std::vector<double>& points, const unsigned int& nPoints, const unsigned int& dimension, const unsigned int& k, std::vector<double>& centroids);
+
+		///	@brief	Add a row of the matrix to the inverted list of its nearest centroid.
+		///
+		///	@param	matrix	Matrix of samples.
+		///	@param	n		Row to add.
+		void encode (const SampleMatrix& matrix, const unsigned int& n);
+};
+
+#endif
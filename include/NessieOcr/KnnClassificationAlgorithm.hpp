@@ -8,7 +8,13 @@ class DatasetEngine;
 class Dataset;
 class FeatureVector;
 class Text;
+class NeighbourList;
+class KnnIndex;
 #include "ClassificationAlgorithm.hpp"
+#include "SampleMatrix.hpp"
+#include "SearchEngine.hpp"
+#include "DistanceMetric.hpp"
+#include "GlyphGeometry.hpp"
 #include <vector>
 #include <string>
 
@@ -17,6 +23,41 @@ class Text;
 ///
 ///	@details	This class implements the ClassificationAlgorithm class using the KNN paradigm for classifying and/or training purposes. The number of
 ///	neighbours to take into account is set in the class constructor, as well as the necessary dataset.
+///
+///	@details	The samples of the dataset are copied into a SampleMatrix when the algorithm is built, and every sample added during training is
+///	appended to it as well. The search compares squared distances over that matrix and keeps the nearest neighbours in a NeighbourList, so
+///	that no memory is allocated and no square root is taken while scanning the dataset. When a whole press clip is classified at once, the
+///	queries are searched in batches through the blocked kernel of SampleMatrix so that the dataset is read once per batch.
+///
+///	@details	The queries can also be classified by several threads. They are split in chunks that idle threads take one after another from a
+///	shared counter, so a thread that finishes early keeps taking work from the slower ones. Each thread allocates its own neighbour lists once and
+///	writes the result of every query to a slot reserved for it, so the output does not depend on the number of threads or on their scheduling.
+///
+///	@details	By default the search is exact. A SearchEngine other than SearchEngine::Exact() makes the algorithm build a KnnIndex over the matrix,
+///	which is searched query by query instead of scanning every sample. Samples added during training are added to the index too. The number of
+///	distances the index avoided computing, compared with a linear scan, is reported in the classification statistics.
+///
+///	@details	A sample, or every sample of a class that was trained wrongly, can be removed from both the dataset and the matrix. Their rows are
+///	only marked as removed, so the searches skip them and no other row changes its number. Once the rows removed are enough for
+///	Dataset::needsPurge(), the dataset and the matrix are purged together and the index numbers its rows again with KnnIndex::remap() instead of
+///	being built from scratch.
+///
+///	@details	When the dataset is stored in a file, or a database keeps a local snapshot, the index is saved next to it with the <em>.index</em>
+///	extension, so that the next program loads it instead of building it again. The file records the checksum of the matrix, so an index saved
+///	before the samples changed is built and saved again. The index is saved again when the algorithm is destroyed if samples were trained.
+///
+///	@details	SearchEngine::Shards() keeps the search exact but splits the rows of the matrix into shards, either one per dataset of a
+///	ShardedDataset or a number of shards of equal size. Every chunk of queries is then searched in each shard as a separate task, so even a single
+///	chunk keeps several threads busy, and the neighbours found in every shard are merged before voting. Since a NeighbourList orders ties by row,
+///	the result is exactly the one of a single scan. Samples added during training are appended to the last shard.
+///
+///	@details	When the geometry of the characters is known and the dataset has a GeometryModel, the exact search skips the samples of the classes
+///	that do not admit the geometry of each query, e.g. the letters with descenders for a character that sits on the baseline. Every character
+///	trained extends the geometry model of its class. The distances skipped are reported as avoided in the classification statistics.
+///
+///	@details	The distance between a query and a sample is given by the DistanceMetric of the constructor. SampleMatrix chooses the kernel of the
+///	metric once per search, so no metric is checked for every sample. Since the indexes bound the Euclidean distance, the Manhattan distance is
+///	only allowed with the exact search engines.
 /// 
 /// @author	Eliezer Talón (elitalon@gmail.com)
 /// @date	2009-04-29 
@@ -28,11 +69,17 @@ class KnnClassificationAlgorithm : public ClassificationAlgorithm
 		///
 		///	@param		kNeighbours	Number of neighbours to take when classifying.
 		/// @param		engine		A dataset engine information to load a dataset.
+		///	@param		threads		Number of threads to use when classifying.
+		///	@param		search		Engine used to search the nearest neighbours.
+		///	@param		metric		Metric used to compare the queries with the samples.
 		///
 		///	@pre		The dataset must not be empty or set to a null value.
+		///	@pre		The number of neighbours must be greater than zero.
+		///	@pre		The Manhattan distance is only used with SearchEngine::Exact() or SearchEngine::Shards().
 		///
 		///	@warning	A client program or function must be aware since this class only uses the dataset and does not manage it.
-		explicit KnnClassificationAlgorithm (const unsigned int& kNeighbours, DatasetEngine engine);
+		explicit KnnClassificationAlgorithm (const unsigned int& kNeighbours, DatasetEngine engine, const unsigned int& threads = 1, SearchEngine search = SearchEngine::Exact(),
+											 DistanceMetric metric = DistanceMetric::Euclidean());
 
 		///	@brief	Destructor
 		~KnnClassificationAlgorithm ();
@@ -44,6 +91,15 @@ class KnnClassificationAlgorithm : public ClassificationAlgorithm
 		/// @return An array of characters, one character per feature vector passes.
 		std::vector<std::string> classify (const std::vector<FeatureVector>& featureVectors) const;
 
+		/// @brief		Classify a set of feature vectors into their most probably classes, using the geometry of their characters instead of the one
+		///				set with geometries().
+		/// 
+		/// @param		featureVectors	An array of feature vectors.
+		///	@param		geometries		Geometry of every character, in the same order as the feature vectors, or an empty array if it is unknown.
+		/// 
+		/// @return An array of characters, one character per feature vector passes.
+		std::vector<std::string> classify (const std::vector<FeatureVector>& featureVectors, const std::vector<GlyphGeometry>& geometries) const;
+
 		/// @brief		Train the classifier, comparing each classification decision with a reference text.
 		/// 
 		/// @param		featureVectors	An array of feature vectors.
@@ -64,13 +120,134 @@ class KnnClassificationAlgorithm : public ClassificationAlgorithm
 		///
 		///	@return	The hit rate achieved after training (e.g. 0,9 for 90%).
 		double train (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode);
+
+		///	@brief		Remove a sample both from the dataset and from the matrix used for searching.
+		///
+		///	@param		n	Row of the sample, which is the same in the dataset and in the matrix.
+		///
+		///	@post		The row is marked as removed, and the dataset, the matrix and the index are purged if the rows removed are enough.
+		///
+		///	@exception	NessieException	The row is beyond the matrix, it was already removed or the dataset could not store the change.
+		void removeSample (const unsigned int& n);
+
+		///	@brief		Remove every sample of a class both from the dataset and from the matrix used for searching.
+		///
+		///	@param		character	Character of the class.
+		///
+		///	@post		The rows are marked as removed, and the dataset, the matrix and the index are purged if the rows removed are enough.
+		///
+		///	@return		Number of samples removed.
+		///
+		///	@exception	NessieException	The character has no class in the dataset or the dataset could not store the change.
+		unsigned int removeClass (const std::string& character);
+
+		///	@brief	Copy the number of threads used, the average number of them busy and the distance evaluations avoided by the last classification
+		///			into a statistics object.
+		///
+		///	@param	statistics	Statistics of the classification stage to update.
+		void updateStatistics (ClassifierStatistics& statistics) const;
+
+		///	@brief	Get the projection the feature vectors must be transformed with before they are classified.
+		///
+		///	@return	The projection of the dataset, which is empty if the dataset holds the image moments themselves.
+		const FeatureProjection* projection () const;
+
+		///	@brief	Get the time the last training spent exchanging samples with the storage of the dataset.
+		///
+		///	@return	Elapsed time in seconds.
+		double storageTime () const;
+
+		///	@brief	Set the geometry of the characters the next feature vectors classified and trained come from.
+		///
+		///	@param	geometries	Geometry of every character, in the same order as the feature vectors.
+		void geometries (const std::vector<GlyphGeometry>& geometries);
+
+		///	@brief	Get read-only access to the dataset.
+		///
+		///	@return	Dataset with previously trained characters.
+		const Dataset& dataset () const;
+
+		///	@brief	Get read-only access to the copy of the dataset samples that is searched.
+		///
+		///	@return	Matrix of samples, which grows as the algorithm is trained and whose rows removed are skipped until it is purged.
+		const SampleMatrix& matrix () const;
 		
 	private:
 
+		///	@brief	Number of queries taken by a thread each time it asks for work.
+		static const unsigned int chunkSize = 64;
+
+		///	@brief	Work shared by the threads during a classification.
+		struct ClassificationJob;
+
 		unsigned int	kNeighbours_;	///< Maximum number of negihbouring samples.
 
 		Dataset*		dataset_;		///< Dataset with previously trained characters.
+
+		SampleMatrix	matrix_;		///< Contiguous copy of the dataset samples used when searching the neighbours.
+
+		KnnIndex*		index_;			///< Index over the matrix used by an approximate search engine, or a null value for an exact search.
+
+		std::string		indexFile_;		///< File where the index is saved next to the dataset, or an empty string if it is not saved.
+
+		bool			indexSaved_;	///< Whether the file of the index holds the current content of the index.
+
+		std::vector<unsigned int>	shards_;	///< First row of every shard of the matrix, or empty if it is scanned as a whole.
+
+		std::vector<GlyphGeometry>	geometries_;	///< Geometry of the characters of the next feature vectors classified and trained.
+
+		unsigned int	threads_;		///< Maximum number of threads used when classifying.
+
+		mutable unsigned int	threadsUsed_;		///< Number of threads used by the last classification.
+
+		mutable double			concurrency_;		///< Average number of threads busy during the last classification.
+
+		mutable long unsigned int	avoidedDistances_;	///< Number of distances the index did not compute in the last classification.
+
+		mutable bool				gated_;				///< Whether the last classification skipped the classes that do not admit the geometry of the queries.
+
+		double			storageTime_;		///< Time spent by the last training exchanging samples with the storage of the dataset.
+
+		///	@brief	Take chunks of queries from a classification job until none is left, and classify them, or search them in a single shard
+		///			if the matrix is sharded.
+		///
+		///	@param	job			Work shared by the threads.
+		///	@param	busyTime	Elapsed time in seconds while the thread was working.
+		///	@param	evaluations	Number of distances computed by the index, or by the search gated by geometry, while searching the queries taken.
+		void classifyChunks (ClassificationJob& job, double& busyTime, long unsigned int& evaluations) const;
+
+		///	@brief	Add a sample both to the dataset and to the matrix used for searching.
+		///
+		///	@param	featureVector	Features of the sample.
+		///	@param	code			Class of the sample.
+		void addSample (const FeatureVector& featureVector, const unsigned int& code);
+
+		///	@brief	Drop the rows removed from the dataset and the matrix, number the rows of the index again and move the first row of every shard.
+		void purge ();
+
+		///	@brief	Split the rows of the matrix into shards.
+		///
+		///	@param	partitions	Number of shards of equal size, or zero for one shard per dataset of a ShardedDataset.
+		void buildShards (const unsigned int& partitions);
+
+		///	@brief	Get the most voted class among the neighbours found.
+		///
+		///	@param	neighbours	List of nearest neighbours.
+		///
+		///	@return	The label with the most appearances, or 256 if the list is empty. Ties are resolved in favour of the lowest label.
+		unsigned int vote (const NeighbourList& neighbours) const;
 };
 
+
+inline const Dataset& KnnClassificationAlgorithm::dataset () const
+{
+	return *dataset_;
+}
+
+inline const SampleMatrix& KnnClassificationAlgorithm::matrix () const
+{
+	return matrix_;
+}
+
 #endif
 
@@ -8,6 +8,8 @@ class FeatureVector;
 class Text;
 class DatasetEngine;
 #include "Classifier.hpp"
+#include "SearchEngine.hpp"
+#include "DistanceMetric.hpp"
 #include <string>
 #include <vector>
 
@@ -29,9 +31,13 @@ class KnnClassifier : public Classifier
 		///
 		///	@param		nNeighbours	Number of neighbours to search for every sample.
 		///	@param		engine		Dataset engine to use in classification and training methods.
+		///	@param		threads		Number of threads to use when classifying.
+		///	@param		search		Engine used to search the nearest neighbours.
+		///	@param		metric		Metric used to compare the feature vectors with the samples.
 		///
 		///	@warning	The dataset is only used by the class. A KnnClassifier object is not responsible of deallocating the dataset.
-		explicit KnnClassifier (const unsigned int& nNeighbours, DatasetEngine engine);
+		explicit KnnClassifier (const unsigned int& nNeighbours, DatasetEngine engine, const unsigned int& threads = 1, SearchEngine search = SearchEngine::Exact(),
+								DistanceMetric metric = DistanceMetric::Euclidean());
 
 		///	@brief	Destructor.
 		virtual ~KnnClassifier ();
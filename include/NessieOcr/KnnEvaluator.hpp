@@ -0,0 +1,173 @@
+/// @file
+/// @brief Declaration of KnnEvaluator class
+
+#if !defined(_KNN_EVALUATOR_H)
+#define _KNN_EVALUATOR_H
+
+class Dataset;
+class NeighbourList;
+#include "SampleMatrix.hpp"
+#include <vector>
+
+
+///	@brief		Measure of the accuracy of the KNN classification for every number of neighbours up to a maximum in a single search.
+///
+///	@details	Choosing the number of neighbours of KnnClassificationAlgorithm used to mean classifying the same samples once per candidate value.
+///	Since a NeighbourList orders its neighbours by distance and then by row, the <em>k</em> nearest neighbours of a query are exactly the first
+///	<em>k</em> of its <em>K</em> nearest ones for any <em>k</em> ≤ <em>K</em>. This class searches the <em>K</em> nearest neighbours of every query
+///	once and then votes with every prefix of the list, so a sweep over <em>k</em> costs about as much as a single classification with <em>K</em>.
+///	The labels found for every <em>k</em> are the ones KnnClassificationAlgorithm finds with an exact search.
+///
+///	@details	The queries are either the samples of another dataset, whose classes are taken as the right answers, or the samples of the dataset
+///	itself, each of them classified by the rest (leave-one-out). The search is split in chunks of queries taken by several threads, like
+///	KnnClassificationAlgorithm does, and every <em>k</em> is timed separately when voting, so that the latency of a classification with each
+///	<em>k</em> can be estimated as the search time per query plus its voting time per query.
+///
+///	@see		KnnClassificationAlgorithm, NeighbourList, DatasetCondenser
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class KnnEvaluator
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		dataset	Dataset with the reference samples.
+		///	@param		threads	Number of threads used when searching.
+		///
+		///	@exception	NessieException	The number of threads is zero.
+		explicit KnnEvaluator (const Dataset& dataset, const unsigned int& threads = 1);
+
+		///	@brief		Classify the samples of another dataset with every number of neighbours from 1 to <em>kMax</em>.
+		///
+		///	@param		queries	Dataset with the samples to classify, whose classes are the expected ones.
+		///	@param		kMax	Largest number of neighbours.
+		///
+		///	@post		The results of any previous evaluation are replaced.
+		///
+		///	@exception	NessieException	The number of neighbours is zero or the number of features of the datasets differ.
+		void evaluate (const Dataset& queries, const unsigned int& kMax);
+
+		///	@brief		Classify every sample of the reference dataset by the rest with every number of neighbours from 1 to <em>kMax</em>.
+		///
+		///	@param		kMax	Largest number of neighbours.
+		///
+		///	@post		The results of any previous evaluation are replaced.
+		///
+		///	@exception	NessieException	The number of neighbours is zero.
+		void leaveOneOut (const unsigned int& kMax);
+
+		///	@brief	Get the largest number of neighbours of the last evaluation.
+		///
+		///	@return	Largest number of neighbours, or zero if nothing has been evaluated.
+		const unsigned int& kMax () const;
+
+		///	@brief	Get the number of queries classified by the last evaluation.
+		///
+		///	@return	Number of queries.
+		const unsigned int& queries () const;
+
+		///	@brief		Get the number of queries classified into their expected class with a number of neighbours.
+		///
+		///	@param		k	Number of neighbours, between 1 and KnnEvaluator::kMax().
+		///
+		///	@return		Number of hits.
+		///
+		///	@exception	NessieException	The number of neighbours was not evaluated.
+		const unsigned int& hits (const unsigned int& k) const;
+
+		///	@brief		Get the accuracy achieved with a number of neighbours.
+		///
+		///	@param		k	Number of neighbours, between 1 and KnnEvaluator::kMax().
+		///
+		///	@return		The hit rate achieved (e.g. 90.0 for 90%).
+		///
+		///	@exception	NessieException	The number of neighbours was not evaluated.
+		double accuracy (const unsigned int& k) const;
+
+		///	@brief		Estimate the time needed to classify a query with a number of neighbours.
+		///
+		///	@param		k	Number of neighbours, between 1 and KnnEvaluator::kMax().
+		///
+		///	@return		Search time plus voting time per query, in seconds.
+		///
+		///	@exception	NessieException	The number of neighbours was not evaluated.
+		double latency (const unsigned int& k) const;
+
+		///	@brief	Get the time spent by the threads searching the neighbours in the last evaluation.
+		///
+		///	@return	Sum of the busy times of every thread, in seconds.
+		const double& searchTime () const;
+
+		///	@brief	Get the number of threads used by the last evaluation.
+		///
+		///	@return	Number of threads.
+		const unsigned int& threadsUsed () const;
+
+	private:
+
+		///	@brief	Number of queries taken by a thread each time it asks for work.
+		static const unsigned int chunkSize = 64;
+
+		///	@brief	Work shared by the threads during an evaluation.
+		struct EvaluationJob;
+
+		SampleMatrix				matrix_;		///< Reference samples.
+
+		unsigned int				threads_;		///< Maximum number of threads used when searching.
+
+		unsigned int				kMax_;			///< Largest number of neighbours of the last evaluation.
+
+		unsigned int				queries_;		///< Number of queries of the last evaluation.
+
+		std::vector<unsigned int>	hits_;			///< Number of hits with every number of neighbours.
+
+		std::vector<double>			voteTimes_;		///< Time spent voting with every number of neighbours, in seconds.
+
+		double						searchTime_;	///< Time spent searching, in seconds.
+
+		unsigned int				threadsUsed_;	///< Number of threads used by the last evaluation.
+
+		///	@brief	Search the neighbours of every query of a job and vote with every number of neighbours.
+		///
+		///	@param	job	Queries to evaluate.
+		void run (EvaluationJob& job);
+
+		///	@brief	Take chunks of queries from an evaluation job until none is left, and search their neighbours.
+		///
+		///	@param	job			Work shared by the threads.
+		///	@param	busyTime	Elapsed time in seconds while the thread was working.
+		void searchChunks (EvaluationJob& job, double& busyTime) const;
+
+		///	@brief	Get the most voted class among the nearest neighbours of a list.
+		///
+		///	@param	neighbours	List of nearest neighbours.
+		///	@param	k			Number of neighbours that vote, from the nearest one.
+		///
+		///	@return	The label with the most appearances. Ties are resolved in favour of the lowest label.
+		unsigned int vote (const NeighbourList& neighbours, const unsigned int& k) const;
+};
+
+
+inline const unsigned int& KnnEvaluator::kMax () const
+{
+	return kMax_;
+}
+
+inline const unsigned int& KnnEvaluator::queries () const
+{
+	return queries_;
+}
+
+inline const double& KnnEvaluator::searchTime () const
+{
+	return searchTime_;
+}
+
+inline const unsigned int& KnnEvaluator::threadsUsed () const
+{
+	return threadsUsed_;
+}
+
+#endif
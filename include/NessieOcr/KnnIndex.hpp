@@ -0,0 +1,192 @@
+/// @file
+/// @brief Declaration of KnnIndex class
+
+#if !defined(_KNN_INDEX_H)
+#define _KNN_INDEX_H
+
+class SampleMatrix;
+class NeighbourList;
+#include <string>
+#include <vector>
+#include <cstring>
+
+
+///	@brief		Search structure built over a SampleMatrix to find nearest neighbours faster than a linear scan.
+///
+///	@details	This abstract base class provides an interface for the indexes that KnnClassificationAlgorithm can use instead of scanning every
+///	sample. An index does not copy the samples: it is built over a SampleMatrix, kept up to date as rows are appended to it, and searched by
+///	passing the same matrix again. Neighbours are reported by their row in the matrix, as in SampleMatrix::search().
+///
+///	@details	The rows removed from the matrix are skipped by every search, and when the matrix is purged the index numbers its rows again with
+///	KnnIndex::remap(), which costs much less than building it again.
+///
+///	@details	Building an index may take longer than classifying a whole page, so it can be saved to a file and loaded by a later program. The
+///	file keeps, besides the content written by every kind of index, the checksum of the matrix the index was built over. An index is only loaded
+///	if the matrix has the same content, so a file written before the samples changed is detected and the index built again.
+///
+///	@see		SampleMatrix, NeighbourList, SearchEngine
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class KnnIndex
+{
+	public:
+
+		///	@brief	Constructor.
+		explicit KnnIndex ();
+
+		///	@brief	Destructor.
+		virtual ~KnnIndex ();
+
+		///	@brief		Build the index over every row of a matrix.
+		///
+		///	@param		matrix	Matrix of samples to index.
+		///
+		///	@post		Any previous content of the index is discarded.
+		///
+		///	@exception	NessieException	The parameters of the index are not valid for the matrix.
+		virtual void build (const SampleMatrix& matrix) = 0;
+
+		///	@brief	Add a row that has been appended to the matrix after the index was built.
+		///
+		///	@param	matrix	Matrix of samples the index was built over.
+		///	@param	n		Row to add.
+		virtual void append (const SampleMatrix& matrix, const unsigned int& n) = 0;
+
+		///	@brief	Take into account a row that has been marked as removed in the matrix.
+		///
+		///	@param	matrix	Matrix of samples the index was built over.
+		///	@param	n		Row removed.
+		///
+		///	@post	The default implementation does nothing, since the searches skip the rows removed by themselves.
+		virtual void remove (const SampleMatrix& matrix, const unsigned int& n);
+
+		///	@brief	Number the rows of the index again after the matrix has been purged.
+		///
+		///	@param	matrix	Matrix of samples the index was built over, already purged.
+		///	@param	rows	New number of every row before the purge, as given by SampleMatrix::purge().
+		virtual void remap (const SampleMatrix& matrix, const std::vector<unsigned int>& rows) = 0;
+
+		///	@brief	Search the nearest rows of a query.
+		///
+		///	@param	matrix		Matrix of samples the index was built over.
+		///	@param	query		Query features padded by SampleMatrix::load().
+		///	@param	neighbours	List that receives the nearest rows, using squared distances.
+		///
+		///	@return	Number of distances between the query and a sample, exact or approximate, that have been computed.
+		virtual unsigned int search (const SampleMatrix& matrix, const double* query, NeighbourList& neighbours) const = 0;
+
+		///	@brief		Write the index to a file, so that a later program can load it instead of building it again.
+		///
+		///	@param		filename	Name of the file, which is replaced atomically once completely written.
+		///	@param		matrix		Matrix of samples the index was built over.
+		///
+		///	@exception	NessieException	The file could not be written.
+		void save (const std::string& filename, const SampleMatrix& matrix) const;
+
+		///	@brief	Load the index from a file written by KnnIndex::save().
+		///
+		///	@param	filename	Name of the file.
+		///	@param	matrix		Matrix of samples to search with the index.
+		///
+		///	@return	True if the file was written by the same kind of index with the same parameters over a matrix with the same content, false
+		///			otherwise, in which case the index must be built again.
+		bool load (const std::string& filename, const SampleMatrix& matrix);
+
+	protected:
+
+		///	@brief	Get the identifier of the kind of index, which is written in its files.
+		///
+		///	@return	An identifier different for every subclass.
+		virtual unsigned int identifier () const = 0;
+
+		///	@brief	Append the parameters and the content of the index to a buffer.
+		///
+		///	@param	buffer	Buffer that receives the content.
+		virtual void write (std::string& buffer) const = 0;
+
+		///	@brief	Read the parameters and the content of the index appended by write().
+		///
+		///	@param	position	First byte of the content, which is advanced past it.
+		///	@param	end			End of the buffer.
+		///	@param	matrix		Matrix of samples the index was built over.
+		///
+		///	@return	True if the content is complete and was written with the same parameters as the ones of this index, false otherwise.
+		virtual bool read (const char*& position, const char* end, const SampleMatrix& matrix) = 0;
+
+		///	@brief	Append the bytes of a value to a buffer.
+		///
+		///	@param	buffer	Buffer to append to.
+		///	@param	value	Value to append.
+		template <class T>
+		static void writeValue (std::string& buffer, const T& value);
+
+		///	@brief	Append an array to a buffer, preceded by its number of elements.
+		///
+		///	@param	buffer	Buffer to append to.
+		///	@param	values	Array to append, whose elements are copied byte by byte.
+		template <class T>
+		static void writeArray (std::string& buffer, const std::vector<T>& values);
+
+		///	@brief	Read a value appended by writeValue().
+		///
+		///	@param	position	First byte of the value, which is advanced past it.
+		///	@param	end			End of the buffer.
+		///	@param	value		Variable that receives the value.
+		///
+		///	@return	False if the buffer ends before the value.
+		template <class T>
+		static bool readValue (const char*& position, const char* end, T& value);
+
+		///	@brief	Read an array appended by writeArray().
+		///
+		///	@param	position	First byte of the array, which is advanced past it.
+		///	@param	end			End of the buffer.
+		///	@param	values		Array that receives the elements.
+		///
+		///	@return	False if the buffer ends before the array.
+		template <class T>
+		static bool readArray (const char*& position, const char* end, std::vector<T>& values);
+};
+
+
+template <class T>
+inline void KnnIndex::writeValue (std::string& buffer, const T& value)
+{
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T>
+inline void KnnIndex::writeArray (std::string& buffer, const std::vector<T>& values)
+{
+	writeValue(buffer, static_cast<unsigned int>(values.size()));
+	if ( not values.empty() )
+		buffer.append(reinterpret_cast<const char*>(&values[0]), values.size() * sizeof(T));
+}
+
+template <class T>
+inline bool KnnIndex::readValue (const char*& position, const char* end, T& value)
+{
+	if ( static_cast<std::size_t>(end - position) < sizeof(value) )
+		return false;
+
+	std::memcpy(&value, position, sizeof(value));
+	position += sizeof(value);
+	return true;
+}
+
+template <class T>
+inline bool KnnIndex::readArray (const char*& position, const char* end, std::vector<T>& values)
+{
+	unsigned int size;
+	if ( not readValue(position, end, size) or static_cast<std::size_t>(end - position) / sizeof(T) < size )
+		return false;
+
+	values.resize(size);
+	if ( size > 0 )
+		std::memcpy(&values[0], position, size * sizeof(T));
+	position += size * sizeof(T);
+	return true;
+}
+
+#endif
@@ -6,8 +6,14 @@
 
 #include "Dataset.hpp"
 #include <string>
+#include <vector>
 #include <map>
 
+namespace mysqlpp
+{
+	class Connection;
+}
+
 
 ///	@brief		Dataset built by retrieving the data from a MySQL database.
 ///
@@ -44,6 +50,12 @@
 ///		ENGINE=InnoDB;
 ///	@endcode
 ///
+///	@details	A single connection is opened when the dataset is built and kept until it is destroyed. The samples added are buffered and
+///	only inserted when MySqlDataset::flush() is called, which the classification algorithms do at the end of every training, so adding a sample
+///	never fails because of the database and the rows of the dataset always match the ones of the classifier. A flush deletes every sample
+///	removed with a single statement and inserts the new samples with INSERT statements of up to MySqlDataset::batchSize() rows, all of them in
+///	the same transaction. The time spent in every flush is added to Dataset::storageTime().
+///
 ///	@see		Dataset
 ///
 ///	@author Eliezer Talón (elitalon@gmail.com)
@@ -57,31 +69,49 @@ class MySqlDataset : public Dataset
 		///	@param		database	Name of the database to connect.
 		///	@param		username	Username to use in the database connection.
 		///	@param		password	User password.
+		///	@param		batchSize	Number of rows of every INSERT statement.
 		///
-		///	@post		A connection with the MySQL database is stablished using the given parameters.
+		///	@post		A connection with the MySQL database is stablished using the given parameters, and kept until the dataset is destroyed.
 		///
 		///	@exception	NessieException
-		explicit MySqlDataset (const std::string& database, const std::string& username, const std::string& password);
+		explicit MySqlDataset (const std::string& database, const std::string& username, const std::string& password, const unsigned int& batchSize = 256);
 
 		///	@brief	Destructor.
+		///
+		///	@post	The changes not written yet are flushed, ignoring any error, and the connection is closed.
 		virtual ~MySqlDataset ();
 
 		///	@brief		Add a sample to the dataset.
 		///
 		///	@param		sample Sample to add.
 		///
-		///	@post		The sample is appended to the end of the dataset.
+		///	@post		The sample is appended to the end of the dataset, and it is inserted in the database on the next flush.
 		///
-		///	@exception	NessieException
+		///	@exception	NessieException	The number of features does not match with the dataset or the class is not in the database.
 		void addSample (const Sample& sample);
 
 		///	@brief		Remove a sample from the dataset.
 		///
 		///	@param		n	Row in the dataset where remove the sample.
 		///
-		///	@exception	NessieException
+		///	@post		The row is marked as removed, and the sample is deleted from the database on the next flush.
+		///
+		///	@exception	NessieException	The row is beyond the size of the dataset or it was already removed.
 		void removeSample (const unsigned int& n);
 
+		///	@brief	Drop the rows removed from the dataset, together with their id_sample.
+		void purge ();
+
+		///	@brief		Delete the samples removed and insert the samples added in a single transaction.
+		///
+		///	@exception	NessieException	The transaction failed, in which case the changes are kept to be written on the next flush.
+		void flush ();
+
+		///	@brief	Get the number of samples inserted at once.
+		///
+		///	@return	Number of rows of every INSERT statement.
+		const unsigned int& batchSize () const;
+
 	private:
 		
 		std::string								database_;			///< Name of the database to connect.
@@ -90,12 +120,30 @@ class MySqlDataset : public Dataset
 
 		std::string								password_;			///< User password.
 
-		std::vector<unsigned int>				sampleIds_;			///< Array of integers to store the id_sample field of samples table in the database.
+		mysqlpp::Connection*					connection_;		///< Connection to the database, open during the life of the dataset.
+
+		std::vector<unsigned int>				sampleIds_;			///< The id_sample of every sample inserted in the database, which is zero for a sample removed before it was inserted.
 		
 		std::map<unsigned int, unsigned int>	classIds_;			///< Map that associates a class ID with its code.
 		
 		std::string								featureColumns_;	///< Name of the columns that holds the features to include on a query.
+
+		unsigned int							batchSize_;			///< Number of samples inserted at once.
+
+		unsigned int							pending_;			///< Number of samples at the end of the dataset not inserted in the database yet.
+
+		std::vector<unsigned int>				removedIds_;		///< Array of id_sample fields of the samples removed but not deleted from the database yet.
+
+		// Do not implement these methods, as they are only declared here to prevent objects to be copied. 
+		MySqlDataset (const MySqlDataset&);
+		MySqlDataset& operator= (const MySqlDataset&);
 };
 
+
+inline const unsigned int& MySqlDataset::batchSize () const
+{
+	return batchSize_;
+}
+
 #endif
 
@@ -0,0 +1,154 @@
+/// @file
+/// @brief Declaration of NeighbourList class
+
+#if !defined(_NEIGHBOUR_LIST_H)
+#define _NEIGHBOUR_LIST_H
+
+#include <vector>
+#include <limits>
+
+
+///	@brief		Fixed-size list of the nearest neighbours found during a KNN search.
+///
+///	@details	This class keeps the best <em>k</em> candidates seen so far sorted by ascending distance in a preallocated array, so that
+///	the insertion of a new candidate never allocates memory. The distance of the worst candidate kept is always available through
+///	NeighbourList::bound() and can be used by a search kernel to abandon the computation of a distance as soon as it cannot improve the list.
+///	Candidates at the same distance are ordered by row, so the sample that appears first in the dataset wins ties whatever the order in which
+///	the candidates are offered.
+///	Neighbours are identified by their row in the SampleMatrix that was searched, from which their label can be retrieved.
+///
+///	@see		SampleMatrix, KnnClassificationAlgorithm
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class NeighbourList
+{
+	public:
+
+		///	@brief	Constructor.
+		///
+		///	@param	k	Maximum number of neighbours to keep.
+		explicit NeighbourList (const unsigned int& k);
+
+		///	@brief	Remove every neighbour from the list, keeping its capacity.
+		void clear ();
+
+		///	@brief	Get the maximum number of neighbours kept.
+		///
+		///	@return	Capacity of the list.
+		const unsigned int& capacity () const;
+
+		///	@brief	Get the number of neighbours currently kept.
+		///
+		///	@return	Number of neighbours.
+		const unsigned int& size () const;
+
+		///	@brief	Get the distance that a candidate must improve to enter the list.
+		///
+		///	@return	The distance of the worst neighbour if the list is full, or infinity otherwise.
+		const double& bound () const;
+
+		///	@brief	Get the distance of a neighbour.
+		///
+		///	@param	n	Position of the neighbour, being 0 the nearest one.
+		///
+		///	@return	Distance of the neighbour.
+		const double& distance (const unsigned int& n) const;
+
+		///	@brief	Get the row of a neighbour.
+		///
+		///	@param	n	Position of the neighbour, being 0 the nearest one.
+		///
+		///	@return	Row of the neighbour in the matrix that was searched.
+		const unsigned int& row (const unsigned int& n) const;
+
+		///	@brief	Offer a candidate to the list.
+		///
+		///	@param	distance	Distance from the query to the candidate.
+		///	@param	row			Row of the candidate in the matrix that is searched.
+		///
+		///	@post	If the list is not full, the candidate is inserted in order. Otherwise, if it is nearer than the worst neighbour kept, or as
+		///			near but in a lower row, it is inserted in order and the worst neighbour is dropped.
+		void insert (const double& distance, const unsigned int& row);
+
+		///	@brief	Offer every neighbour of another list, e.g. the one found in a different range of rows of the same matrix.
+		///
+		///	@param	neighbours	List whose neighbours are offered.
+		///
+		///	@post	The list holds the nearest neighbours of both lists, ordered as if they had been found by a single search.
+		void merge (const NeighbourList& neighbours);
+
+	private:
+
+		std::vector<double>			distances_;	///< Distances of the neighbours in ascending order.
+
+		std::vector<unsigned int>	rows_;		///< Rows of the neighbours, in the same order as the distances.
+
+		unsigned int				capacity_;	///< Maximum number of neighbours.
+
+		unsigned int				size_;		///< Number of neighbours kept.
+
+		double						bound_;		///< Distance of the worst neighbour when the list is full.
+};
+
+
+inline void NeighbourList::clear ()
+{
+	size_	= 0;
+	bound_	= std::numeric_limits<double>::infinity();
+}
+
+inline const unsigned int& NeighbourList::capacity () const
+{
+	return capacity_;
+}
+
+inline const unsigned int& NeighbourList::size () const
+{
+	return size_;
+}
+
+inline const double& NeighbourList::bound () const
+{
+	return bound_;
+}
+
+inline const double& NeighbourList::distance (const unsigned int& n) const
+{
+	return distances_[n];
+}
+
+inline const unsigned int& NeighbourList::row (const unsigned int& n) const
+{
+	return rows_[n];
+}
+
+inline void NeighbourList::insert (const double& distance, const unsigned int& row)
+{
+	// A list that is not full admits any candidate, even one at an infinite distance
+	if ( size_ == capacity_ and not (distance < bound_) and not (distance == bound_ and row < rows_[size_-1]) )
+		return;
+
+	unsigned int i = ( size_ < capacity_ ) ? size_++ : size_ - 1;
+
+	// Shift the worse neighbours one position and drop the last one when full
+	while ( i > 0 and (distance < distances_[i-1] or (distance == distances_[i-1] and row < rows_[i-1])) )
+	{
+		distances_[i]	= distances_[i-1];
+		rows_[i]		= rows_[i-1];
+		--i;
+	}
+	distances_[i]	= distance;
+	rows_[i]		= row;
+
+	if ( size_ == capacity_ )
+		bound_ = distances_[size_-1];
+}
+
+inline void NeighbourList::merge (const NeighbourList& neighbours)
+{
+	for ( unsigned int i = 0; i < neighbours.size_; ++i )
+		insert(neighbours.distances_[i], neighbours.rows_[i]);
+}
+
+#endif
@@ -141,9 +141,11 @@ class NessieOcr
 		
 		/// @brief	Execute the feature extraction stage.
 		///
+		///	@param	classifier	Classifier the feature vectors are going to be classified with, whose projection is applied to them.
+		///
 		///	@pre	doPreprocessing() must have been previously executed.
 		///	@post	An array of feature vectors becomes available through <em>featureVectors_</em> member.
-		void doFeatureExtraction ();
+		void doFeatureExtraction (const std::auto_ptr<Classifier>& classifier);
 
 		/// @brief	Execute the classification stage. 
 		///
@@ -7,6 +7,7 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include "GlyphGeometry.hpp"
 
 
 ///	@brief		Set of pixels that defines a pattern to be recognized as a character in classification stage.
@@ -75,6 +76,16 @@ class Pattern
 		///	@post	Every pixel is set to background, i.e. to zero.
 		void clean ();
 
+		///	@brief	Get the position and shape of the region the pattern was built from within its line of text.
+		///
+		///	@return	Geometry of the region, which is unknown if the pattern was not found within a line.
+		const GlyphGeometry& geometry () const;
+
+		///	@brief	Set the position and shape of the region the pattern was built from within its line of text.
+		///
+		///	@param	geometry	Geometry of the region.
+		void geometry (const GlyphGeometry& geometry);
+
 		/// @brief	Create a new image in the filesystem using Magick++ with the pattern drawn.
 		///
 		/// @param	outputFile		A string with the image name in the filesystem.
@@ -93,6 +104,8 @@ class Pattern
 		unsigned int				width_;		///< Width of the pattern.
 
 		unsigned int				size_;		///< Number of pixels in the pattern.
+
+		GlyphGeometry				geometry_;	///< Position and shape of the region the pattern was built from.
 };
 
 
@@ -125,5 +138,16 @@ inline void Pattern::clean ()
 {
 	pixels_.assign(size_, 0);
 }
+
+inline const GlyphGeometry& Pattern::geometry () const
+{
+	return geometry_;
+}
+
+inline void Pattern::geometry (const GlyphGeometry& geometry)
+{
+	geometry_ = geometry;
+}
+
 #endif
 
@@ -0,0 +1,89 @@
+/// @file
+/// @brief Declaration of PerceptronClassificationAlgorithm class
+
+#if !defined(_PERCEPTRON_CLASSIFICATION_ALGORITHM_H)
+#define _PERCEPTRON_CLASSIFICATION_ALGORITHM_H
+
+class DatasetEngine;
+class Dataset;
+class FeatureVector;
+class Text;
+#include "ClassificationAlgorithm.hpp"
+#include "PerceptronModel.hpp"
+#include <vector>
+#include <string>
+
+
+///	@brief		Classification algorithm based on a perceptron model trained offline.
+///
+///	@details	This class implements the ClassificationAlgorithm class with a PerceptronModel loaded from a file. Unlike a KNN classifier, the cost
+///	of classifying a feature vector does not grow with the number of samples gathered. The dataset is only used to translate the labels of the
+///	model into characters and to keep the samples learnt during training.
+///
+///	@details	Training does not change the model. The training samples are added to the dataset instead, so that a new model can be trained
+///	offline from it, e.g. with the --train-model option of knntest.
+///
+///	@see		PerceptronModel, PerceptronClassifier, KnnClassificationAlgorithm
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class PerceptronClassificationAlgorithm : public ClassificationAlgorithm
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		model	Name of the file with the model, written by PerceptronModel::save().
+		/// @param		engine	A dataset engine information to load a dataset.
+		///
+		///	@exception	NessieException	The model could not be loaded or its number of features does not match the one of the dataset.
+		explicit PerceptronClassificationAlgorithm (const std::string& model, DatasetEngine engine);
+
+		///	@brief	Destructor.
+		~PerceptronClassificationAlgorithm ();
+
+		/// @brief	Classify a set of feature vectors into their most probably classes.
+		///
+		/// @param	featureVectors	An array of feature vectors.
+		///
+		/// @return An array of characters, one character per feature vector passed.
+		std::vector<std::string> classify (const std::vector<FeatureVector>& featureVectors) const;
+
+		/// @brief	Compare each classification decision with a reference text and add the samples to the dataset.
+		///
+		/// @param	featureVectors	An array of feature vectors.
+		/// @param	characters		An array of std::string objects with characters that match the feature vectors.
+		/// @param	referenceText	A text to compare with the characters passed.
+		///
+		///	@return	The hit rate achieved (e.g. 0,9 for 90%).
+		double train (const std::vector<FeatureVector>& featureVectors, const std::vector<std::string>& characters, const Text& referenceText);
+
+		/// @brief	Compare the classification decision for a single pattern with an ASCII code and add the sample to the dataset.
+		///
+		///	@param	featureVector	A feature vector that matches a character previously classified.
+		/// @param	character		A std::string object with sample character.
+		/// @param	asciiCode		An ASCII code to compare with the classification result.
+		///
+		///	@return	The hit rate achieved (e.g. 0,9 for 90%).
+		double train (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode);
+
+		///	@brief	Get the projection the feature vectors must be transformed with before they are classified.
+		///
+		///	@return	The projection of the dataset, which is empty if the dataset holds the image moments themselves.
+		const FeatureProjection* projection () const;
+
+		///	@brief	Get the time the last training spent exchanging samples with the storage of the dataset.
+		///
+		///	@return	Elapsed time in seconds.
+		double storageTime () const;
+
+	private:
+
+		Dataset*		dataset_;	///< Dataset with previously trained characters.
+
+		PerceptronModel	model_;		///< Model used to classify.
+
+		double			storageTime_;	///< Time spent by the last training exchanging samples with the storage of the dataset.
+};
+
+#endif
@@ -0,0 +1,62 @@
+/// @file
+/// @brief Declaration of PerceptronClassifier class
+
+#if !defined(_PERCEPTRON_CLASSIFIER_H)
+#define _PERCEPTRON_CLASSIFIER_H
+
+class FeatureVector;
+class Text;
+class DatasetEngine;
+#include "Classifier.hpp"
+#include <string>
+#include <vector>
+
+
+///	@brief		Classifier of NessieOcr based on a perceptron model trained offline.
+/// 
+///	@details	This class implements the Classifier class using a PerceptronClassificationAlgorithm. It needs as input parameters a model file and
+///	a dataset, whose number of features must match the one of the model.
+/// 
+/// @see		Classifier, PerceptronClassificationAlgorithm, PerceptronModel
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class PerceptronClassifier : public Classifier
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		model	Name of the file with the model.
+		///	@param		engine	Dataset engine to use in classification and training methods.
+		explicit PerceptronClassifier (const std::string& model, DatasetEngine engine);
+
+		///	@brief	Destructor.
+		virtual ~PerceptronClassifier ();
+
+		///	@brief	Classify each feature vector passed into its most probably class (character).
+		///
+		/// @param	featureVectors	An array of feature vectors to classify.
+		///
+		///	@return	An array of std::string objects with the characters found, one character per vector in the array passed.
+		std::vector<std::string> performClassification (const std::vector<FeatureVector>& featureVectors);
+
+		/// @brief	Measure the hit rate of the classifier against a reference text, keeping the samples for a later offline training.
+		/// 
+		///	@param	featureVectors	An array of feature vectors that matches the array of characters previously classified.
+		/// @param	characters		An array of std::string objects with classified characters for training.
+		/// @param	referenceText	A text to compare with the classificatios results to control the training decision.
+		///
+		///	@pre	The size of all input parameters must be equal.
+		void performTraining (const std::vector<FeatureVector>& featureVectors, const std::vector<std::string>& characters, const Text& referenceText);
+		
+		/// @brief	Measure the hit rate of the classifier for a single pattern, keeping the sample for a later offline training.
+		///
+		///	@param	featureVector	A feature vector that matches a character previously classified.
+		/// @param	character		A std::string object with sample character.
+		/// @param	asciiCode		An ASCII code to compare with the classification result.
+		void performTraining (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode);
+};
+
+#endif
+
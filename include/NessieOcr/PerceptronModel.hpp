@@ -0,0 +1,157 @@
+/// @file
+/// @brief Declaration of PerceptronModel class
+
+#if !defined(_PERCEPTRON_MODEL_H)
+#define _PERCEPTRON_MODEL_H
+
+class Dataset;
+class FeatureVector;
+#include <vector>
+#include <string>
+
+
+///	@brief		Multilayer perceptron trained offline from a dataset and evaluated with integer arithmetic.
+///
+///	@details	The model is either a multinomial linear model, i.e. a single layer of class scores, or a perceptron with one hidden layer of
+///	rectified linear units. It is trained by stochastic gradient descent on the softmax cross-entropy of the samples of a dataset, whose features are
+///	standardised first. The cost of classifying a feature vector only depends on the number of features, hidden units and classes, not on the
+///	number of samples the model was trained with.
+///
+///	@details	Once trained, the weights of every layer are quantized to 8-bit integers with a scale per output unit, and the inputs of every layer
+///	are quantized to 16-bit integers. Every output is then a sum of integer products accumulated in 32 bits and rescaled once, and the class with
+///	the highest score is chosen. To rule out overflows, no layer may have more than PerceptronModel::maxInputs inputs.
+///
+///	@details	Only the quantized model is kept, so a model saved with PerceptronModel::save() and loaded with PerceptronModel::load() classifies
+///	exactly as the original one. The file is binary, in the byte order of the machine that wrote it, and takes about one byte per weight.
+///
+///	@see		PerceptronClassificationAlgorithm, Dataset
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class PerceptronModel
+{
+	public:
+
+		///	@brief	Maximum number of inputs of a layer, so that the integer sums cannot overflow.
+		static const unsigned int maxInputs = 512;
+
+		///	@brief	Constructor.
+		///
+		///	@post	The model is empty and must be trained or loaded before classifying.
+		explicit PerceptronModel ();
+
+		///	@brief		Train the model with the samples of a dataset, replacing any previous model.
+		///
+		///	@param		dataset			Dataset with the samples to learn.
+		///	@param		hidden			Number of hidden units, or zero for a linear model.
+		///	@param		epochs			Number of passes over the samples.
+		///	@param		learningRate	Initial step of the gradient descent, which decays linearly to a tenth of it.
+		///
+		///	@post		The samples are visited in a pseudo-random order with a fixed seed, so training twice gives the same model.
+		///
+		///	@exception	NessieException	The dataset is empty, or the number of features or hidden units exceeds PerceptronModel::maxInputs.
+		void train (const Dataset& dataset, const unsigned int& hidden, const unsigned int& epochs, const double& learningRate);
+
+		///	@brief		Classify a set of feature vectors.
+		///
+		///	@param		featureVectors	An array of feature vectors.
+		///
+		///	@return		The label of the class with the highest score for every feature vector.
+		///
+		///	@exception	NessieException	The model is empty or the size of a feature vector does not match the number of features of the model.
+		std::vector<unsigned int> classify (const std::vector<FeatureVector>& featureVectors) const;
+
+		///	@brief		Save the model to a file.
+		///
+		///	@param		filename	Name of the file, which is overwritten.
+		///
+		///	@exception	NessieException	The model is empty or the file could not be written.
+		void save (const std::string& filename) const;
+
+		///	@brief		Load a model from a file written by PerceptronModel::save().
+		///
+		///	@param		filename	Name of the file.
+		///
+		///	@exception	NessieException	The file could not be read or is not a valid model.
+		void load (const std::string& filename);
+
+		///	@brief	Get the number of features of the feature vectors the model classifies.
+		///
+		///	@return	Number of features, or zero if the model is empty.
+		const unsigned int& features () const;
+
+		///	@brief	Get the number of hidden units.
+		///
+		///	@return	Number of hidden units, or zero for a linear model.
+		const unsigned int& hidden () const;
+
+		///	@brief	Get the number of classes.
+		///
+		///	@return	Number of classes, or zero if the model is empty.
+		unsigned int classes () const;
+
+	private:
+
+		///	@brief	Quantized fully connected layer.
+		struct Layer
+		{
+			unsigned int			inputs;		///< Number of inputs.
+
+			unsigned int			outputs;	///< Number of outputs.
+
+			std::vector<signed char>	weights;	///< Quantized weights, one row of <em>inputs</em> values per output.
+
+			std::vector<float>		scales;		///< Value of a unit of the quantized weights of every output.
+
+			std::vector<float>		biases;		///< Bias of every output.
+		};
+
+		unsigned int				features_;	///< Number of features.
+
+		unsigned int				hidden_;	///< Number of hidden units.
+
+		std::vector<unsigned int>	labels_;	///< Label of every class, in the order of the outputs of the last layer.
+
+		std::vector<float>			means_;		///< Mean of every feature in the training samples.
+
+		std::vector<float>			scales_;	///< Inverse of the standard deviation of every feature in the training samples.
+
+		float						inputScale_;	///< Value of a unit of the quantized standardised features.
+
+		std::vector<Layer>			layers_;	///< Layers of the model, from the input to the class scores.
+
+		///	@brief	Quantize the weights of a layer trained with floating point arithmetic.
+		///
+		///	@param	weights	Weights of the layer, one row per output.
+		///	@param	biases	Bias of every output.
+		///	@param	inputs	Number of inputs.
+		///
+		///	@return	The quantized layer.
+		static Layer quantize (const std::vector<double>& weights, const std::vector<double>& biases, const unsigned int& inputs);
+
+		///	@brief	Compute the outputs of a layer from quantized inputs.
+		///
+		///	@param	layer		Layer to evaluate.
+		///	@param	input		Quantized inputs.
+		///	@param	inputScale	Value of a unit of the quantized inputs.
+		///	@param	output		Outputs of the layer.
+		static void evaluate (const Layer& layer, const std::vector<short>& input, const float& inputScale, std::vector<float>& output);
+};
+
+
+inline const unsigned int& PerceptronModel::features () const
+{
+	return features_;
+}
+
+inline const unsigned int& PerceptronModel::hidden () const
+{
+	return hidden_;
+}
+
+inline unsigned int PerceptronModel::classes () const
+{
+	return labels_.size();
+}
+
+#endif
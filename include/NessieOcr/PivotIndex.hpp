@@ -0,0 +1,108 @@
+/// @file
+/// @brief Declaration of PivotIndex class
+
+#if !defined(_PIVOT_INDEX_H)
+#define _PIVOT_INDEX_H
+
+class SampleMatrix;
+class NeighbourList;
+#include "KnnIndex.hpp"
+#include <string>
+#include <vector>
+
+
+///	@brief		Exact nearest neighbour index that prunes samples with the triangle inequality, following the LAESA algorithm.
+///
+///	@details	A small set of samples far apart from each other is chosen as pivots, and the Euclidean distance between every sample and every
+///	pivot is kept in a table. A query first computes its distance to the pivots. Then, for any sample <em>s</em>, the largest
+///	|d(q,p) - d(s,p)| over the pivots is a lower bound of d(q,s) that costs a few subtractions instead of a full distance. The samples are
+///	visited in order, and a sample is skipped without computing its distance as soon as one pivot proves it farther than the worst neighbour
+///	kept. Unlike a KD-tree, the pruning only relies on the metric and does not degrade with the number of features.
+///
+///	@details	The result is the same as the one of a linear scan. Samples added after the index is built get their row of the table computed
+///	against the existing pivots. When the matrix is purged, the rows purged leave the table and so do the pivots among them, and the pivots are
+///	only chosen again if none is left. The pivots and the distance table can be saved to a file with KnnIndex::save().
+///
+///	@see		KnnIndex, SampleMatrix, SearchEngine
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class PivotIndex : public KnnIndex
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		pivots	Number of pivot samples.
+		///
+		///	@exception	NessieException	The number of pivots is zero or greater than 256.
+		explicit PivotIndex (const unsigned int& pivots);
+
+		///	@brief	Destructor.
+		virtual ~PivotIndex ();
+
+		///	@brief	Choose the pivots among the rows of a matrix and compute the distance table.
+		///
+		///	@param	matrix	Matrix of samples to index.
+		void build (const SampleMatrix& matrix);
+
+		///	@brief	Compute the distances between a row that has been appended to the matrix and the pivots.
+		///
+		///	@param	matrix	Matrix of samples the index was built over.
+		///	@param	n		Row to add.
+		void append (const SampleMatrix& matrix, const unsigned int& n);
+
+		///	@brief	Drop the rows purged from the distance table, and the pivots among them.
+		///
+		///	@param	matrix	Matrix of samples the index was built over, already purged.
+		///	@param	rows	New number of every row before the purge.
+		void remap (const SampleMatrix& matrix, const std::vector<unsigned int>& rows);
+
+		///	@brief	Search the nearest rows of a query.
+		///
+		///	@param	matrix		Matrix of samples the index was built over.
+		///	@param	query		Query features padded by SampleMatrix::load().
+		///	@param	neighbours	List that receives the nearest rows, using squared distances.
+		///
+		///	@return	Number of distances computed, including the distances to the pivots.
+		unsigned int search (const SampleMatrix& matrix, const double* query, NeighbourList& neighbours) const;
+
+	protected:
+
+		///	@brief	Get the identifier of a pivot index, which is written in its files.
+		///
+		///	@return	The identifier.
+		unsigned int identifier () const;
+
+		///	@brief	Append the number of pivots, the pivots and the distance table to a buffer.
+		///
+		///	@param	buffer	Buffer that receives the content.
+		void write (std::string& buffer) const;
+
+		///	@brief	Read the number of pivots, the pivots and the distance table appended by write().
+		///
+		///	@param	position	First byte of the content, which is advanced past it.
+		///	@param	end			End of the buffer.
+		///	@param	matrix		Matrix of samples the index was built over.
+		///
+		///	@return	True if the content is complete and was written with the same number of pivots, false otherwise.
+		bool read (const char*& position, const char* end, const SampleMatrix& matrix);
+
+	private:
+
+		unsigned int				pivots_;		///< Number of pivots requested.
+
+		std::vector<unsigned int>	pivotRows_;		///< Rows of the matrix chosen as pivots.
+
+		std::vector<bool>			isPivot_;		///< Whether every row of the matrix is a pivot.
+
+		std::vector<double>			table_;			///< Distances between every row and every pivot, one row after another.
+
+		///	@brief	Compute the distances between a row and every pivot, and append them to the table.
+		///
+		///	@param	matrix	Matrix of samples.
+		///	@param	n		Row of the sample.
+		void addRow (const SampleMatrix& matrix, const unsigned int& n);
+};
+
+#endif
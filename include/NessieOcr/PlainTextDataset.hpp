@@ -6,15 +6,16 @@
 
 #include "Dataset.hpp"
 #include <string>
+#include <fstream>
 
 
 ///	@brief		Dataset built by retrieving the data from a plain text file in the filesystem.
 ///
-///	@details	The file must provide the information about samples according to the following format. The first line must be a single number
+///	@details	The file must provide the information about samples according to the following format. The first line must start with a number
 ///	that defines the number of features stored, i.e. the number of fields that every feature vector must have. Then, the following lines are
 ///	the samples themselves, with one sample per line. Every sample must have exactly a number of fields according to the definition in the first
 ///	line, and then and additional number that tells the class where the feature vector belongs to.
-/// The <em>feature</em> fields must have a floating point format: both the integer and decimal parts are required and separated by a point.
+/// The <em>feature</em> fields must have a floating point format, with an optional decimal part separated by a point and an optional exponent.
 ///	The <em>class</em> field must be an integer. An example of a valid data set could be this:
 ///
 /// @code
@@ -25,7 +26,24 @@
 /// 0.1 0.3 1.3 2.4 3
 ///	@endcode
 ///
-///	@see		Dataset
+///	@details	The file is read in blocks of one megabyte and every sample is parsed straight into the array of samples, with no stream or
+///	temporary feature vector per line. Numbers with up to 15 significant digits are converted by hand, which gives the same values as the
+///	standard library, and longer ones are left to std::strtod().
+///
+///	@details	The file is not written again when the dataset is destroyed. Instead, every sample added is appended to a journal, a file with the
+///	same name plus the <em>.journal</em> extension, and so is the row of every sample removed and every purge of the rows removed. Each change
+///	reaches the disk as soon as it is made and costs as much as the change itself, whatever the size of the dataset. The journal is replayed
+///	after the file is loaded, and the rows that are still removed at its end are purged in memory. An incomplete record left by an interrupted
+///	program, or a journal of a previous generation, is ignored. The purge is only written to the journal, and the bytes ignored are only dropped
+///	from it, before the next change, so loading a dataset never writes to the disk. PlainTextDataset::compact() folds the journal into the
+///	file, which is done on destruction too if the journal written has grown beyond half the size of the file. A compacted file has a second
+///	number in its first line, the generation of the file, which tells whether a journal was written before or after the last compaction.
+///
+///	@details	If a file with the same name plus the <em>.projection</em> extension exists, it is loaded as the FeatureProjection the samples were
+///	transformed with (see FeatureProjection::save()), and its number of outputs must match the number of features of the dataset. Likewise, a
+///	file with the <em>.geometry</em> extension holds the GeometryModel of the dataset, which is saved next to the dataset if it is not empty.
+///
+///	@see		Dataset, FeatureProjection, GeometryModel
 ///
 ///	@author Eliezer Talón (elitalon@gmail.com)
 ///	@date 2009-02-13
@@ -44,25 +62,85 @@ class PlainTextDataset : public Dataset
 		explicit PlainTextDataset (const std::string& filename);
 
 		///	@brief	Destructor.
+		///
+		///	@post	The geometry model is saved next to the file if it is not empty, and the dataset is compacted if it has written a journal larger
+		///			than half the size of the file.
 		virtual ~PlainTextDataset ();
 
 		///	@brief		Addsa sample to the dataset.
 		///
 		///	@param		sample Sample to add.
 		///
-		///	@post		The sample is appended to the end of the dataset.
+		///	@post		The sample is appended to the end of the dataset and to the journal.
 		///
-		///	@exception	NessieException
+		///	@exception	NessieException	The number of features does not match with the dataset or the journal could not be written.
 		void addSample (const Sample& sample);
 
-		///	@brief	Remove a sample from the dataset.
+		///	@brief		Remove a sample from the dataset.
+		///
+		///	@param		n	Row in the dataset where remove the sample.
 		///
-		///	@param	n	Row in the dataset where remove the sample.
+		///	@post		The row is marked as removed and appended to the journal.
+		///
+		///	@exception	NessieException	The row is beyond the size of the dataset, it was already removed or the journal could not be written.
 		void removeSample (const unsigned int& n);
 
+		///	@brief		Drop the rows removed from the dataset.
+		///
+		///	@post		The purge is appended to the journal, so that the rows of the records that follow it are replayed the same way.
+		///
+		///	@exception	NessieException	The journal could not be written.
+		void purge ();
+
+		///	@brief		Write every sample not removed to the file and remove the journal.
+		///
+		///	@post		The file is replaced atomically once completely written, with the next generation in its first line, and the dataset is purged.
+		///
+		///	@exception	NessieException	The file could not be written.
+		void compact ();
+
 	private:
 
-		std::string	filename_;	///< File path where the data set is stored in the filesystem.
+		std::string		filename_;		///< File path where the data set is stored in the filesystem.
+
+		unsigned int	generation_;	///< Number of times the file has been compacted, which the journal must match.
+
+		std::ofstream	journal_;		///< Journal of the changes made since the file was compacted, opened on the first change.
+
+		bool			purgeDeferred_;	///< Whether the rows left removed by the journal were purged on load without recording it in the journal yet.
+
+		std::size_t		fileSize_;		///< Size of the file in bytes.
+
+		std::size_t		journalSize_;	///< Size of the journal in bytes, leaving out the bytes ignored by the replay.
+
+		bool			journalRepair_;	///< Whether the journal file holds bytes ignored by the replay, which are dropped before the next record.
+
+		///	@brief		Append a record to the journal, opening it first if needed.
+		///
+		///	@param		record	Line of text to append.
+		///
+		///	@exception	NessieException	The journal could not be opened or written.
+		void appendRecord (const std::string& record);
+
+		///	@brief		Apply the changes recorded in the journal to the samples loaded from the file.
+		///
+		///	@post		An incomplete record at the end of the journal and a journal of a previous generation are ignored, and left in the file until
+		///				the next record is appended.
+		///
+		///	@exception	NessieException	The journal has an invalid record.
+		void replayJournal ();
+
+		///	@brief		Parse the number of features, if it has not been read yet, and the samples of some whole lines of the file.
+		///
+		///	@param		begin	First character of the lines.
+		///	@param		end		Character past the last line, which must be a null character.
+		///	@param		lineNo	Number of the line where <em>begin</em> is, which is updated to the line where <em>end</em> is.
+		///	@param		header	Whether the number of features must be read first, which is cleared once it is read.
+		///
+		///	@post		The samples parsed are appended to the dataset.
+		///
+		///	@exception	NessieException	The number of features or a sample has not a valid format.
+		void parseSamples (const char* begin, const char* end, unsigned int& lineNo, bool& header);
 };
 
 #endif
@@ -5,7 +5,9 @@
 #define _POSTGRE_SQL_DATASET_H
 
 #include "Dataset.hpp"
+#include <pqxx/connection>
 #include <string>
+#include <vector>
 #include <map>
 
 
@@ -41,6 +43,22 @@
 ///		);
 ///	@endcode
 ///
+///	@details	The feature columns may also be <em>double precision</em> numbers, as in the alternative definition of
+///	<em>tools/initdbPostgreSQL.sql</em>. Either way, the samples are loaded with a <em>COPY</em> of the table that is read line by line and
+///	decoded straight into the dataset, instead of holding the whole result of a query in memory as text.
+///
+///	@details	Optionally, the samples are kept in a local snapshot file between runs, together with a watermark of the table: the number of
+///	rows and the greatest id_sample. A new dataset then only asks the database for the watermark. If the table has only grown, just the rows
+///	added after the snapshot are fetched, with a <em>COPY</em> of the query that selects them, and otherwise the whole table is loaded again.
+///	The snapshot is written after it is refreshed and when the dataset is destroyed after having changed the table. Rows updated in place are
+///	not detected, as the library never updates a sample.
+///
+///	@details	A single connection is opened when the dataset is built and kept until it is destroyed. The samples added are not inserted one
+///	by one, but buffered until PostgreSqlDataset::flush() is called, which the classification algorithms do at the end of every training. Then
+///	every sample removed is deleted with a single statement and the new samples are sent with a single <em>COPY</em>, all of them in the same
+///	transaction. Features are written with 17 significant digits, so a <em>numeric</em> column keeps every bit of the doubles. The time spent in every
+///	flush is added to Dataset::storageTime().
+///
 ///	@see		Dataset
 ///
 ///	@author Eliezer Talón (elitalon@gmail.com)
@@ -54,44 +72,88 @@ class PostgreSqlDataset : public Dataset
 		///	@param		database	Name of the database to connect.
 		///	@param		username	Username to use in the database connection.
 		///	@param		password	User password.
+		///	@param		snapshot	File where a local copy of the samples is kept between runs, or an empty string to load them all every time.
 		///
-		///	@post		A connection with the PostgreSQL database is stablished using the given parameters.
+		///	@post		A connection with the PostgreSQL database is stablished using the given parameters, and kept until the dataset is destroyed.
 		///
 		///	@exception	NessieException
-		explicit PostgreSqlDataset (const std::string& database, const std::string& username, const std::string& password);
+		explicit PostgreSqlDataset (const std::string& database, const std::string& username, const std::string& password, const std::string& snapshot = "");
 
 		///	@brief	Destructor.
+		///
+		///	@post	The changes not written yet are flushed, ignoring any error, the snapshot is written if the table changed, and the connection is
+		///			closed.
 		virtual ~PostgreSqlDataset ();
 
 		///	@brief		Add a sample to the dataset.
 		///
 		///	@param		sample Sample to add.
 		///
-		///	@post		The sample is appended to the end of the dataset.
+		///	@post		The sample is appended to the end of the dataset, and it is inserted in the database on the next flush.
 		///
-		///	@exception	NessieException
+		///	@exception	NessieException	The number of features does not match with the dataset or the class is not in the database.
 		void addSample (const Sample& sample);
 
 		///	@brief		Remove a sample from the dataset.
 		///
 		///	@param		n	Row in the dataset where remove the sample.
 		///
-		///	@exception	NessieException
+		///	@post		The row is marked as removed, and the sample is deleted from the database on the next flush.
+		///
+		///	@exception	NessieException	The row is beyond the size of the dataset or it was already removed.
 		void removeSample (const unsigned int& n);
 
+		///	@brief	Drop the rows removed from the dataset, together with their id_sample.
+		void purge ();
+
+		///	@brief		Delete the samples removed and insert the samples added in a single transaction.
+		///
+		///	@exception	NessieException	The transaction failed, in which case the changes are kept to be written on the next flush.
+		void flush ();
+
 	private:
-		
+
 		std::string								database_;			///< Name of the database to connect.
 
 		std::string								username_;			///< User name to use in the database connection.
 
 		std::string								password_;			///< User password.
 
-		std::vector<unsigned int>				sampleIds_;			///< Array of integers to store the id_sample field of samples table in the database.
+		pqxx::connection*						connection_;		///< Connection to the database, open during the life of the dataset.
+
+		std::vector<unsigned int>				sampleIds_;			///< The id_sample of every sample inserted in the database, which is zero for a sample removed before it was inserted.
 		
 		std::map<unsigned int, unsigned int>	classIds_;			///< Map that associates a class ID with its code.
 		
-		std::string								featureColumns_;	///< Name of the columns that holds the features to include on a query.
+		std::vector<std::string>				columns_;			///< Name of the columns of the samples table, from id_sample to the features and id_class.
+
+		unsigned int							pending_;			///< Number of samples at the end of the dataset not inserted in the database yet.
+
+		std::vector<unsigned int>				removedIds_;		///< Array of id_sample fields of the samples removed but not deleted from the database yet.
+
+		std::string								snapshot_;			///< File where a local copy of the samples is kept, or an empty string.
+
+		unsigned int							rows_;				///< Number of rows of the samples table the dataset is in sync with.
+
+		unsigned int							lastId_;			///< Greatest id_sample of the samples table the dataset is in sync with.
+
+		bool									snapshotOutdated_;	///< Whether the snapshot is older than the dataset.
+
+		///	@brief	Load the samples and the watermark of the table from the snapshot file.
+		///
+		///	@return	True if the file exists, is valid and has the same feature columns as the table, false otherwise.
+		bool readSnapshot ();
+
+		///	@brief		Write the samples and the watermark of the table to the snapshot file.
+		///
+		///	@post		The file is replaced atomically once completely written.
+		///
+		///	@exception	NessieException	The file could not be written.
+		void writeSnapshot ();
+
+		// Do not implement these methods, as they are only declared here to prevent objects to be copied. 
+		PostgreSqlDataset (const PostgreSqlDataset&);
+		PostgreSqlDataset& operator= (const PostgreSqlDataset&);
 };
 
 #endif
@@ -7,6 +7,7 @@
 #include <Magick++.h>
 #include "Region.hpp"
 #include "PreprocessorStatistics.hpp"
+#include "GlyphGeometry.hpp"
 #include <string>
 #include <deque>
 #include <vector>
@@ -105,6 +106,9 @@ class Preprocessor
 
 		/// @brief	Build an array of normalized patterns using the regions of ink pixels extracted from the press clip.
 		///
+		///	@details	Every pattern keeps the position and shape of its region within its line of text (see GlyphGeometry), since they are
+		///	lost when the region is normalized.
+		///
 		///	@pre	There must be a list of regions available by calling isolateRegions().
 		void buildPatterns ();
 
@@ -231,6 +235,19 @@ class Preprocessor
 		/// @return An array of numbers, each one represents the position where a blank space must be inserted when building the text in further post-processing.
 		std::vector<unsigned int> findSpacesBetweenWords ();
 
+		///	@brief	Measure the position and shape of every region of a line relative to the lowercase letters of the line.
+		///
+		///	@details	The top of the lowercase letters and the baseline are estimated as the median of the top and bottom rows of the regions,
+		///	since most characters in a line of text are lowercase letters without ascenders or descenders. Lines with less than three regions
+		///	do not allow such an estimate, so their regions get an unknown geometry.
+		///
+		///	@param	line	List of iterators to the regions of the line.
+		///
+		///	@return	An array with the geometry of every region, in the same order as the list.
+		///
+		///	@pre	The coordinates of the regions must not have been normalized yet.
+		std::vector<GlyphGeometry> measureGeometry (const std::list<RegionIterator>& line) const;
+
 		// Do not implement these methods, as they are only declared here to prevent objects to be copied. 
 		Preprocessor (const Preprocessor&);
 		Preprocessor& operator= (const Preprocessor&);
@@ -0,0 +1,423 @@
+/// @file
+/// @brief Declaration of SampleMatrix class
+
+#if !defined(_SAMPLE_MATRIX_H)
+#define _SAMPLE_MATRIX_H
+
+class Dataset;
+class FeatureVector;
+class NeighbourList;
+#include "DistanceMetric.hpp"
+#include <vector>
+#include <cstddef>
+
+
+///	@brief		Contiguous copy of the samples of a dataset arranged for fast nearest neighbour scans.
+///
+///	@details	Every sample of a Dataset keeps its features in a separate heap block, which makes a linear scan jump all over memory. This class
+///	copies the features into a single row-major array of doubles, one row per sample, and the labels into a parallel array. Each row is padded
+///	with zeros up to a multiple of SampleMatrix::lanes so that the distance kernel always works on whole blocks that the compiler can map onto
+///	vector registers. Queries must be padded the same way through SampleMatrix::load(), so that the padding adds nothing to the distances.
+///
+///	@details	Distances are computed as squared Euclidean distances, which preserve the ordering of the Euclidean distance without taking a
+///	square root. The kernel also abandons a distance as soon as its partial sum exceeds the bound given by the caller.
+///
+///	@details	The matrix is built for a DistanceMetric. The weighted Euclidean and Mahalanobis distances are handled by transforming the samples
+///	when they are copied and the queries when they are loaded, after which they are plain squared Euclidean distances. The Manhattan distance
+///	is computed by the scans instead, and the batched search falls back to one scan per query for it. The scans are templates on the term added
+///	for every feature and on the stride of the rows, and they are chosen once per search. The stride of the image moments computed by
+///	FeatureExtractor, SampleMatrix::fixedStride, has its own instances whose loops the compiler unrolls completely.
+///
+///	@details	When many queries are available at once, as happens when a whole press clip is classified, the batched search expands the squared
+///	distance as |q|² + |s|² - 2·q·s and computes the dot products for blocks of queries against blocks of samples. Every block of samples is
+///	loaded once and reused by all the queries, so the matrix is streamed from memory once per batch instead of once per query. The norms of
+///	the rows are kept up to date by the matrix itself.
+///
+///	@details	A row can be removed in constant time, which marks it so that every scan skips it while the other rows keep their numbers. The
+///	rows removed of a Dataset are marked the same way when it is copied. SampleMatrix::purge() drops them all in a single pass and tells where
+///	every remaining row has moved, so that an index built over the matrix can number its rows again instead of being built from scratch.
+///
+///	@see		Dataset, NeighbourList, KnnClassificationAlgorithm
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class SampleMatrix
+{
+	public:
+
+		///	@brief	Number of features processed together by the distance kernel.
+		static const unsigned int lanes = 4;
+
+		///	@brief	Number of queries processed together by the batched search.
+		static const unsigned int queryBlock = 8;
+
+		///	@brief	Number of rows processed together by the batched search.
+		static const unsigned int rowBlock = 256;
+
+		///	@brief	Stride of the rows for which the scans are compiled with a constant number of features.
+		static const unsigned int fixedStride = 16;
+
+		///	@brief	New number given by SampleMatrix::purge() to the rows dropped.
+		static const unsigned int purgedRow = 0xFFFFFFFF;
+
+		///	@brief	Constructor.
+		///
+		///	@post	An empty matrix with no rows and no features is initialized.
+		explicit SampleMatrix ();
+
+		///	@brief	Constructor.
+		///
+		///	@param	dataset	Dataset whose samples are copied into the matrix.
+		///	@param	metric	Metric used to compare the queries with the samples.
+		explicit SampleMatrix (const Dataset& dataset, const DistanceMetric& metric = DistanceMetric::Euclidean());
+
+		///	@brief		Replace the content of the matrix with the samples of a dataset.
+		///
+		///	@param		dataset	Dataset whose samples are copied into the matrix.
+		///	@param		metric	Metric used to compare the queries with the samples.
+		///
+		///	@exception	NessieException	The metric cannot be applied to the samples of the dataset.
+		void assign (const Dataset& dataset, const DistanceMetric& metric = DistanceMetric::Euclidean());
+
+		///	@brief	Replace the content of the matrix with some rows of another matrix, which also gives its metric.
+		///
+		///	@param	matrix	Matrix whose rows are copied.
+		///	@param	rows	Rows to copy, in the order they must appear.
+		void assign (const SampleMatrix& matrix, const std::vector<unsigned int>& rows);
+
+		///	@brief		Append a new row to the matrix.
+		///
+		///	@param		features	Features of the new sample.
+		///	@param		label		Label of the new sample.
+		///
+		///	@exception	NessieException	The number of features does not match with the matrix.
+		void append (const FeatureVector& features, const unsigned int& label);
+
+		///	@brief		Append a copy of a row of another matrix.
+		///
+		///	@param		matrix	Matrix whose row is copied.
+		///	@param		n		Row to copy.
+		///
+		///	@exception	NessieException	The number of features does not match with the matrix.
+		void append (const SampleMatrix& matrix, const unsigned int& n);
+
+		///	@brief		Mark a row as removed, so that no search finds it.
+		///
+		///	@param		n	Row of the sample.
+		///
+		///	@exception	NessieException	The row is beyond the matrix or it was already removed.
+		void remove (const unsigned int& n);
+
+		///	@brief	Drop the rows removed, keeping the order of the rest.
+		///
+		///	@param	rows	Array that receives the new number of every row, or SampleMatrix::purgedRow for the rows dropped.
+		void purge (std::vector<unsigned int>& rows);
+
+		///	@brief	Get the number of rows (samples) in the matrix.
+		///
+		///	@return	Number of rows, including the ones removed until the matrix is purged.
+		const unsigned int& rows () const;
+
+		///	@brief	Check whether a row has been removed.
+		///
+		///	@param	n	Row of the sample.
+		///
+		///	@return	True if the row has been removed and the matrix has not been purged since.
+		bool removed (const unsigned int& n) const;
+
+		///	@brief	Get the number of rows removed since the matrix was last purged.
+		///
+		///	@return	Number of rows removed.
+		const unsigned int& removedRows () const;
+
+		///	@brief	Get the number of features per row.
+		///
+		///	@return	Number of features, without padding.
+		const unsigned int& features () const;
+
+		///	@brief	Get the distance between the beginning of two consecutive rows.
+		///
+		///	@return	Number of features per row, including padding.
+		const unsigned int& stride () const;
+
+		///	@brief	Get read-only access to a row of the matrix.
+		///
+		///	@param	n	Row of the sample.
+		///
+		///	@return	Pointer to the first feature of the row.
+		const double* row (const unsigned int& n) const;
+
+		///	@brief	Get the metric used to compare the queries with the samples.
+		///
+		///	@return	A DistanceMetric object.
+		const DistanceMetric& metric () const;
+
+		///	@brief	Get the label of a row.
+		///
+		///	@param	n	Row of the sample.
+		///
+		///	@return	Label of the sample.
+		const unsigned int& label (const unsigned int& n) const;
+
+		///	@brief	Compute a checksum of the content of the matrix, which changes with any feature, label or number of rows.
+		///
+		///	@return	The FNV-1a checksum of the rows and the labels.
+		unsigned int checksum () const;
+
+		///	@brief		Copy a feature vector into a buffer padded like the rows of the matrix.
+		///
+		///	@param		featureVector	Feature vector to copy.
+		///	@param		buffer			Buffer that receives the features. It is resized to SampleMatrix::stride() elements.
+		///
+		///	@exception	NessieException	The number of features does not match with the matrix.
+		void load (const FeatureVector& featureVector, std::vector<double>& buffer) const;
+
+		///	@brief	Compute the squared Euclidean distance between a query and a row, abandoning it when it exceeds a bound.
+		///
+		///	@details	The distance is measured between the transformed features, so it is the squared distance of the metric of the matrix unless
+		///	it is the Manhattan distance.
+		///
+		///	@param	query	Query features padded by SampleMatrix::load().
+		///	@param	n		Row of the sample.
+		///	@param	bound	Distance beyond which the result is of no interest.
+		///
+		///	@return	The squared distance, or a partial sum greater than <em>bound</em> if the computation was abandoned.
+		double squaredDistance (const double* query, const unsigned int& n, const double& bound) const;
+
+		///	@brief	Scan every row to find the nearest neighbours of a query.
+		///
+		///	@param	query		Query features padded by SampleMatrix::load().
+		///	@param	neighbours	List that receives the nearest rows, using the distances of the metric.
+		///
+		///	@post	<em>neighbours</em> holds the nearest rows. Its previous content is taken as part of the candidates.
+		void search (const double* query, NeighbourList& neighbours) const;
+
+		///	@brief	Scan a range of rows to find the nearest neighbours of a query among them.
+		///
+		///	@param	query		Query features padded by SampleMatrix::load().
+		///	@param	neighbours	List that receives the nearest rows, using the distances of the metric.
+		///	@param	first		First row scanned.
+		///	@param	last		Row past the last one scanned.
+		///
+		///	@post	<em>neighbours</em> holds the nearest rows of the range. Its previous content is taken as part of the candidates.
+		void search (const double* query, NeighbourList& neighbours, const unsigned int& first, const unsigned int& last) const;
+
+		///	@brief	Scan a range of rows to find the nearest neighbours of a query among the rows of some labels.
+		///
+		///	@param	query		Query features padded by SampleMatrix::load().
+		///	@param	neighbours	List that receives the nearest rows, using the distances of the metric.
+		///	@param	first		First row scanned.
+		///	@param	last		Row past the last one scanned.
+		///	@param	allowed		Flag for every label telling whether its rows are candidates. Labels beyond its size are not candidates.
+		///
+		///	@return	Number of distances computed.
+		///
+		///	@post	<em>neighbours</em> holds the nearest rows of the range among the candidates. Its previous content is taken as part of the
+		///			candidates.
+		unsigned int search (const double* query, NeighbourList& neighbours, const unsigned int& first, const unsigned int& last,
+							 const std::vector<unsigned char>& allowed) const;
+
+		///	@brief	Scan every row to find the nearest neighbours of a batch of queries.
+		///
+		///	@param	queries		Query features, one row per query padded by SampleMatrix::load().
+		///	@param	nQueries	Number of queries in <em>queries</em>.
+		///	@param	neighbours	Array of <em>nQueries</em> lists that receive the nearest rows of each query, using the distances of the metric.
+		///
+		///	@pre	<em>queries</em> must hold a whole number of SampleMatrix::queryBlock rows, being zero the rows beyond <em>nQueries</em>.
+		///	@post	Every list holds the nearest rows of its query. Its previous content is taken as part of the candidates.
+		void search (const double* queries, const unsigned int& nQueries, NeighbourList* neighbours) const;
+
+		///	@brief	Scan a range of rows to find the nearest neighbours of a batch of queries among them.
+		///
+		///	@param	queries		Query features, one row per query padded by SampleMatrix::load().
+		///	@param	nQueries	Number of queries in <em>queries</em>.
+		///	@param	neighbours	Array of <em>nQueries</em> lists that receive the nearest rows of each query, using the distances of the metric.
+		///	@param	first		First row scanned.
+		///	@param	last		Row past the last one scanned.
+		///
+		///	@pre	<em>queries</em> must hold a whole number of SampleMatrix::queryBlock rows, being zero the rows beyond <em>nQueries</em>.
+		///	@post	Every list holds the nearest rows of the range for its query. Its previous content is taken as part of the candidates.
+		void search (const double* queries, const unsigned int& nQueries, NeighbourList* neighbours, const unsigned int& first, const unsigned int& last) const;
+
+	private:
+
+		std::vector<double>			data_;		///< Features of every sample, one padded row after another.
+
+		std::vector<unsigned int>	labels_;	///< Label of every sample.
+
+		std::vector<double>			norms_;		///< Squared norm of every row.
+
+		std::vector<unsigned char>	removed_;	///< Flag for every row telling whether it has been removed.
+
+		unsigned int				removedRows_;	///< Number of rows removed since the matrix was last purged.
+
+		unsigned int				rows_;		///< Number of samples.
+
+		unsigned int				features_;	///< Number of features per sample.
+
+		unsigned int				stride_;	///< Number of features per row including padding.
+
+		DistanceMetric				metric_;	///< Metric used to compare the queries with the samples.
+
+		std::vector<double>			transformation_;	///< Lower triangular matrix applied to the features of samples and queries, if any.
+
+		///	@brief	Term of the squared Euclidean distance.
+		struct SquaredDifference
+		{
+			static double term (const double& a, const double& b) { double difference = a - b; return difference * difference; };
+		};
+
+		///	@brief	Term of the Manhattan distance.
+		struct AbsoluteDifference
+		{
+			static double term (const double& a, const double& b) { return ( a > b ) ? a - b : b - a; };
+		};
+
+		///	@brief	Compute the distance between a query and a row, abandoning it when it exceeds a bound.
+		///
+		///	@tparam	Term	Policy whose static function term() gives the contribution of a pair of features.
+		///	@tparam	Stride	Stride of the rows, or zero to use the stride of the matrix.
+		///
+		///	@param	query	Query features padded by SampleMatrix::load().
+		///	@param	sample	Row of the sample.
+		///	@param	bound	Distance beyond which the result is of no interest.
+		///
+		///	@return	The distance, or a partial sum greater than <em>bound</em> if the computation was abandoned.
+		template <class Term, unsigned int Stride>
+		double distance (const double* query, const double* sample, const double& bound) const;
+
+		///	@brief	Scan a range of rows to find the nearest neighbours of a query, choosing the instance of SampleMatrix::scan() for the metric and
+		///			the stride.
+		///
+		///	@param	query		Query features padded by SampleMatrix::load().
+		///	@param	neighbours	List that receives the nearest rows.
+		///	@param	first		First row scanned.
+		///	@param	last		Row past the last one scanned.
+		///	@param	allowed		Flag for every label telling whether its rows are candidates, or a null pointer if every row is a candidate.
+		///
+		///	@return	Number of distances computed.
+		unsigned int dispatch (const double* query, NeighbourList& neighbours, const unsigned int& first, const unsigned int& last,
+							   const std::vector<unsigned char>* allowed) const;
+
+		///	@brief	Scan a range of rows to find the nearest neighbours of a query.
+		///
+		///	@tparam	Term	Policy whose static function term() gives the contribution of a pair of features.
+		///	@tparam	Stride	Stride of the rows, or zero to use the stride of the matrix.
+		///
+		///	@param	query		Query features padded by SampleMatrix::load().
+		///	@param	neighbours	List that receives the nearest rows.
+		///	@param	first		First row scanned.
+		///	@param	last		Row past the last one scanned.
+		///	@param	allowed		Flag for every label telling whether its rows are candidates, or a null pointer if every row is a candidate.
+		///
+		///	@return	Number of distances computed.
+		template <class Term, unsigned int Stride>
+		unsigned int scan (const double* query, NeighbourList& neighbours, const unsigned int& first, const unsigned int& last,
+						   const std::vector<unsigned char>* allowed) const;
+
+		///	@brief	Scan a range of rows to find the nearest neighbours of a batch of queries by their dot products.
+		///
+		///	@tparam	Stride	Stride of the rows, or zero to use the stride of the matrix.
+		///
+		///	@param	queries		Query features, one row per query padded by SampleMatrix::load().
+		///	@param	nQueries	Number of queries in <em>queries</em>.
+		///	@param	neighbours	Array of <em>nQueries</em> lists that receive the nearest rows of each query.
+		///	@param	first		First row scanned.
+		///	@param	last		Row past the last one scanned.
+		template <unsigned int Stride>
+		void scanBatch (const double* queries, const unsigned int& nQueries, NeighbourList* neighbours, const unsigned int& first, const unsigned int& last) const;
+
+		///	@brief	Copy some features into a padded row, applying the transformation of the metric.
+		///
+		///	@param	featureVector	Features to copy.
+		///	@param	row				Row of SampleMatrix::stride() elements whose padding is already zero.
+		void transform (const FeatureVector& featureVector, double* row) const;
+
+		///	@brief	Compute the dot product of two padded rows.
+		///
+		///	@param	a	First row.
+		///	@param	b	Second row.
+		///
+		///	@return	The dot product.
+		double dotProduct (const double* a, const double* b) const;
+};
+
+
+inline const unsigned int& SampleMatrix::rows () const
+{
+	return rows_;
+}
+
+inline bool SampleMatrix::removed (const unsigned int& n) const
+{
+	return removedRows_ > 0 and removed_[n];
+}
+
+inline const unsigned int& SampleMatrix::removedRows () const
+{
+	return removedRows_;
+}
+
+inline const unsigned int& SampleMatrix::features () const
+{
+	return features_;
+}
+
+inline const unsigned int& SampleMatrix::stride () const
+{
+	return stride_;
+}
+
+inline const double* SampleMatrix::row (const unsigned int& n) const
+{
+	return &data_[static_cast<std::size_t>(n) * stride_];
+}
+
+inline const DistanceMetric& SampleMatrix::metric () const
+{
+	return metric_;
+}
+
+inline const unsigned int& SampleMatrix::label (const unsigned int& n) const
+{
+	return labels_[n];
+}
+
+inline double SampleMatrix::dotProduct (const double* a, const double* b) const
+{
+	double partial[lanes] = {0.0, 0.0, 0.0, 0.0};
+
+	for ( unsigned int i = 0; i < stride_; i += lanes )
+	{
+		for ( unsigned int j = 0; j < lanes; ++j )
+			partial[j] += a[i+j] * b[i+j];
+	}
+
+	return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
+template <class Term, unsigned int Stride>
+inline double SampleMatrix::distance (const double* query, const double* sample, const double& bound) const
+{
+	const unsigned int stride = ( Stride > 0 ) ? Stride : stride_;
+	double partial[lanes] = {0.0, 0.0, 0.0, 0.0};
+
+	for ( unsigned int i = 0; i < stride; i += lanes )
+	{
+		for ( unsigned int j = 0; j < lanes; ++j )
+			partial[j] += Term::term(query[i+j], sample[i+j]);
+
+		double sum = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+		if ( sum > bound )
+			return sum;
+	}
+
+	return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
+inline double SampleMatrix::squaredDistance (const double* query, const unsigned int& n, const double& bound) const
+{
+	return distance<SquaredDifference, 0>(query, row(n), bound);
+}
+
+#endif
@@ -0,0 +1,228 @@
+/// @file
+/// @brief Declaration of SearchEngine class
+
+#if !defined(_SEARCH_ENGINE_H)
+#define _SEARCH_ENGINE_H
+
+
+///	@brief		Identifier of the engine that is used to search the nearest neighbours.
+///
+///	@details	This class provides a simple ID mechanism to identify the type of the search engine whose initialization information is stored in
+///	a SearchEngine object.
+///
+///	@see		SearchEngine
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class SearchEngineType
+{
+	public:
+
+		///	@brief Get the unique identifier of the exact search engine, which scans the whole dataset.
+		static SearchEngineType Exact () { return SearchEngineType(1); };
+
+		///	@brief Get the unique identifier of the approximate search engine based on an inverted file with product quantization.
+		static SearchEngineType InvertedFile () { return SearchEngineType(2); };
+
+		///	@brief Get the unique identifier of the exact search engine that prunes samples with a table of distances to pivot samples.
+		static SearchEngineType Pivots () { return SearchEngineType(3); };
+
+		///	@brief Get the unique identifier of the search engine that only scans the classes whose mean is nearest to the query.
+		static SearchEngineType ClassFilter () { return SearchEngineType(4); };
+
+		///	@brief Get the unique identifier of the exact search engine that scans several shards of the dataset concurrently.
+		static SearchEngineType Shards () { return SearchEngineType(5); };
+
+		///	@brief Equality operator overloading.
+		///
+		///	@param	engine	SearchEngineType object to compare with.
+		///
+		///	@return True if both identifiers are equal, false otherwise.
+		bool operator== (const SearchEngineType& engine) const;
+
+	private:
+
+		///	@brief Constructor.
+		///
+		///	@param	type	Identifier of the engine type.
+		explicit SearchEngineType (const unsigned int& type);
+
+
+		unsigned int id_;	///< Engine type identifier.
+};
+
+
+
+///	@brief		Engine that is used to search the nearest neighbours of a feature vector in the KNN classifier.
+///
+///	@details	This class provides a simple way to specify how KnnClassifier must search the dataset, in the same fashion DatasetEngine specifies
+///	how the dataset is stored. The exact engine compares every query with every sample. The other engines build an index over the dataset that
+///	trades some accuracy, or some memory, for a faster search, except the shards engine, which scans the whole dataset split into parts that
+///	different threads search at the same time. The parameters of each engine are only meaningful for that engine.
+///
+///	@see		KnnClassifier, KnnClassificationAlgorithm, KnnIndex
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class SearchEngine
+{
+	public:
+
+		///	@brief	Get the exact search engine.
+		///
+		///	@return A SearchEngine object properly initialized.
+		static SearchEngine Exact () { return SearchEngine(SearchEngineType::Exact(), 0, 0, 0, 0, 0, 0, true); };
+
+		///	@brief	Get an approximate search engine based on an inverted file with product-quantized residuals.
+		///
+		///	@param	lists			Number of coarse clusters (inverted lists) the samples are divided into.
+		///	@param	subquantizers	Number of bytes used to encode every sample. It must divide the padded number of features.
+		///	@param	probes			Number of inverted lists visited for every query.
+		///
+		///	@return A SearchEngine object properly initialized.
+		static SearchEngine InvertedFile (const unsigned int& lists, const unsigned int& subquantizers, const unsigned int& probes)
+		{
+			return SearchEngine(SearchEngineType::InvertedFile(), lists, subquantizers, probes, 0, 0, 0, false);
+		};
+
+		///	@brief	Get an exact search engine that skips the samples that the triangle inequality proves too far, as in the LAESA algorithm.
+		///
+		///	@param	pivots	Number of pivot samples whose distances to every sample are kept in a table.
+		///
+		///	@return A SearchEngine object properly initialized.
+		static SearchEngine Pivots (const unsigned int& pivots) { return SearchEngine(SearchEngineType::Pivots(), 0, 0, 0, pivots, 0, 0, true); };
+
+		///	@brief	Get a search engine that ranks the classes by the distance from the query to their mean and scans the nearest ones first.
+		///
+		///	@param	classes	Number of classes scanned for every query, in order of nearest mean.
+		///	@param	exact	Whether the rest of classes are also scanned when the bounding box of their samples does not prove them too far.
+		///
+		///	@return A SearchEngine object properly initialized.
+		static SearchEngine ClassFilter (const unsigned int& classes, const bool& exact)
+		{
+			return SearchEngine(SearchEngineType::ClassFilter(), 0, 0, 0, 0, classes, 0, exact);
+		};
+
+		///	@brief	Get an exact search engine that splits the samples into shards, scans them concurrently and merges the nearest neighbours found
+		///			in each one.
+		///
+		///	@param	partitions	Number of shards of equal size, or zero for one shard per dataset of a sharded dataset.
+		///
+		///	@return A SearchEngine object properly initialized.
+		static SearchEngine Shards (const unsigned int& partitions) { return SearchEngine(SearchEngineType::Shards(), 0, 0, 0, 0, 0, partitions, true); };
+
+		///	@brief	Get the unique identifier of the search engine.
+		///
+		///	@return	A SearchEngineType object with its associated ID.
+		SearchEngineType type () const;
+
+		///	@brief	Get the number of inverted lists of an inverted file engine.
+		///
+		///	@return	Number of lists.
+		const unsigned int& lists () const;
+
+		///	@brief	Get the number of bytes per sample of an inverted file engine.
+		///
+		///	@return	Number of subquantizers.
+		const unsigned int& subquantizers () const;
+
+		///	@brief	Get the number of lists visited per query by an inverted file engine.
+		///
+		///	@return	Number of probes.
+		const unsigned int& probes () const;
+
+		///	@brief	Get the number of pivot samples of a pivots engine.
+		///
+		///	@return	Number of pivots.
+		const unsigned int& pivots () const;
+
+		///	@brief	Get the number of classes scanned first by a class filter engine.
+		///
+		///	@return	Number of classes.
+		const unsigned int& classes () const;
+
+		///	@brief	Get the number of shards of equal size of a shards engine.
+		///
+		///	@return	Number of shards, or zero for one shard per dataset.
+		const unsigned int& partitions () const;
+
+		///	@brief	Get whether the engine returns the same neighbours as a linear scan.
+		///
+		///	@return	True if the search is exact, false otherwise.
+		const bool& exact () const;
+
+	private:
+
+		///	@brief	Constructor.
+		///
+		///	@param	type			Identifier of the engine.
+		///	@param	lists			Number of inverted lists.
+		///	@param	subquantizers	Number of bytes per sample.
+		///	@param	probes			Number of lists visited per query.
+		///	@param	pivots			Number of pivot samples.
+		///	@param	classes			Number of classes scanned first.
+		///	@param	partitions		Number of shards.
+		///	@param	exact			Whether the search is exact.
+		explicit SearchEngine (SearchEngineType type, const unsigned int& lists, const unsigned int& subquantizers, const unsigned int& probes,
+							   const unsigned int& pivots, const unsigned int& classes, const unsigned int& partitions, const bool& exact);
+
+
+		SearchEngineType	type_;			///< Engine type.
+
+		unsigned int		lists_;			///< Number of inverted lists when the engine is InvertedFile.
+
+		unsigned int		subquantizers_;	///< Number of bytes per sample when the engine is InvertedFile.
+
+		unsigned int		probes_;		///< Number of lists visited per query when the engine is InvertedFile.
+
+		unsigned int		pivots_;		///< Number of pivot samples when the engine is Pivots.
+
+		unsigned int		classes_;		///< Number of classes scanned first when the engine is ClassFilter.
+
+		unsigned int		partitions_;	///< Number of shards when the engine is Shards.
+
+		bool				exact_;			///< Whether the search is exact.
+};
+
+
+inline SearchEngineType SearchEngine::type () const
+{
+	return type_;
+}
+
+inline const unsigned int& SearchEngine::lists () const
+{
+	return lists_;
+}
+
+inline const unsigned int& SearchEngine::subquantizers () const
+{
+	return subquantizers_;
+}
+
+inline const unsigned int& SearchEngine::probes () const
+{
+	return probes_;
+}
+
+inline const unsigned int& SearchEngine::pivots () const
+{
+	return pivots_;
+}
+
+inline const unsigned int& SearchEngine::classes () const
+{
+	return classes_;
+}
+
+inline const unsigned int& SearchEngine::partitions () const
+{
+	return partitions_;
+}
+
+inline const bool& SearchEngine::exact () const
+{
+	return exact_;
+}
+
+#endif
@@ -0,0 +1,147 @@
+/// @file
+/// @brief Declaration of ShardedDataset class
+
+#if !defined(_SHARDED_DATASET_H)
+#define _SHARDED_DATASET_H
+
+#include "Dataset.hpp"
+#include <vector>
+
+
+///	@brief		Dataset made of several datasets, or shards, that are seen as a single one.
+///
+///	@details	A large collection of samples is easier to maintain when it is split into smaller datasets, e.g. one per font or per newspaper.
+///	This class concatenates the samples of every shard in the order they are passed, so the row of a sample is its row in its shard plus the
+///	number of samples of the shards before it. The first row of every shard is available through ShardedDataset::offset(), which allows a
+///	classifier to scan each shard on a different thread and merge the results.
+///
+///	@details	Every shard must have the same number of features, and the map of classes and the projection are taken from the first one, while
+///	the geometry models of every shard are merged. New samples and their geometry are added to the last shard, so that they keep being the last
+///	rows of the dataset.
+///
+///	@see		Dataset, PlainTextDataset, SearchEngine
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class ShardedDataset : public Dataset
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		shards	Datasets that make up the new one, which takes their ownership.
+		///
+		///	@exception	NessieException	There are no shards, or two of them have a different number of features. The shards are deleted.
+		explicit ShardedDataset (const std::vector<Dataset*>& shards);
+
+		///	@brief	Destructor.
+		///
+		///	@post	Every shard is deleted, which saves it if its engine does so.
+		virtual ~ShardedDataset ();
+
+		///	@brief	Allow read-only access to a sample in the dataset.
+		///
+		/// @param	n	Row in the dataset where the required sample is.
+		///
+		/// @return	Sample at given position.
+		const Sample& at (const unsigned int& n) const;
+
+		/// @brief	Get the code associated to the character passed.
+		/// 
+		/// @param	character	A valid character.
+		/// 
+		/// @return The code associated to the character or 256 if there is no association.
+		unsigned int code (const std::string& character) const;
+
+		/// @brief	Get the character associated to the code passed.
+		/// 
+		/// @param	code	A valid code.
+		/// 
+		/// @return The character associated to the code or an empty string if there is no association.
+		std::string character (const unsigned int& code) const;
+
+		///	@brief		Add a sample to the last shard.
+		///
+		///	@param		sample Sample to add.
+		///
+		///	@post		The sample is appended to the end of the dataset.
+		///
+		///	@exception	NessieException	The number of features per sample in the dataset does not match with the sample passed.
+		void addSample (const Sample& sample);
+
+		///	@brief		Remove a sample from the shard where it is stored.
+		///
+		///	@param		n	Row in the dataset where remove the sample.
+		///
+		///	@post		The row is marked as removed both in the dataset and in the shard.
+		///
+		///	@exception	NessieException	The row is out of range or it was already removed.
+		void removeSample (const unsigned int& n);
+
+		///	@brief	Drop the rows removed from every shard.
+		void purge ();
+
+		///	@brief	Extend the range of the geometry of a class both in the dataset and in the last shard.
+		///
+		///	@param	code		Class of the character.
+		///	@param	geometry	Geometry of the character, which is ignored if it is unknown.
+		void learnGeometry (const unsigned int& code, const GlyphGeometry& geometry);
+
+		///	@brief		Write the changes buffered by every shard.
+		///
+		///	@exception	NessieException	The changes of some shard could not be written.
+		void flush ();
+
+		///	@brief	Get the number of shards.
+		///
+		///	@return	Number of shards.
+		unsigned int shards () const;
+
+		///	@brief	Get read-only access to a shard.
+		///
+		///	@param	i	Position of the shard.
+		///
+		///	@return	The shard.
+		const Dataset& shard (const unsigned int& i) const;
+
+		///	@brief	Get the row of the dataset where a shard begins.
+		///
+		///	@param	i	Position of the shard.
+		///
+		///	@return	Number of samples of the shards before it.
+		const long unsigned int& offset (const unsigned int& i) const;
+
+	private:
+
+		std::vector<Dataset*>			shards_;	///< Shards of the dataset.
+
+		std::vector<long unsigned int>	offsets_;	///< Row where every shard begins, plus the total number of samples at the end.
+
+		///	@brief	Find the shard where a row is stored.
+		///
+		///	@param	n	Row in the dataset.
+		///
+		///	@return	Position of the shard.
+		unsigned int locate (const unsigned int& n) const;
+
+		///	@brief	Update the rows where the shards begin and the size of the dataset.
+		void updateOffsets ();
+};
+
+
+inline unsigned int ShardedDataset::shards () const
+{
+	return shards_.size();
+}
+
+inline const Dataset& ShardedDataset::shard (const unsigned int& i) const
+{
+	return *shards_.at(i);
+}
+
+inline const long unsigned int& ShardedDataset::offset (const unsigned int& i) const
+{
+	return offsets_.at(i);
+}
+
+#endif
@@ -0,0 +1,113 @@
+///	@file
+///	@brief	Declaration of SqliteDataset class
+
+#if !defined(_SQLITE_DATASET_H)
+#define _SQLITE_DATASET_H
+
+#include "Dataset.hpp"
+#include <string>
+#include <vector>
+#include <map>
+
+struct sqlite3;
+
+
+///	@brief		Dataset built by retrieving the data from a SQLite database, which needs no server.
+///
+///	@details	The database must contain the same two tables as a PostgreSqlDataset, <em>samples</em> and <em>classes</em>, and is created with
+///	<em>tools/initdbSQLite.sql</em>. The table <em>classes</em> has the columns id_class, label and asciiCode. The table <em>samples</em> has an
+///	integer <em>id_sample</em> that acts as the primary key, a foreign key <em>id_class</em> that points to the 'classes' table and, instead of a
+///	column per feature, a single <em>features</em> column with every feature of the sample packed as an array of double precision numbers:
+///
+///	@code
+///		CREATE TABLE samples (
+///			id_sample	INTEGER	PRIMARY KEY,
+///			features	BLOB	NOT NULL,
+///			id_class	INTEGER	REFERENCES classes
+///		);
+///	@endcode
+///
+///	@details	The number of features is kept in the <em>user_version</em> field of the database, and every array must have that many of them.
+///	The arrays are copied straight into the dataset when it is loaded, with no parsing at all, and keep every bit of the features. They are in the
+///	byte order of the machine that wrote them, so the database file cannot be moved to a machine with a different one.
+///
+///	@details	A single connection is opened when the dataset is built and kept until it is destroyed, in write-ahead logging mode so that other
+///	programs can read the samples while they are written. The samples added are buffered until SqliteDataset::flush() is called, which the
+///	classification algorithms do at the end of every training. Then every sample removed is deleted and every new sample is inserted with the
+///	same prepared statements, all of them in a single transaction. The time spent in every flush is added to Dataset::storageTime().
+///
+///	@see		Dataset, PostgreSqlDataset
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+class SqliteDataset : public Dataset
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		filename	Path in the filesystem to the database file, which must have been created with <em>tools/initdbSQLite.sql</em>.
+		///
+		///	@post		The database is opened and kept open until the dataset is destroyed.
+		///
+		///	@exception	NessieException	The database cannot be opened or its tables are not valid.
+		explicit SqliteDataset (const std::string& filename);
+
+		///	@brief	Destructor.
+		///
+		///	@post	The changes not written yet are flushed, ignoring any error, and the database is closed.
+		virtual ~SqliteDataset ();
+
+		///	@brief		Add a sample to the dataset.
+		///
+		///	@param		sample Sample to add.
+		///
+		///	@post		The sample is appended to the end of the dataset, and inserted in the database on the next flush.
+		///
+		///	@exception	NessieException	The number of features does not match with the dataset or the class is not in the database.
+		void addSample (const Sample& sample);
+
+		///	@brief		Remove a sample from the dataset.
+		///
+		///	@param		n	Row in the dataset where remove the sample.
+		///
+		///	@post		The row is marked as removed, and the sample is deleted from the database on the next flush.
+		///
+		///	@exception	NessieException	The row is beyond the size of the dataset or it was already removed.
+		void removeSample (const unsigned int& n);
+
+		///	@brief	Drop the rows removed from the dataset, together with their id_sample.
+		void purge ();
+
+		///	@brief		Delete the samples removed and insert the samples added in a single transaction.
+		///
+		///	@exception	NessieException	The transaction failed, in which case the changes are kept to be written on the next flush.
+		void flush ();
+
+		///	@brief	Check whether a file begins like a SQLite database.
+		///
+		///	@param	filename	Path in the filesystem to the file.
+		///
+		///	@return	True if the file can be read and starts with the header of a SQLite database, false otherwise.
+		static bool recognizes (const std::string& filename);
+
+	private:
+
+		std::string								filename_;		///< Path in the filesystem to the database file.
+
+		sqlite3*								connection_;	///< Connection to the database, open during the life of the dataset.
+
+		std::vector<unsigned int>				sampleIds_;		///< The id_sample of every sample inserted in the database, which is zero for a sample removed before it was inserted.
+
+		std::map<unsigned int, unsigned int>	classIds_;		///< Map that associates a class ID with its code.
+
+		unsigned int							pending_;		///< Number of samples at the end of the dataset not inserted in the database yet.
+
+		std::vector<unsigned int>				removedIds_;	///< Array of id_sample fields of the samples removed but not deleted from the database yet.
+
+		// Do not implement these methods, as they are only declared here to prevent objects to be copied.
+		SqliteDataset (const SqliteDataset&);
+		SqliteDataset& operator= (const SqliteDataset&);
+};
+
+#endif
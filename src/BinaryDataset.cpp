@@ -0,0 +1,283 @@
+/// @file
+/// @brief Definition of BinaryDataset class
+
+#include "BinaryDataset.hpp"
+#include "NessieException.hpp"
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+
+///	@brief	Identifier written at the beginning of a binary dataset file.
+static const char datasetMagic[8] = {'N', 'e', 's', 's', 'i', 'e', 'D', 'S'};
+
+///	@brief	Version of the binary dataset file format.
+static const unsigned int datasetVersion = 1;
+
+///	@brief	Value written in a binary dataset file to detect a different byte order.
+static const unsigned int datasetByteOrder = 0x01020304;
+
+
+///	@brief	Positions of the fields of the header of a binary dataset file.
+enum DatasetHeaderField
+{
+	versionField		= 8,
+	byteOrderField		= 12,
+	featuresField		= 16,
+	samplesField		= 20,
+	classesField		= 24,
+	tableBytesField		= 28,
+	matrixOffsetField	= 32,
+	checksumField		= 36
+};
+
+
+///	@brief	Read an unsigned integer from any position of a buffer.
+///
+///	@param	bytes	First byte of the integer.
+///
+///	@return	The integer.
+static unsigned int readField (const char* bytes)
+{
+	unsigned int value;
+	std::memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+
+///	@brief	Write an unsigned integer at any position of a buffer.
+///
+///	@param	bytes	First byte of the integer.
+///	@param	value	Integer to write.
+static void writeField (char* bytes, const unsigned int& value)
+{
+	std::memcpy(bytes, &value, sizeof(value));
+}
+
+
+BinaryDataset::BinaryDataset (const std::string& filename)
+:	Dataset(),
+	filename_(filename),
+	modified_(false)
+{
+	struct stat fileInfo;
+	if ( stat(filename.data(), &fileInfo) != 0 or not S_ISREG(fileInfo.st_mode) )
+		throw NessieException ("BinaryDataset::BinaryDataset() : File " + filename + " does not exist or it is not a regular file.");
+
+	std::size_t length = fileInfo.st_size;
+	if ( length < headerSize )
+		throw NessieException ("BinaryDataset::BinaryDataset() : File " + filename + " is not a valid binary dataset.");
+
+	// The whole file is read at once into a buffer whose start suits any type, so the matrix aligned inside it can be read in place
+	std::vector<char> file(length);
+	{
+		std::ifstream input(filename.data(), std::ios::binary);
+		if ( not input.is_open() or not input.read(&file[0], length) )
+			throw NessieException ("BinaryDataset::BinaryDataset() : File " + filename + " could not be read.");
+	}
+
+	read(&file[0], length);
+
+	// Load the projection the samples were transformed with and the range of the geometry of every class, if any
+	std::string projectionFile(filename_ + ".projection");
+	if ( stat(projectionFile.data(), &fileInfo) == 0 )
+	{
+		projection_.load(projectionFile);
+
+		if ( projection_.outputs() != features_ )
+			throw NessieException ("BinaryDataset::BinaryDataset() : The number of outputs of the projection " + projectionFile + " is different from the number of features.");
+	}
+
+	std::string geometryFile(filename_ + ".geometry");
+	if ( stat(geometryFile.data(), &fileInfo) == 0 )
+		geometry_.load(geometryFile);
+}
+
+
+BinaryDataset::~BinaryDataset ()
+{
+	try
+	{
+		if ( modified_ )
+			save(*this, filename_);
+		else if ( not geometry_.empty() )
+			geometry_.save(filename_ + ".geometry");
+	}
+	catch (...) {}
+}
+
+
+void BinaryDataset::read (const char* file, const std::size_t& length)
+{
+	if ( std::memcmp(file, datasetMagic, sizeof(datasetMagic)) != 0 or readField(file + versionField) != datasetVersion )
+		throw NessieException ("BinaryDataset::read() : File " + filename_ + " is not a valid binary dataset.");
+
+	if ( readField(file + byteOrderField) != datasetByteOrder )
+		throw NessieException ("BinaryDataset::read() : File " + filename_ + " was written on a machine with a different byte order.");
+
+	unsigned int features		= readField(file + featuresField);
+	unsigned int samples		= readField(file + samplesField);
+	unsigned int classes		= readField(file + classesField);
+	unsigned int tableBytes		= readField(file + tableBytesField);
+	unsigned int matrixOffset	= readField(file + matrixOffsetField);
+
+	std::size_t expectedLength = matrixOffset + static_cast<std::size_t>(samples) * (features + 1) * sizeof(float);
+	if ( features == 0 or matrixOffset % alignment != 0 or matrixOffset < headerSize + tableBytes or expectedLength != length )
+		throw NessieException ("BinaryDataset::read() : File " + filename_ + " is not a valid binary dataset.");
+
+	if ( checksum(file + headerSize, length - headerSize) != readField(file + checksumField) )
+		throw NessieException ("BinaryDataset::read() : The checksum of file " + filename_ + " does not match its content.");
+
+	// Table of classes
+	const char* entry		= file + headerSize;
+	const char* tableEnd	= entry + tableBytes;
+	for ( unsigned int i = 0; i < classes; ++i )
+	{
+		if ( tableEnd - entry < 8 or static_cast<unsigned int>(tableEnd - entry - 8) < readField(entry + 4) )
+			throw NessieException ("BinaryDataset::read() : The table of classes of file " + filename_ + " is truncated.");
+
+		unsigned int code	= readField(entry);
+		unsigned int size	= readField(entry + 4);
+		classes_.insert(std::make_pair(std::string(entry + 8, size), code));
+
+		entry += 8 + size;
+	}
+
+	// The matrix is aligned inside the buffer, so it can be read in place
+	const float* matrix			= reinterpret_cast<const float*>(file + matrixOffset);
+	const unsigned int* labels	= reinterpret_cast<const unsigned int*>(matrix + static_cast<std::size_t>(samples) * features);
+
+	features_ = features;
+	samples_.reserve(samples);
+	for ( unsigned int i = 0; i < samples; ++i )
+	{
+		const float* row = matrix + static_cast<std::size_t>(i) * features;
+
+		FeatureVector featureVector(features);
+		for ( unsigned int j = 0; j < features; ++j )
+			featureVector[j] = row[j];
+
+		samples_.push_back( Sample(featureVector, labels[i]) );
+	}
+	size_ = samples_.size();
+}
+
+
+void BinaryDataset::save (const Dataset& dataset, const std::string& filename)
+{
+	unsigned int features	= dataset.features();
+	unsigned int samples	= dataset.size() - dataset.removedSamples();
+
+	unsigned int tableBytes = 0;
+	for ( std::map<std::string, unsigned int>::const_iterator i = dataset.classes().begin(); i != dataset.classes().end(); ++i )
+		tableBytes += 8 + i->first.size();
+
+	unsigned int matrixOffset = ((headerSize + tableBytes + alignment - 1) / alignment) * alignment;
+	std::vector<char> file(matrixOffset + static_cast<std::size_t>(samples) * (features + 1) * sizeof(float), 0);
+
+	std::memcpy(&file[0], datasetMagic, sizeof(datasetMagic));
+	writeField(&file[versionField], datasetVersion);
+	writeField(&file[byteOrderField], datasetByteOrder);
+	writeField(&file[featuresField], features);
+	writeField(&file[samplesField], samples);
+	writeField(&file[classesField], dataset.classes().size());
+	writeField(&file[tableBytesField], tableBytes);
+	writeField(&file[matrixOffsetField], matrixOffset);
+
+	char* entry = &file[headerSize];
+	for ( std::map<std::string, unsigned int>::const_iterator i = dataset.classes().begin(); i != dataset.classes().end(); ++i )
+	{
+		writeField(entry, i->second);
+		writeField(entry + 4, i->first.size());
+		std::memcpy(entry + 8, i->first.data(), i->first.size());
+
+		entry += 8 + i->first.size();
+	}
+
+	float* matrix = reinterpret_cast<float*>(&file[matrixOffset]);
+	char* labels = &file[matrixOffset + static_cast<std::size_t>(samples) * features * sizeof(float)];
+	for ( unsigned int i = 0, row = 0; i < dataset.size(); ++i )
+	{
+		if ( dataset.removed(i) )
+			continue;
+
+		const Sample& sample = dataset.at(i);
+
+		for ( unsigned int j = 0; j < features; ++j )
+			matrix[static_cast<std::size_t>(row) * features + j] = static_cast<float>(sample.first[j]);
+
+		writeField(labels + static_cast<std::size_t>(row) * sizeof(unsigned int), sample.second);
+		++row;
+	}
+
+	writeField(&file[checksumField], checksum(&file[headerSize], file.size() - headerSize));
+
+	// Other processes may be reading the old file, so the new one replaces it only once it is complete
+	std::string temporaryFile(filename + ".tmp");
+	{
+		std::ofstream stream(temporaryFile.data(), std::ios::binary | std::ios::trunc);
+		if ( not stream.is_open() )
+			throw NessieException ("BinaryDataset::save() : The file " + temporaryFile + " could not be created.");
+
+		stream.write(&file[0], file.size());
+
+		if ( not stream.good() )
+			throw NessieException ("BinaryDataset::save() : The file " + temporaryFile + " could not be written.");
+	}
+
+	if ( std::rename(temporaryFile.data(), filename.data()) != 0 )
+		throw NessieException ("BinaryDataset::save() : The file " + filename + " could not be replaced.");
+
+	if ( not dataset.projection().empty() )
+		dataset.projection().save(filename + ".projection");
+
+	if ( not dataset.geometry().empty() )
+		dataset.geometry().save(filename + ".geometry");
+}
+
+
+bool BinaryDataset::recognizes (const std::string& filename)
+{
+	std::ifstream file(filename.data(), std::ios::binary);
+
+	char magic[sizeof(datasetMagic)];
+	file.read(magic, sizeof(magic));
+
+	return file.good() and std::memcmp(magic, datasetMagic, sizeof(magic)) == 0;
+}
+
+
+void BinaryDataset::addSample (const Sample& sample)
+{
+	if ( sample.first.size() != features_ )
+		throw NessieException ("BinaryDataset::addSample() : The number of features in the sample is different from the one expected by the dataset.");
+
+	samples_.push_back(sample);
+	size_		= samples_.size();
+	modified_	= true;
+}
+
+
+void BinaryDataset::removeSample (const unsigned int& n)
+{
+	if ( n >= size_ or removed(n) )
+		throw NessieException ("BinaryDataset::removeSample() : The row is beyond the size of the dataset or it was already removed.");
+
+	markRemoved(n);
+	modified_ = true;
+}
+
+
+unsigned int BinaryDataset::checksum (const char* bytes, const std::size_t& length, unsigned int hash)
+{
+	for ( std::size_t i = 0; i < length; ++i )
+	{
+		hash ^= static_cast<unsigned char>(bytes[i]);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
@@ -0,0 +1,155 @@
+/// @file
+/// @brief Definition of CascadeClassificationAlgorithm class
+
+#include "CascadeClassificationAlgorithm.hpp"
+#include "DatasetEngine.hpp"
+#include "Dataset.hpp"
+#include "FeatureVector.hpp"
+#include "ClassifierStatistics.hpp"
+#include "Text.hpp"
+#include "NessieException.hpp"
+#include <cmath>
+#include <limits>
+
+
+CascadeClassificationAlgorithm::CascadeClassificationAlgorithm (const unsigned int& kNeighbours, DatasetEngine engine, const double& threshold, const unsigned int& threads,
+																SearchEngine search, DistanceMetric metric)
+:	ClassificationAlgorithm(),
+	knn_(kNeighbours, engine, threads, search, metric),
+	means_(1, false),
+	threshold_(threshold),
+	geometries_(0),
+	rows_(0),
+	firstStageRate_(-1.0),
+	secondStageUsed_(false)
+{
+	if ( threshold_ < 0.0 or threshold_ > 1.0 )
+		throw NessieException ("CascadeClassificationAlgorithm::CascadeClassificationAlgorithm() : The threshold must be between 0 and 1.");
+
+	means_.build(knn_.matrix());
+	rows_ = knn_.matrix().rows();
+}
+
+
+CascadeClassificationAlgorithm::~CascadeClassificationAlgorithm () {}
+
+
+std::vector<std::string> CascadeClassificationAlgorithm::classify (const std::vector<FeatureVector>& featureVectors) const
+{
+	const SampleMatrix& matrix = knn_.matrix();
+
+	if ( featureVectors.empty() or matrix.rows() == 0 )
+		return knn_.classify(featureVectors, geometries_);
+
+	if ( knn_.dataset().features() != featureVectors.begin()->size() )
+		throw NessieException ("CascadeClassificationAlgorithm::classify() : The number of features stored in the dataset is different from the one expected by the program.");
+
+	std::vector<std::string> characters(featureVectors.size(), "");
+	std::vector<FeatureVector> pending(0);
+	std::vector<unsigned int> positions(0);
+	std::vector<GlyphGeometry> geometries(0);
+	bool withGeometry = geometries_.size() == featureVectors.size();
+
+	// First stage: keep the class of the nearest mean when it is clearly nearer than the second one
+	std::vector<double> query(matrix.stride(), 0.0);
+	for ( unsigned int k = 0; k < featureVectors.size(); ++k )
+	{
+		matrix.load(featureVectors.at(k), query);
+
+		unsigned int first, second;
+		double firstDistance, secondDistance;
+		means_.nearestMeans(&query[0], first, firstDistance, second, secondDistance);
+
+		double margin = 1.0;
+		if ( secondDistance == 0.0 )
+			margin = 0.0;
+		else if ( secondDistance < std::numeric_limits<double>::infinity() )
+			margin = 1.0 - std::sqrt(firstDistance / secondDistance);
+
+		if ( margin >= threshold_ )
+			characters.at(k) = knn_.dataset().character(first);
+		else
+		{
+			pending.push_back(featureVectors.at(k));
+			positions.push_back(k);
+
+			if ( withGeometry )
+				geometries.push_back(geometries_.at(k));
+		}
+	}
+
+	firstStageRate_ = ( static_cast<double>(featureVectors.size() - pending.size()) / featureVectors.size() ) * 100;
+
+	// Second stage: classify the rest at once, so that the KNN search keeps its batches and threads
+	secondStageUsed_ = not pending.empty();
+	if ( secondStageUsed_ )
+	{
+		std::vector<std::string> fallback( knn_.classify(pending, geometries) );
+
+		for ( unsigned int i = 0; i < positions.size(); ++i )
+			characters.at(positions[i]) = fallback.at(i);
+	}
+
+	return characters;
+}
+
+
+double CascadeClassificationAlgorithm::train (const std::vector<FeatureVector>& featureVectors, const std::vector<std::string>& characters, const Text& referenceText)
+{
+	double hitRate = knn_.train(featureVectors, characters, referenceText);
+	updateMeans();
+
+	return hitRate;
+}
+
+
+double CascadeClassificationAlgorithm::train (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode)
+{
+	double hitRate = knn_.train(featureVector, character, asciiCode);
+	updateMeans();
+
+	return hitRate;
+}
+
+
+void CascadeClassificationAlgorithm::updateStatistics (ClassifierStatistics& statistics) const
+{
+	if ( firstStageRate_ < 0.0 )
+		return;
+
+	statistics.firstStageRate(firstStageRate_);
+	statistics.secondStageRate(100.0 - firstStageRate_);
+
+	if ( secondStageUsed_ )
+		knn_.updateStatistics(statistics);
+}
+
+
+void CascadeClassificationAlgorithm::updateMeans ()
+{
+	const SampleMatrix& matrix = knn_.matrix();
+
+	for ( ; rows_ < matrix.rows(); ++rows_ )
+		means_.append(matrix, rows_);
+}
+
+
+const FeatureProjection* CascadeClassificationAlgorithm::projection () const
+{
+	return knn_.projection();
+}
+
+
+double CascadeClassificationAlgorithm::storageTime () const
+{
+	return knn_.storageTime();
+}
+
+
+void CascadeClassificationAlgorithm::geometries (const std::vector<GlyphGeometry>& geometries)
+{
+	geometries_ = geometries;
+
+	// Training passes every feature vector to the second stage
+	knn_.geometries(geometries);
+}
@@ -0,0 +1,64 @@
+/// @file
+/// @brief Definition of CascadeClassifier class
+
+#include "CascadeClassifier.hpp"
+#include "CascadeClassificationAlgorithm.hpp"
+#include "Text.hpp"
+#include "DatasetEngine.hpp"
+#include "FeatureVector.hpp"
+#include "NessieException.hpp"
+#include <boost/timer.hpp>
+
+
+CascadeClassifier::CascadeClassifier (const unsigned int& nNeighbours, DatasetEngine engine, const double& threshold, const unsigned int& threads, SearchEngine search,
+									  DistanceMetric metric)
+:	Classifier()
+{
+	classificationAlgorithm_ = new CascadeClassificationAlgorithm(nNeighbours, engine, threshold, threads, search, metric);
+}
+
+
+CascadeClassifier::~CascadeClassifier ()
+{
+	delete classificationAlgorithm_;
+}
+
+
+std::vector<std::string> CascadeClassifier::performClassification (const std::vector<FeatureVector>& featureVectors)
+{
+	boost::timer timer;
+	timer.restart();
+
+	std::vector<std::string> characters( classificationAlgorithm_->classify(featureVectors) );
+
+	statistics_.classificationTime(timer.elapsed());
+	classificationAlgorithm_->updateStatistics(statistics_);
+
+	return characters;
+}
+
+
+void CascadeClassifier::performTraining (const std::vector<FeatureVector>& featureVectors, const std::vector<std::string>& characters, const Text& referenceText)
+{
+	if ( featureVectors.size() != characters.size() )
+		throw NessieException ("CascadeClassifier::performTraining() : The number of feature vectors is different from the number of characters classified.");
+
+	if ( referenceText.size() != characters.size() )
+		throw NessieException ("CascadeClassifier::performTraining() : The size of reference text is different from the number of characters classified.");
+
+	double hitRate = classificationAlgorithm_->train(featureVectors, characters, referenceText);
+
+	statistics_.hitRate(hitRate);
+	statistics_.missRate(100.0 - hitRate);
+	statistics_.storageTime(classificationAlgorithm_->storageTime());
+}
+
+
+void CascadeClassifier::performTraining (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode)
+{
+	double hitRate = classificationAlgorithm_->train(featureVector, character, asciiCode);
+
+	statistics_.hitRate(hitRate);
+	statistics_.missRate(100.0 - hitRate);
+	statistics_.storageTime(classificationAlgorithm_->storageTime());
+}
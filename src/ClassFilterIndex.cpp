@@ -0,0 +1,363 @@
+/// @file
+/// @brief Definition of ClassFilterIndex class
+
+#include "ClassFilterIndex.hpp"
+#include "SampleMatrix.hpp"
+#include "NeighbourList.hpp"
+#include "NessieException.hpp"
+#include <algorithm>
+#include <utility>
+#include <limits>
+
+
+ClassFilterIndex::ClassFilterIndex (const unsigned int& classes, const bool& exact)
+:	KnnIndex(),
+	classes_(classes),
+	exact_(exact),
+	stride_(0),
+	index_(),
+	labels_(0),
+	rows_(0),
+	live_(0),
+	sums_(0),
+	means_(0),
+	lower_(0),
+	upper_(0)
+{
+	if ( classes_ == 0 )
+		throw NessieException ("ClassFilterIndex::ClassFilterIndex() : The number of classes must be greater than zero.");
+}
+
+
+ClassFilterIndex::~ClassFilterIndex () {}
+
+
+void ClassFilterIndex::build (const SampleMatrix& matrix)
+{
+	stride_ = matrix.stride();
+	index_.clear();
+	labels_.clear();
+	rows_.clear();
+	live_.clear();
+	sums_.clear();
+	means_.clear();
+	lower_.clear();
+	upper_.clear();
+
+	for ( unsigned int i = 0; i < matrix.rows(); ++i )
+		append(matrix, i);
+}
+
+
+void ClassFilterIndex::append (const SampleMatrix& matrix, const unsigned int& n)
+{
+	const double* sample = matrix.row(n);
+
+	std::map<unsigned int, unsigned int>::iterator position = index_.find(matrix.label(n));
+	if ( position == index_.end() )
+	{
+		position = index_.insert( std::make_pair(matrix.label(n), static_cast<unsigned int>(rows_.size())) ).first;
+
+		labels_.push_back(matrix.label(n));
+		rows_.push_back(std::vector<unsigned int>(0));
+		live_.push_back(0);
+		sums_.resize(sums_.size() + stride_, 0.0);
+		means_.resize(means_.size() + stride_, 0.0);
+		lower_.insert(lower_.end(), sample, sample + stride_);
+		upper_.insert(upper_.end(), sample, sample + stride_);
+	}
+
+	unsigned int c = position->second;
+	rows_[c].push_back(n);
+
+	if ( not matrix.removed(n) )
+		++live_[c];
+
+	double* sum		= &sums_[static_cast<std::size_t>(c) * stride_];
+	double* mean	= &means_[static_cast<std::size_t>(c) * stride_];
+	double* lower	= &lower_[static_cast<std::size_t>(c) * stride_];
+	double* upper	= &upper_[static_cast<std::size_t>(c) * stride_];
+
+	for ( unsigned int j = 0; j < stride_; ++j )
+	{
+		sum[j]		+= sample[j];
+		mean[j]		= sum[j] / rows_[c].size();
+		lower[j]	= std::min(lower[j], sample[j]);
+		upper[j]	= std::max(upper[j], sample[j]);
+	}
+}
+
+
+void ClassFilterIndex::remove (const SampleMatrix& matrix, const unsigned int& n)
+{
+	std::map<unsigned int, unsigned int>::const_iterator position = index_.find(matrix.label(n));
+	if ( position != index_.end() and live_[position->second] > 0 )
+		--live_[position->second];
+}
+
+
+void ClassFilterIndex::remap (const SampleMatrix& matrix, const std::vector<unsigned int>& rows)
+{
+	unsigned int nClasses = 0;
+	for ( unsigned int c = 0; c < labels_.size(); ++c )
+	{
+		std::vector<unsigned int>& classRows = rows_[c];
+
+		unsigned int kept = 0;
+		for ( std::vector<unsigned int>::const_iterator i = classRows.begin(); i != classRows.end(); ++i )
+		{
+			if ( rows[*i] != SampleMatrix::purgedRow )
+				classRows[kept++] = rows[*i];
+		}
+
+		bool changed = kept < classRows.size();
+		classRows.resize(kept);
+
+		if ( kept == 0 )
+			continue;
+
+		// The classes left are moved down over the ones dropped
+		if ( nClasses != c )
+		{
+			std::size_t from	= static_cast<std::size_t>(c) * stride_;
+			std::size_t to		= static_cast<std::size_t>(nClasses) * stride_;
+
+			labels_[nClasses] = labels_[c];
+			rows_[nClasses].swap(classRows);
+			live_[nClasses] = live_[c];
+			std::copy(sums_.begin() + from, sums_.begin() + from + stride_, sums_.begin() + to);
+			std::copy(means_.begin() + from, means_.begin() + from + stride_, means_.begin() + to);
+			std::copy(lower_.begin() + from, lower_.begin() + from + stride_, lower_.begin() + to);
+			std::copy(upper_.begin() + from, upper_.begin() + from + stride_, upper_.begin() + to);
+		}
+
+		if ( changed )
+			summarize(matrix, nClasses);
+
+		// The matrix has no rows removed after a purge
+		live_[nClasses] = kept;
+		++nClasses;
+	}
+
+	std::size_t size = static_cast<std::size_t>(nClasses) * stride_;
+	labels_.resize(nClasses);
+	rows_.resize(nClasses);
+	live_.resize(nClasses);
+	sums_.resize(size);
+	means_.resize(size);
+	lower_.resize(size);
+	upper_.resize(size);
+
+	index_.clear();
+	for ( unsigned int c = 0; c < nClasses; ++c )
+		index_.insert( std::make_pair(labels_[c], c) );
+}
+
+
+unsigned int ClassFilterIndex::search (const SampleMatrix& matrix, const double* query, NeighbourList& neighbours) const
+{
+	// Rank the classes by the distance between the query and their mean, leaving out the ones whose samples have all been removed
+	std::vector< std::pair<double, unsigned int> > ranking(0);
+	ranking.reserve(rows_.size());
+
+	for ( unsigned int c = 0; c < rows_.size(); ++c )
+	{
+		if ( live_[c] == 0 )
+			continue;
+
+		const double* mean = &means_[static_cast<std::size_t>(c) * stride_];
+
+		double distance = 0.0;
+		for ( unsigned int j = 0; j < stride_; ++j )
+			distance += (query[j] - mean[j]) * (query[j] - mean[j]);
+
+		ranking.push_back( std::make_pair(distance, c) );
+	}
+
+	unsigned int nClasses = ranking.size();
+
+	unsigned int nearest = std::min(classes_, nClasses);
+	std::partial_sort(ranking.begin(), ranking.begin() + nearest, ranking.end());
+
+	unsigned int evaluations = 0;
+	for ( unsigned int c = 0; c < nearest; ++c )
+		evaluations += scan(matrix, query, ranking[c].second, neighbours);
+
+	if ( not exact_ )
+		return evaluations;
+
+	// Visit the rest of classes by increasing distance to their bounding box
+	std::vector< std::pair<double, unsigned int> > boxes(0);
+	boxes.reserve(nClasses - nearest);
+
+	for ( unsigned int c = nearest; c < nClasses; ++c )
+	{
+		unsigned int position	= ranking[c].second;
+		const double* lower		= &lower_[static_cast<std::size_t>(position) * stride_];
+		const double* upper		= &upper_[static_cast<std::size_t>(position) * stride_];
+
+		double distance = 0.0;
+		for ( unsigned int j = 0; j < stride_; ++j )
+		{
+			double gap = std::max(0.0, std::max(lower[j] - query[j], query[j] - upper[j]));
+			distance += gap * gap;
+		}
+
+		boxes.push_back( std::make_pair(distance, position) );
+	}
+	std::sort(boxes.begin(), boxes.end());
+
+	// Shrink the bounds slightly so that rounding errors never prune a class with a sample lying exactly at the bound
+	for ( std::vector< std::pair<double, unsigned int> >::const_iterator c = boxes.begin(); c != boxes.end(); ++c )
+	{
+		if ( c->first * (1.0 - 1e-9) > neighbours.bound() )
+			break;
+
+		evaluations += scan(matrix, query, c->second, neighbours);
+	}
+
+	return evaluations;
+}
+
+
+void ClassFilterIndex::nearestMeans (const double* query, unsigned int& first, double& firstDistance, unsigned int& second, double& secondDistance) const
+{
+	first			= 0;
+	second			= 0;
+	firstDistance	= std::numeric_limits<double>::infinity();
+	secondDistance	= std::numeric_limits<double>::infinity();
+
+	for ( unsigned int c = 0; c < labels_.size(); ++c )
+	{
+		if ( live_[c] == 0 )
+			continue;
+
+		const double* mean = &means_[static_cast<std::size_t>(c) * stride_];
+
+		double distance = 0.0;
+		for ( unsigned int j = 0; j < stride_; ++j )
+			distance += (query[j] - mean[j]) * (query[j] - mean[j]);
+
+		if ( distance < firstDistance )
+		{
+			second			= first;
+			secondDistance	= firstDistance;
+			first			= labels_[c];
+			firstDistance	= distance;
+		}
+		else if ( distance < secondDistance )
+		{
+			second			= labels_[c];
+			secondDistance	= distance;
+		}
+	}
+}
+
+
+unsigned int ClassFilterIndex::scan (const SampleMatrix& matrix, const double* query, const unsigned int& c, NeighbourList& neighbours) const
+{
+	const std::vector<unsigned int>& rows = rows_[c];
+	double bound = neighbours.bound();
+	unsigned int evaluations = 0;
+
+	for ( std::vector<unsigned int>::const_iterator i = rows.begin(); i != rows.end(); ++i )
+	{
+		if ( matrix.removed(*i) )
+			continue;
+
+		double distance = matrix.squaredDistance(query, *i, bound);
+		++evaluations;
+
+		if ( not (distance > bound) )
+		{
+			neighbours.insert(distance, *i);
+			bound = neighbours.bound();
+		}
+	}
+
+	return evaluations;
+}
+
+
+void ClassFilterIndex::summarize (const SampleMatrix& matrix, const unsigned int& c)
+{
+	const std::vector<unsigned int>& rows = rows_[c];
+
+	double* sum		= &sums_[static_cast<std::size_t>(c) * stride_];
+	double* mean	= &means_[static_cast<std::size_t>(c) * stride_];
+	double* lower	= &lower_[static_cast<std::size_t>(c) * stride_];
+	double* upper	= &upper_[static_cast<std::size_t>(c) * stride_];
+
+	std::fill(sum, sum + stride_, 0.0);
+	std::copy(matrix.row(rows.front()), matrix.row(rows.front()) + stride_, lower);
+	std::copy(matrix.row(rows.front()), matrix.row(rows.front()) + stride_, upper);
+
+	for ( std::vector<unsigned int>::const_iterator i = rows.begin(); i != rows.end(); ++i )
+	{
+		const double* sample = matrix.row(*i);
+
+		for ( unsigned int j = 0; j < stride_; ++j )
+		{
+			sum[j]		+= sample[j];
+			lower[j]	= std::min(lower[j], sample[j]);
+			upper[j]	= std::max(upper[j], sample[j]);
+		}
+	}
+
+	for ( unsigned int j = 0; j < stride_; ++j )
+		mean[j] = sum[j] / rows.size();
+}
+
+
+unsigned int ClassFilterIndex::identifier () const
+{
+	return 3;
+}
+
+
+void ClassFilterIndex::write (std::string& buffer) const
+{
+	writeValue(buffer, stride_);
+	writeArray(buffer, labels_);
+
+	for ( unsigned int c = 0; c < labels_.size(); ++c )
+		writeArray(buffer, rows_[c]);
+
+	writeArray(buffer, sums_);
+	writeArray(buffer, means_);
+	writeArray(buffer, lower_);
+	writeArray(buffer, upper_);
+}
+
+
+bool ClassFilterIndex::read (const char*& position, const char* end, const SampleMatrix& matrix)
+{
+	if ( not readValue(position, end, stride_) or stride_ != matrix.stride() or not readArray(position, end, labels_) )
+		return false;
+
+	index_.clear();
+	rows_.assign(labels_.size(), std::vector<unsigned int>(0));
+	live_.assign(labels_.size(), 0);
+	for ( unsigned int c = 0; c < labels_.size(); ++c )
+	{
+		if ( not readArray(position, end, rows_[c]) )
+			return false;
+
+		for ( std::vector<unsigned int>::const_iterator i = rows_[c].begin(); i != rows_[c].end(); ++i )
+		{
+			if ( *i >= matrix.rows() )
+				return false;
+
+			if ( not matrix.removed(*i) )
+				++live_[c];
+		}
+
+		index_.insert( std::make_pair(labels_[c], c) );
+	}
+
+	if ( not readArray(position, end, sums_) or not readArray(position, end, means_) or not readArray(position, end, lower_) or not readArray(position, end, upper_) )
+		return false;
+
+	std::size_t size = labels_.size() * static_cast<std::size_t>(stride_);
+	return sums_.size() == size and means_.size() == size and lower_.size() == size and upper_.size() == size;
+}
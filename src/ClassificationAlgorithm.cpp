@@ -2,8 +2,85 @@
 /// @brief Definition of ClassificationAlgorithm class
 
 #include "ClassificationAlgorithm.hpp"
+#include "DatasetEngine.hpp"
+#include "PlainTextDataset.hpp"
+#include "BinaryDataset.hpp"
+#include "MySqlDataset.hpp"
+#include "PostgreSqlDataset.hpp"
+#include "ShardedDataset.hpp"
+#include "SqliteDataset.hpp"
+#include "NessieException.hpp"
 
 ClassificationAlgorithm::ClassificationAlgorithm () {}
 
 ClassificationAlgorithm::~ClassificationAlgorithm () {}
 
+void ClassificationAlgorithm::updateStatistics (ClassifierStatistics&) const {}
+
+double ClassificationAlgorithm::storageTime () const
+{
+	return 0.0;
+}
+
+const FeatureProjection* ClassificationAlgorithm::projection () const
+{
+	return 0;
+}
+
+void ClassificationAlgorithm::geometries (const std::vector<GlyphGeometry>&) {}
+
+Dataset* ClassificationAlgorithm::createDataset (DatasetEngine engine)
+{
+#if !defined(_WITH_POSTGRESQL_DATASET_) && !defined(_WITH_MYSQL_DATASET_)
+	if ( engine.type() == DatasetEngineType::PostgreSql() || engine.type() == DatasetEngineType::MySql() )
+		throw NessieException("ClassificationAlgorithm::createDataset() : A database-based dataset has been requested, but this program has not been \
+compiled with database support. Try to use a plain-text-based dataset or recompile the program.");
+#endif
+
+#if defined(_WITH_POSTGRESQL_DATASET_)
+	if ( engine.type() == DatasetEngineType::PostgreSql() )
+		return new PostgreSqlDataset (engine.database(), engine.username(), engine.password(), engine.snapshot());
+#endif
+
+#if defined(_WITH_MYSQL_DATASET_)
+	if ( engine.type() == DatasetEngineType::MySql() )
+		return new MySqlDataset (engine.database(), engine.username(), engine.password(), engine.batchSize());
+#endif
+
+#if defined(_WITH_SQLITE_DATASET_)
+	if ( engine.type() == DatasetEngineType::Sqlite() )
+		return new SqliteDataset (engine.filename());
+#endif
+
+	if ( engine.type() == DatasetEngineType::PlainText() )
+		return new PlainTextDataset (engine.filename());
+
+	if ( engine.type() == DatasetEngineType::Binary() )
+		return new BinaryDataset (engine.filename());
+
+	if ( engine.type() == DatasetEngineType::Sharded() )
+	{
+		std::vector<Dataset*> shards(0);
+		try
+		{
+			for ( std::vector<std::string>::const_iterator i = engine.filenames().begin(); i != engine.filenames().end(); ++i )
+			{
+				if ( BinaryDataset::recognizes(*i) )
+					shards.push_back( new BinaryDataset (*i) );
+				else
+					shards.push_back( new PlainTextDataset (*i) );
+			}
+		}
+		catch (...)
+		{
+			for ( std::vector<Dataset*>::iterator i = shards.begin(); i != shards.end(); ++i )
+				delete *i;
+
+			throw;
+		}
+
+		return new ShardedDataset (shards);
+	}
+
+	throw NessieException("ClassificationAlgorithm::createDataset() : The dataset engine requested is not supported by this program.");
+}
@@ -11,3 +11,17 @@ Classifier::Classifier ()
 
 Classifier::~Classifier () {}
 
+const FeatureProjection* Classifier::projection () const
+{
+	if ( classificationAlgorithm_ == 0 )
+		return 0;
+
+	return classificationAlgorithm_->projection();
+}
+
+void Classifier::geometries (const std::vector<GlyphGeometry>& geometries)
+{
+	if ( classificationAlgorithm_ != 0 )
+		classificationAlgorithm_->geometries(geometries);
+}
+
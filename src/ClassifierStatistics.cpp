@@ -10,7 +10,13 @@ ClassifierStatistics::ClassifierStatistics ()
 :	Statistics(),	// Invoke base class copy constructor.
 	classificationTime_(0),
 	hitRate_(0),
-	missRate_(0)
+	missRate_(0),
+	classificationThreads_(0),
+	concurrency_(0),
+	avoidedDistances_(0),
+	firstStageRate_(0),
+	secondStageRate_(0),
+	storageTime_(0)
 {}
 
 
@@ -18,7 +24,13 @@ ClassifierStatistics::ClassifierStatistics (const ClassifierStatistics& statisti
 :	Statistics(statistics),	// Invoke base class copy constructor.
 	classificationTime_(0),
 	hitRate_(0),
-	missRate_(0)
+	missRate_(0),
+	classificationThreads_(0),
+	concurrency_(0),
+	avoidedDistances_(0),
+	firstStageRate_(0),
+	secondStageRate_(0),
+	storageTime_(0)
 {
 	if ( statistics.classificationTime_.get() != 0 )
 		classificationTime_.reset( new double (*statistics.classificationTime_));
@@ -28,6 +40,24 @@ ClassifierStatistics::ClassifierStatistics (const ClassifierStatistics& statisti
 
 	if ( statistics.missRate_.get() != 0 )
 		missRate_.reset( new double (*statistics.missRate_));
+
+	if ( statistics.classificationThreads_.get() != 0 )
+		classificationThreads_.reset( new unsigned int (*statistics.classificationThreads_));
+
+	if ( statistics.concurrency_.get() != 0 )
+		concurrency_.reset( new double (*statistics.concurrency_));
+
+	if ( statistics.avoidedDistances_.get() != 0 )
+		avoidedDistances_.reset( new long unsigned int (*statistics.avoidedDistances_));
+
+	if ( statistics.firstStageRate_.get() != 0 )
+		firstStageRate_.reset( new double (*statistics.firstStageRate_));
+
+	if ( statistics.secondStageRate_.get() != 0 )
+		secondStageRate_.reset( new double (*statistics.secondStageRate_));
+
+	if ( statistics.storageTime_.get() != 0 )
+		storageTime_.reset( new double (*statistics.storageTime_));
 }
 
 
@@ -47,6 +77,24 @@ ClassifierStatistics& ClassifierStatistics::operator= (const ClassifierStatistic
 	if ( statistics.missRate_.get() != 0 )
 		missRate_.reset( new double (*statistics.missRate_));
 
+	if ( statistics.classificationThreads_.get() != 0 )
+		classificationThreads_.reset( new unsigned int (*statistics.classificationThreads_));
+
+	if ( statistics.concurrency_.get() != 0 )
+		concurrency_.reset( new double (*statistics.concurrency_));
+
+	if ( statistics.avoidedDistances_.get() != 0 )
+		avoidedDistances_.reset( new long unsigned int (*statistics.avoidedDistances_));
+
+	if ( statistics.firstStageRate_.get() != 0 )
+		firstStageRate_.reset( new double (*statistics.firstStageRate_));
+
+	if ( statistics.secondStageRate_.get() != 0 )
+		secondStageRate_.reset( new double (*statistics.secondStageRate_));
+
+	if ( statistics.storageTime_.get() != 0 )
+		storageTime_.reset( new double (*statistics.storageTime_));
+
 	return *this;
 }
 
@@ -59,6 +107,24 @@ void ClassifierStatistics::print () const
 	if ( classificationTime_.get() != 0 )
 		std::cout << "  - Classification time           : " << *classificationTime_ << " s" << std::endl;
 
+	if ( classificationThreads_.get() != 0 )
+		std::cout << "  - Classification threads        : " << *classificationThreads_ << std::endl;
+
+	if ( concurrency_.get() != 0 )
+		std::cout << "  - Average threads busy          : " << std::setprecision(2) << std::fixed << *concurrency_ << std::endl;
+
+	if ( avoidedDistances_.get() != 0 )
+		std::cout << "  - Distance evaluations avoided  : " << *avoidedDistances_ << std::endl;
+
+	if ( firstStageRate_.get() != 0 )
+		std::cout << "  - Resolved by first stage       : " << std::setprecision(2) << std::fixed << *firstStageRate_ << " %" << std::endl;
+
+	if ( secondStageRate_.get() != 0 )
+		std::cout << "  - Resolved by second stage      : " << std::setprecision(2) << std::fixed << *secondStageRate_ << " %" << std::endl;
+
+	if ( storageTime_.get() != 0 )
+		std::cout << "  - Dataset storage time          : " << std::setprecision(6) << *storageTime_ << " s" << std::endl;
+
 	if ( hitRate_.get() != 0 )
 		std::cout << "  - Hit rate                      : " << std::setprecision(2) << std::fixed << *hitRate_ << " %" << std::endl;
 
@@ -3,11 +3,21 @@
 
 #include "Dataset.hpp"
 
+
+///	@brief	Fraction of the rows of a dataset that must be removed before purging it pays off.
+static const double purgeRatio = 0.25;
+
+
 Dataset::Dataset ()
 :	samples_(0),
 	classes_(),
 	size_(0),
-	features_(0)
+	features_(0),
+	projection_(),
+	geometry_(),
+	storageTime_(0.0),
+	removed_(0),
+	removedSamples_(0)
 {}
 
 
@@ -28,6 +38,45 @@ unsigned int Dataset::code (const std::string& character) const
 }
 
 
+void Dataset::learnGeometry (const unsigned int& code, const GlyphGeometry& geometry)
+{
+	geometry_.learn(code, geometry);
+}
+
+
+void Dataset::flush () {}
+
+
+bool Dataset::needsPurge () const
+{
+	return removedSamples_ > 0 and removedSamples_ >= purgeRatio * size_;
+}
+
+
+void Dataset::purge ()
+{
+	if ( removedSamples_ == 0 )
+		return;
+
+	purgeRows(samples_);
+	size_ = samples_.size();
+
+	removed_.clear();
+	removedSamples_ = 0;
+}
+
+
+void Dataset::markRemoved (const unsigned int& n)
+{
+	// The flags are only allocated once a row is removed, so adding samples never has to extend them
+	if ( removed_.size() < size_ )
+		removed_.resize(size_, false);
+
+	removed_[n] = true;
+	++removedSamples_;
+}
+
+
 std::string Dataset::character (const unsigned int& code) const
 {
 	if ( classes_.empty() )
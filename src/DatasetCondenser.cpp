@@ -0,0 +1,290 @@
+/// @file
+/// @brief Definition of DatasetCondenser class
+
+#include "DatasetCondenser.hpp"
+#include "Dataset.hpp"
+#include "FeatureVector.hpp"
+#include "NeighbourList.hpp"
+#include "NessieException.hpp"
+#include <algorithm>
+#include <limits>
+
+
+///	@brief	Strict ordering of the rows of a matrix by label and then by features, used to bring duplicates together.
+struct DuplicateOrder
+{
+	const SampleMatrix& matrix;	///< Matrix whose rows are compared.
+
+	explicit DuplicateOrder (const SampleMatrix& m) : matrix(m) {};
+
+	bool operator() (const unsigned int& a, const unsigned int& b) const
+	{
+		if ( matrix.label(a) != matrix.label(b) )
+			return matrix.label(a) < matrix.label(b);
+
+		return std::lexicographical_compare(matrix.row(a), matrix.row(a) + matrix.stride(), matrix.row(b), matrix.row(b) + matrix.stride());
+	};
+};
+
+
+DatasetCondenser::DatasetCondenser (const Dataset& dataset)
+:	matrix_(dataset),
+	weights_(0),
+	owners_(0)
+{
+	std::vector<unsigned int> rows(0);
+	matrix_.purge(rows);
+
+	weights_.assign(matrix_.rows(), 1);
+	owners_.assign(matrix_.rows(), 0);
+	for ( unsigned int i = 0; i < matrix_.rows(); ++i )
+		owners_[i] = i;
+}
+
+
+void DatasetCondenser::collapseDuplicates ()
+{
+	std::vector<unsigned int> rows = prototypeRows();
+	std::stable_sort(rows.begin(), rows.end(), DuplicateOrder(matrix_));
+
+	std::vector<unsigned int> heirs(matrix_.rows(), 0);
+	for ( unsigned int i = 0; i < matrix_.rows(); ++i )
+		heirs[i] = i;
+
+	// The sort is stable, so the first row of every group is the one that appears first in the dataset
+	for ( unsigned int i = 1; i < rows.size(); ++i )
+	{
+		unsigned int previous = heirs[rows[i-1]];
+
+		if ( matrix_.label(rows[i]) == matrix_.label(previous) and std::equal(matrix_.row(rows[i]), matrix_.row(rows[i]) + matrix_.stride(), matrix_.row(previous)) )
+			heirs[rows[i]] = previous;
+	}
+
+	transfer(heirs);
+}
+
+
+void DatasetCondenser::edit (const unsigned int& kNeighbours)
+{
+	if ( kNeighbours == 0 )
+		throw NessieException ("DatasetCondenser::edit() : The number of neighbours must be greater than zero.");
+
+	std::vector<unsigned int> rows = prototypeRows();
+	SampleMatrix reduced;
+	reduced.assign(matrix_, rows);
+
+	std::vector<unsigned int> heirs(matrix_.rows(), 0);
+	for ( unsigned int i = 0; i < matrix_.rows(); ++i )
+		heirs[i] = i;
+
+	// Decide on every prototype before removing any of them
+	NeighbourList neighbours(kNeighbours + 1);
+	for ( std::vector<unsigned int>::const_iterator i = rows.begin(); i != rows.end(); ++i )
+	{
+		if ( classify(reduced, rows, *i, neighbours) != matrix_.label(*i) )
+			heirs[*i] = matrix_.rows();
+	}
+
+	transfer(heirs);
+}
+
+
+void DatasetCondenser::condense ()
+{
+	std::vector<unsigned int> rows = prototypeRows();
+	if ( rows.empty() )
+		return;
+
+	// Start with the first prototype and add every prototype misclassified by the store, until a whole pass adds none
+	std::vector<bool> stored(rows.size(), false);
+	std::vector<unsigned int> storeRows(1, rows.front());
+	stored.front() = true;
+
+	SampleMatrix store;
+	store.assign(matrix_, storeRows);
+
+	NeighbourList nearest(1);
+	bool changed = true;
+	while ( changed )
+	{
+		changed = false;
+
+		for ( unsigned int i = 0; i < rows.size(); ++i )
+		{
+			if ( stored[i] )
+				continue;
+
+			nearest.clear();
+			store.search(matrix_.row(rows[i]), nearest);
+
+			if ( store.label(nearest.row(0)) != matrix_.label(rows[i]) )
+			{
+				store.append(matrix_, rows[i]);
+				storeRows.push_back(rows[i]);
+				stored[i] = true;
+				changed = true;
+			}
+		}
+	}
+
+	// Give the weight of every prototype left out to the nearest stored prototype of its class
+	std::vector<unsigned int> heirs(matrix_.rows(), 0);
+	for ( unsigned int i = 0; i < matrix_.rows(); ++i )
+		heirs[i] = i;
+
+	for ( unsigned int i = 0; i < rows.size(); ++i )
+	{
+		if ( stored[i] )
+			continue;
+
+		unsigned int heir	= matrix_.rows();
+		double bound		= std::numeric_limits<double>::infinity();
+
+		for ( unsigned int j = 0; j < store.rows(); ++j )
+		{
+			if ( store.label(j) != matrix_.label(rows[i]) )
+				continue;
+
+			double distance = store.squaredDistance(matrix_.row(rows[i]), j, bound);
+			if ( distance < bound )
+			{
+				heir	= storeRows[j];
+				bound	= distance;
+			}
+		}
+
+		heirs[rows[i]] = heir;
+	}
+
+	transfer(heirs);
+}
+
+
+double DatasetCondenser::accuracy (const unsigned int& kNeighbours) const
+{
+	if ( kNeighbours == 0 )
+		throw NessieException ("DatasetCondenser::accuracy() : The number of neighbours must be greater than zero.");
+
+	if ( matrix_.rows() == 0 )
+		return 0.0;
+
+	std::vector<unsigned int> rows = prototypeRows();
+	SampleMatrix reduced;
+	reduced.assign(matrix_, rows);
+
+	NeighbourList neighbours(kNeighbours + 1);
+	double hits = 0.0;
+
+	for ( unsigned int i = 0; i < matrix_.rows(); ++i )
+	{
+		if ( classify(reduced, rows, i, neighbours) == matrix_.label(i) )
+			hits += 1.0;
+	}
+
+	return (hits / matrix_.rows()) * 100;
+}
+
+
+unsigned int DatasetCondenser::prototypes () const
+{
+	return matrix_.rows() - std::count(weights_.begin(), weights_.end(), 0u);
+}
+
+
+void DatasetCondenser::copyTo (Dataset& dataset) const
+{
+	if ( dataset.features() != matrix_.features() )
+		throw NessieException ("DatasetCondenser::copyTo() : The number of features stored in the dataset is different from the one of the prototypes.");
+
+	FeatureVector features(matrix_.features());
+
+	for ( unsigned int i = 0; i < matrix_.rows(); ++i )
+	{
+		if ( weights_[i] == 0 )
+			continue;
+
+		for ( unsigned int j = 0; j < matrix_.features(); ++j )
+			features.at(j) = matrix_.row(i)[j];
+
+		dataset.addSample(Sample(features, matrix_.label(i)));
+	}
+}
+
+
+std::vector<unsigned int> DatasetCondenser::prototypeRows () const
+{
+	std::vector<unsigned int> rows(0);
+	rows.reserve(matrix_.rows());
+
+	for ( unsigned int i = 0; i < matrix_.rows(); ++i )
+	{
+		if ( weights_[i] > 0 )
+			rows.push_back(i);
+	}
+
+	return rows;
+}
+
+
+void DatasetCondenser::transfer (const std::vector<unsigned int>& heirs)
+{
+	unsigned int nRows = matrix_.rows();
+
+	for ( unsigned int i = 0; i < nRows; ++i )
+	{
+		if ( owners_[i] < nRows )
+			owners_[i] = heirs[owners_[i]];
+
+		if ( weights_[i] > 0 and heirs[i] != i )
+		{
+			if ( heirs[i] < nRows )
+				weights_[heirs[i]] += weights_[i];
+
+			weights_[i] = 0;
+		}
+	}
+}
+
+
+unsigned int DatasetCondenser::classify (const SampleMatrix& reduced, const std::vector<unsigned int>& rows, const unsigned int& sample, NeighbourList& neighbours) const
+{
+	neighbours.clear();
+	reduced.search(matrix_.row(sample), neighbours);
+
+	// Weighted votes of the k nearest prototypes, skipping the prototype left without votes once the sample's own one is taken away
+	std::vector<unsigned int> labels(0);
+	std::vector<unsigned int> votes(0);
+
+	for ( unsigned int i = 0; i < neighbours.size() and labels.size() < neighbours.capacity() - 1; ++i )
+	{
+		unsigned int row	= rows[neighbours.row(i)];
+		unsigned int weight	= weights_[row] - ( owners_[sample] == row ? 1 : 0 );
+
+		if ( weight == 0 )
+			continue;
+
+		labels.push_back(matrix_.label(row));
+		votes.push_back(weight);
+	}
+
+	unsigned int label			= 0;
+	unsigned int appearances	= 0;
+
+	for ( unsigned int i = 0; i < labels.size(); ++i )
+	{
+		unsigned int count = 0;
+		for ( unsigned int j = 0; j < labels.size(); ++j )
+		{
+			if ( labels[j] == labels[i] )
+				count += votes[j];
+		}
+
+		if ( count > appearances or (count == appearances and labels[i] < label) )
+		{
+			label		= labels[i];
+			appearances	= count;
+		}
+	}
+
+	return label;
+}
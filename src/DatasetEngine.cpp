@@ -18,17 +18,36 @@ bool DatasetEngineType::operator== (const DatasetEngineType& engine) const
 DatasetEngine::DatasetEngine (DatasetEngineType type, const std::string& filename)
 :	type_(type),
 	filename_(filename),
+	filenames_(0),
 	database_(""),
 	username_(""),
-	password_("")
+	password_(""),
+	batchSize_(0),
+	snapshot_("")
 {}
 
 
-DatasetEngine::DatasetEngine (DatasetEngineType type, const std::string& database, const std::string& username, const std::string& password)
+DatasetEngine::DatasetEngine (DatasetEngineType type, const std::vector<std::string>& filenames)
 :	type_(type),
 	filename_(""),
+	filenames_(filenames),
+	database_(""),
+	username_(""),
+	password_(""),
+	batchSize_(0),
+	snapshot_("")
+{}
+
+
+DatasetEngine::DatasetEngine (DatasetEngineType type, const std::string& database, const std::string& username, const std::string& password,
+							  const unsigned int& batchSize, const std::string& snapshot)
+:	type_(type),
+	filename_(""),
+	filenames_(0),
 	database_(database),
 	username_(username),
-	password_(password)
+	password_(password),
+	batchSize_(batchSize),
+	snapshot_(snapshot)
 {}
 
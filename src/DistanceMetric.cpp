@@ -0,0 +1,131 @@
+/// @file
+/// @brief Definition of DistanceMetric class
+
+#include "DistanceMetric.hpp"
+#include "Dataset.hpp"
+#include "NessieException.hpp"
+#include <cmath>
+
+
+DistanceMetricType::DistanceMetricType (const unsigned int& type)
+:	id_(type)
+{}
+
+
+bool DistanceMetricType::operator== (const DistanceMetricType& metric) const
+{
+	return this->id_ == metric.id_;
+}
+
+
+DistanceMetric::DistanceMetric (DistanceMetricType type, const std::vector<double>& weights)
+:	type_(type),
+	weights_(weights)
+{}
+
+
+std::vector<double> DistanceMetric::transformation (const Dataset& dataset) const
+{
+	unsigned int n = dataset.features();
+
+	if ( type_ == DistanceMetricType::WeightedEuclidean() )
+	{
+		if ( weights_.size() != n )
+			throw NessieException ("DistanceMetric::transformation() : The number of weights is different from the number of features.");
+
+		std::vector<double> transformation(n * n, 0.0);
+		for ( unsigned int j = 0; j < n; ++j )
+		{
+			if ( weights_[j] < 0.0 )
+				throw NessieException ("DistanceMetric::transformation() : The weights cannot be negative.");
+
+			transformation[j * n + j] = std::sqrt(weights_[j]);
+		}
+
+		return transformation;
+	}
+
+	if ( not (type_ == DistanceMetricType::Mahalanobis()) )
+		return std::vector<double>(0);
+
+	// The rows removed from the dataset take no part in the covariance
+	unsigned int nSamples = dataset.size() - dataset.removedSamples();
+	if ( nSamples < 2 )
+		throw NessieException ("DistanceMetric::transformation() : The dataset must have at least two samples to estimate the covariance.");
+
+	std::vector<double> means(n, 0.0);
+	for ( unsigned int i = 0; i < dataset.size(); ++i )
+	{
+		if ( dataset.removed(i) )
+			continue;
+
+		for ( unsigned int j = 0; j < n; ++j )
+			means[j] += dataset.at(i).first.at(j);
+	}
+	for ( unsigned int j = 0; j < n; ++j )
+		means[j] /= nSamples;
+
+	// Only the lower triangle of the covariance is needed by the Cholesky factorization
+	std::vector<double> covariance(n * n, 0.0);
+	std::vector<double> centred(n, 0.0);
+	for ( unsigned int i = 0; i < dataset.size(); ++i )
+	{
+		if ( dataset.removed(i) )
+			continue;
+
+		for ( unsigned int j = 0; j < n; ++j )
+			centred[j] = dataset.at(i).first.at(j) - means[j];
+
+		for ( unsigned int j = 0; j < n; ++j )
+		{
+			for ( unsigned int l = 0; l <= j; ++l )
+				covariance[j * n + l] += centred[j] * centred[l];
+		}
+	}
+	for ( std::vector<double>::iterator i = covariance.begin(); i != covariance.end(); ++i )
+		*i /= nSamples - 1;
+
+	// Cholesky factor L of the covariance, leaving a zero column for every feature that adds no variance to the previous ones
+	std::vector<double> factor(n * n, 0.0);
+	for ( unsigned int j = 0; j < n; ++j )
+	{
+		double pivot = covariance[j * n + j];
+		for ( unsigned int l = 0; l < j; ++l )
+			pivot -= factor[j * n + l] * factor[j * n + l];
+
+		if ( pivot <= covariance[j * n + j] * 1e-12 )
+			continue;
+
+		factor[j * n + j] = std::sqrt(pivot);
+
+		for ( unsigned int i = j + 1; i < n; ++i )
+		{
+			double value = covariance[i * n + j];
+			for ( unsigned int l = 0; l < j; ++l )
+				value -= factor[i * n + l] * factor[j * n + l];
+
+			factor[i * n + j] = value / factor[j * n + j];
+		}
+	}
+
+	// The squared Mahalanobis distance of a difference d is |L⁻¹d|², and L⁻¹ is found by forward substitution
+	std::vector<double> transformation(n * n, 0.0);
+	for ( unsigned int i = 0; i < n; ++i )
+	{
+		if ( factor[i * n + i] == 0.0 )
+			continue;
+
+		transformation[i * n + i] = 1.0 / factor[i * n + i];
+
+		for ( unsigned int j = 0; j < i; ++j )
+		{
+			double value = 0.0;
+			for ( unsigned int l = j; l < i; ++l )
+				value += factor[i * n + l] * transformation[l * n + j];
+
+			transformation[i * n + j] = -value / factor[i * n + i];
+		}
+	}
+
+	return transformation;
+}
@@ -4,6 +4,7 @@
 #include "FeatureExtractor.hpp"
 #include "Pattern.hpp"
 #include "FeatureVector.hpp"
+#include "FeatureProjection.hpp"
 #include <boost/timer.hpp>
 #include <cmath>
 
@@ -28,8 +29,8 @@ void FeatureExtractor::computeMoments (const std::vector<Pattern>& patterns)
 		double xc = centroid.first;
 		double yc = centroid.second;
 
-		fv.at(0) = xc;
-		fv.at(1) = yc;
+		fv[0] = xc;
+		fv[1] = yc;
 		
 		for ( unsigned int j = 0; j < i->height(); ++j )
 		{
@@ -61,18 +62,18 @@ void FeatureExtractor::computeMoments (const std::vector<Pattern>& patterns)
 				double tk12 = pow(k-yc, 2);	// q = 2
 				double tk13 = pow(k-yc, 3);	// q = 3
 
-				fv.at(2)	+= tj2	* tk2	* i->at(j,k);
-				fv.at(3)	+= tj3	* tk3	* i->at(j,k);
-				fv.at(4)	+= tj4	* tk4	* i->at(j,k);
-				fv.at(5)	+= tj5	* tk5	* i->at(j,k);
-				fv.at(6)	+= tj6	* tk6	* i->at(j,k);
-				fv.at(7)	+= tj7	* tk7	* i->at(j,k);
-				fv.at(8)	+= tj8	* tk8	* i->at(j,k);
-				fv.at(9)	+= tj9	* tk9	* i->at(j,k);
-				fv.at(10)	+= tj10	* tk10	* i->at(j,k);
-				fv.at(11)	+= tj11	* tk11	* i->at(j,k);
-				fv.at(12)	+= tj12	* tk12	* i->at(j,k);
-				fv.at(13)	+= tj13	* tk13	* i->at(j,k);
+				fv[2]	+= tj2	* tk2	* i->at(j,k);
+				fv[3]	+= tj3	* tk3	* i->at(j,k);
+				fv[4]	+= tj4	* tk4	* i->at(j,k);
+				fv[5]	+= tj5	* tk5	* i->at(j,k);
+				fv[6]	+= tj6	* tk6	* i->at(j,k);
+				fv[7]	+= tj7	* tk7	* i->at(j,k);
+				fv[8]	+= tj8	* tk8	* i->at(j,k);
+				fv[9]	+= tj9	* tk9	* i->at(j,k);
+				fv[10]	+= tj10	* tk10	* i->at(j,k);
+				fv[11]	+= tj11	* tk11	* i->at(j,k);
+				fv[12]	+= tj12	* tk12	* i->at(j,k);
+				fv[13]	+= tj13	* tk13	* i->at(j,k);
 			}
 		}
 
@@ -80,18 +81,18 @@ void FeatureExtractor::computeMoments (const std::vector<Pattern>& patterns)
 		if ( area == 0.0 )
 			area = 1.0;
 
-		fv.at(2) /= pow(area, ((1+1)/2) + 1);
-		fv.at(3) /= pow(area, ((2+0)/2) + 1);
-		fv.at(4) /= pow(area, ((0+2)/2) + 1);
-		fv.at(5) /= pow(area, ((2+1)/2) + 1);
-		fv.at(6) /= pow(area, ((1+2)/2) + 1);
-		fv.at(7) /= pow(area, ((2+2)/2) + 1);
-		fv.at(8) /= pow(area, ((3+0)/2) + 1);
-		fv.at(9) /= pow(area, ((0+3)/2) + 1);
-		fv.at(10) /= pow(area, ((3+1)/2) + 1);
-		fv.at(11) /= pow(area, ((1+3)/2) + 1);
-		fv.at(12) /= pow(area, ((3+2)/2) + 1);
-		fv.at(13) /= pow(area, ((2+3)/2) + 1);
+		fv[2] /= pow(area, ((1+1)/2) + 1);
+		fv[3] /= pow(area, ((2+0)/2) + 1);
+		fv[4] /= pow(area, ((0+2)/2) + 1);
+		fv[5] /= pow(area, ((2+1)/2) + 1);
+		fv[6] /= pow(area, ((1+2)/2) + 1);
+		fv[7] /= pow(area, ((2+2)/2) + 1);
+		fv[8] /= pow(area, ((3+0)/2) + 1);
+		fv[9] /= pow(area, ((0+3)/2) + 1);
+		fv[10] /= pow(area, ((3+1)/2) + 1);
+		fv[11] /= pow(area, ((1+3)/2) + 1);
+		fv[12] /= pow(area, ((3+2)/2) + 1);
+		fv[13] /= pow(area, ((2+3)/2) + 1);
 
 		featureVectors_.push_back(fv);
 	}
@@ -99,3 +100,14 @@ void FeatureExtractor::computeMoments (const std::vector<Pattern>& patterns)
 	statistics_.momentsComputingTime(timer.elapsed());
 }
 
+
+void FeatureExtractor::project (const FeatureProjection& projection)
+{
+	boost::timer timer;
+	timer.restart();
+
+	for ( std::vector<FeatureVector>::iterator i = featureVectors_.begin(); i != featureVectors_.end(); ++i )
+		*i = projection.project(*i);
+
+	statistics_.projectionTime(timer.elapsed());
+}
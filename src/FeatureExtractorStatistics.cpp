@@ -7,16 +7,21 @@
 
 FeatureExtractorStatistics::FeatureExtractorStatistics ()
 :	Statistics(),
-	momentsComputingTime_(0)
+	momentsComputingTime_(0),
+	projectionTime_(0)
 {}
 
 
 FeatureExtractorStatistics::FeatureExtractorStatistics (const FeatureExtractorStatistics& statistics)
 :	Statistics(statistics),
-	momentsComputingTime_(0)
+	momentsComputingTime_(0),
+	projectionTime_(0)
 {
 	if ( statistics.momentsComputingTime_.get() != 0 )
 		momentsComputingTime_.reset( new double (*statistics.momentsComputingTime_));
+
+	if ( statistics.projectionTime_.get() != 0 )
+		projectionTime_.reset( new double (*statistics.projectionTime_));
 }
 
 
@@ -26,6 +31,9 @@ FeatureExtractorStatistics& FeatureExtractorStatistics::operator= (const Feature
 
 	if ( statistics.momentsComputingTime_.get() != 0 )
 		momentsComputingTime_.reset( new double (*statistics.momentsComputingTime_ ));
+
+	if ( statistics.projectionTime_.get() != 0 )
+		projectionTime_.reset( new double (*statistics.projectionTime_ ));
 	
 	return *this;
 }
@@ -42,6 +50,9 @@ void FeatureExtractorStatistics::print () const
 	if ( momentsComputingTime_.get() != 0 )
 		std::cout << "  - Moments computing time        : " << *momentsComputingTime_ << " s" << std::endl;
 
+	if ( projectionTime_.get() != 0 )
+		std::cout << "  - Projection time               : " << *projectionTime_ << " s" << std::endl;
+
 	std::cout << "  - Total elapsed time            : " << totalTime_  << " s" << std::endl;
 }
 
@@ -0,0 +1,269 @@
+/// @file
+/// @brief Definition of FeatureProjection class
+
+#include "FeatureProjection.hpp"
+#include "Dataset.hpp"
+#include "NessieException.hpp"
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <limits>
+#include <cmath>
+
+
+FeatureProjection::FeatureProjection ()
+:	inputs_(0),
+	outputs_(0),
+	means_(0),
+	weights_(0)
+{}
+
+
+double FeatureProjection::fit (const Dataset& dataset, const unsigned int& components)
+{
+	unsigned int nSamples	= dataset.size() - dataset.removedSamples();
+	unsigned int n			= dataset.features();
+
+	if ( nSamples < 2 )
+		throw NessieException ("FeatureProjection::fit() : The dataset must have at least two samples.");
+
+	if ( components > n )
+		throw NessieException ("FeatureProjection::fit() : The number of components cannot exceed the number of features.");
+
+	// Mean and standard deviation of every feature
+	std::vector<double> means(n, 0.0);
+	for ( unsigned int i = 0; i < dataset.size(); ++i )
+	{
+		if ( dataset.removed(i) )
+			continue;
+
+		for ( unsigned int j = 0; j < n; ++j )
+			means[j] += dataset.at(i).first.at(j);
+	}
+	for ( unsigned int j = 0; j < n; ++j )
+		means[j] /= nSamples;
+
+	std::vector<double> covariance(n * n, 0.0);
+	std::vector<double> centred(n, 0.0);
+	for ( unsigned int i = 0; i < dataset.size(); ++i )
+	{
+		if ( dataset.removed(i) )
+			continue;
+
+		for ( unsigned int j = 0; j < n; ++j )
+			centred[j] = dataset.at(i).first.at(j) - means[j];
+
+		for ( unsigned int j = 0; j < n; ++j )
+		{
+			for ( unsigned int l = j; l < n; ++l )
+				covariance[j * n + l] += centred[j] * centred[l];
+		}
+	}
+
+	std::vector<double> deviations(n, 0.0);
+	for ( unsigned int j = 0; j < n; ++j )
+		deviations[j] = std::sqrt(covariance[j * n + j] / (nSamples - 1));
+
+	// Correlation matrix, i.e. the covariance of the standardised features
+	for ( unsigned int j = 0; j < n; ++j )
+	{
+		for ( unsigned int l = j; l < n; ++l )
+		{
+			double value = 0.0;
+			if ( deviations[j] > 0.0 and deviations[l] > 0.0 )
+				value = covariance[j * n + l] / ((nSamples - 1) * deviations[j] * deviations[l]);
+
+			covariance[j * n + l] = value;
+			covariance[l * n + j] = value;
+		}
+	}
+
+	std::vector<double> eigenvectors(0);
+	diagonalise(covariance, n, eigenvectors);
+
+	std::vector< std::pair<double, unsigned int> > eigenvalues(n);
+	double total = 0.0;
+	for ( unsigned int j = 0; j < n; ++j )
+	{
+		eigenvalues[j] = std::make_pair(std::max(covariance[j * n + j], 0.0), j);
+		total += eigenvalues[j].first;
+	}
+	std::sort(eigenvalues.begin(), eigenvalues.end(), std::greater< std::pair<double, unsigned int> >());
+
+	// Keep the components with the largest variance, skipping the ones that are zero up to rounding errors
+	unsigned int outputs = ( components > 0 ) ? components : n;
+	unsigned int nonZero = 0;
+	while ( nonZero < n and eigenvalues[nonZero].first > total * 1e-12 )
+		++nonZero;
+	outputs = std::min(outputs, nonZero);
+
+	if ( outputs == 0 )
+		throw NessieException ("FeatureProjection::fit() : Every feature of the dataset is constant.");
+
+	// Fold standardisation, rotation and whitening into a single matrix
+	std::vector<double> weights(static_cast<std::size_t>(outputs) * n, 0.0);
+	double explained = 0.0;
+
+	for ( unsigned int o = 0; o < outputs; ++o )
+	{
+		unsigned int column = eigenvalues[o].second;
+		double whitening = 1.0 / std::sqrt(eigenvalues[o].first);
+
+		for ( unsigned int j = 0; j < n; ++j )
+		{
+			if ( deviations[j] > 0.0 )
+				weights[o * n + j] = eigenvectors[j * n + column] * whitening / deviations[j];
+		}
+
+		explained += eigenvalues[o].first;
+	}
+
+	inputs_		= n;
+	outputs_	= outputs;
+	means_		= means;
+	weights_	= weights;
+
+	return ( total > 0.0 ) ? explained / total : 0.0;
+}
+
+
+FeatureVector FeatureProjection::project (const FeatureVector& features) const
+{
+	if ( features.size() != inputs_ )
+		throw NessieException ("FeatureProjection::project() : The number of features is different from the one expected by the projection.");
+
+	std::vector<double> centred(inputs_, 0.0);
+	for ( unsigned int j = 0; j < inputs_; ++j )
+		centred[j] = features[j] - means_[j];
+
+	FeatureVector projected(outputs_);
+	for ( unsigned int o = 0; o < outputs_; ++o )
+	{
+		const double* w = &weights_[static_cast<std::size_t>(o) * inputs_];
+
+		double sum = 0.0;
+		for ( unsigned int j = 0; j < inputs_; ++j )
+			sum += w[j] * centred[j];
+
+		projected[o] = sum;
+	}
+
+	return projected;
+}
+
+
+void FeatureProjection::save (const std::string& filename) const
+{
+	std::ofstream file( filename.data(), std::ios::trunc );
+	if ( not file.is_open() or not file.good() )
+		throw NessieException ("FeatureProjection::save() : The file " + filename + " could not be created.");
+
+	file << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+	file << inputs_ << " " << outputs_ << std::endl;
+
+	for ( unsigned int j = 0; j < inputs_; ++j )
+		file << means_[j] << ( j + 1 < inputs_ ? " " : "" );
+	file << std::endl;
+
+	for ( unsigned int o = 0; o < outputs_; ++o )
+	{
+		for ( unsigned int j = 0; j < inputs_; ++j )
+			file << weights_[static_cast<std::size_t>(o) * inputs_ + j] << ( j + 1 < inputs_ ? " " : "" );
+		file << std::endl;
+	}
+
+	if ( not file.good() )
+		throw NessieException ("FeatureProjection::save() : The file " + filename + " could not be written.");
+}
+
+
+void FeatureProjection::load (const std::string& filename)
+{
+	std::ifstream file( filename.data() );
+	if ( not file.is_open() or not file.good() )
+		throw NessieException ("FeatureProjection::load() : The file " + filename + " could not be opened.");
+
+	unsigned int inputs = 0, outputs = 0;
+	if ( (file >> inputs >> outputs).fail() or inputs == 0 or outputs == 0 or outputs > inputs )
+		throw NessieException ("FeatureProjection::load() : The file " + filename + " is not a valid projection.");
+
+	std::vector<double> means(inputs, 0.0);
+	std::vector<double> weights(static_cast<std::size_t>(outputs) * inputs, 0.0);
+
+	for ( std::vector<double>::iterator i = means.begin(); i != means.end() and file.good(); ++i )
+		file >> *i;
+
+	for ( std::vector<double>::iterator i = weights.begin(); i != weights.end() and file.good(); ++i )
+		file >> *i;
+
+	if ( file.fail() )
+		throw NessieException ("FeatureProjection::load() : The file " + filename + " is not a valid projection.");
+
+	inputs_		= inputs;
+	outputs_	= outputs;
+	means_		= means;
+	weights_	= weights;
+}
+
+
+void FeatureProjection::diagonalise (std::vector<double>& matrix, const unsigned int& n, std::vector<double>& eigenvectors)
+{
+	eigenvectors.assign(n * n, 0.0);
+	for ( unsigned int i = 0; i < n; ++i )
+		eigenvectors[i * n + i] = 1.0;
+
+	// Every rotation zeroes an off-diagonal element; a few sweeps over all of them are enough for a small matrix
+	for ( unsigned int sweep = 0; sweep < 100; ++sweep )
+	{
+		double offDiagonal = 0.0;
+		for ( unsigned int p = 0; p < n; ++p )
+		{
+			for ( unsigned int q = p + 1; q < n; ++q )
+				offDiagonal += matrix[p * n + q] * matrix[p * n + q];
+		}
+
+		if ( offDiagonal < 1e-30 )
+			break;
+
+		for ( unsigned int p = 0; p < n; ++p )
+		{
+			for ( unsigned int q = p + 1; q < n; ++q )
+			{
+				double apq = matrix[p * n + q];
+				if ( std::fabs(apq) < 1e-300 )
+					continue;
+
+				double theta	= (matrix[q * n + q] - matrix[p * n + p]) / (2.0 * apq);
+				double t		= ( theta >= 0.0 ? 1.0 : -1.0 ) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+				double c		= 1.0 / std::sqrt(t * t + 1.0);
+				double s		= t * c;
+
+				for ( unsigned int k = 0; k < n; ++k )
+				{
+					double akp = matrix[k * n + p];
+					double akq = matrix[k * n + q];
+					matrix[k * n + p] = c * akp - s * akq;
+					matrix[k * n + q] = s * akp + c * akq;
+				}
+
+				for ( unsigned int k = 0; k < n; ++k )
+				{
+					double apk = matrix[p * n + k];
+					double aqk = matrix[q * n + k];
+					matrix[p * n + k] = c * apk - s * aqk;
+					matrix[q * n + k] = s * apk + c * aqk;
+				}
+
+				for ( unsigned int k = 0; k < n; ++k )
+				{
+					double vkp = eigenvectors[k * n + p];
+					double vkq = eigenvectors[k * n + q];
+					eigenvectors[k * n + p] = c * vkp - s * vkq;
+					eigenvectors[k * n + q] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+}
@@ -3,72 +3,88 @@
 
 #include "FeatureVector.hpp"
 #include "NessieException.hpp"
+#include <algorithm>
 #include <cmath>
 
 
 FeatureVector::FeatureVector()
-:	features_(0),
+:	features_(buffer_),
 	size_(0)
 {}
 
 
 FeatureVector::FeatureVector(const unsigned int& n)
-:	features_(std::vector<double>(n, 0.0)),
-	size_(n)
-{}
+:	features_(buffer_),
+	size_(0)
+{
+	resize(n);
+}
 
 
-double FeatureVector::computeEuclideanDistance (const FeatureVector& featureVector) const
+FeatureVector::FeatureVector (const FeatureVector& featureVector)
+:	FeatureExpression<FeatureVector>(),
+	features_(buffer_),
+	size_(0)
 {
-	if ( this->size_ not_eq featureVector.size_ )
-		throw NessieException ("FeatureVector::computeEuclideanDistance() : Size of vectors must be equal");
-	
-	double result = 0.0;
-	for ( unsigned int i = 0; i < this->size_; ++i )
-		result += pow(this->at(i) - featureVector.at(i), 2);
-
-	return sqrt(result);
+	allocate(featureVector.size_);
+	std::copy(featureVector.features_, featureVector.features_ + size_, features_);
 }
 
 
-FeatureVector FeatureVector::operator+ (const FeatureVector& featureVector) const
+FeatureVector::~FeatureVector ()
 {
-	if ( this->size_ not_eq featureVector.size_ )
-		throw NessieException ("FeatureVector::operator+() : Size of vectors to sum must be equal");
+	if ( features_ != buffer_ )
+		delete [] features_;
+}
 
-	FeatureVector temp(this->size_);
 
-	for ( unsigned int i = 0; i < this->size_; ++i )
-		temp.features_.at(i) = this->features_.at(i) + featureVector.features_.at(i);
+FeatureVector& FeatureVector::operator= (const FeatureVector& featureVector)
+{
+	if ( this != &featureVector )
+	{
+		if ( size_ != featureVector.size_ )
+			allocate(featureVector.size_);
 
-	return temp;
+		std::copy(featureVector.features_, featureVector.features_ + size_, features_);
+	}
+
+	return *this;
 }
 
 
-FeatureVector FeatureVector::operator- (const FeatureVector& featureVector) const
+void FeatureVector::allocate (const unsigned int& n)
 {
-	if ( this->size_ not_eq featureVector.size_ )
-		throw NessieException ("FeatureVector::operator-() : Size of vectors to subtract must be equal");
+	if ( features_ != buffer_ )
+		delete [] features_;
 
-	FeatureVector temp(this->size_);
+	features_	= buffer_;
+	size_		= 0;
 
-	for ( unsigned int i = 0; i < this->size_; ++i )
-		temp.features_.at(i) = this->features_.at(i) - featureVector.features_.at(i);
+	if ( n > capacity )
+		features_ = new double[n];
+
+	size_ = n;
+}
 
-	return temp;
+
+void FeatureVector::checkSizes (const unsigned int& left, const unsigned int& right, const char* operation)
+{
+	if ( left not_eq right )
+		throw NessieException (std::string("FeatureVector::") + operation + "() : Size of vectors must be equal");
 }
 
 
-double FeatureVector::operator* (const FeatureVector& featureVector) const
+double FeatureVector::computeEuclideanDistance (const FeatureVector& featureVector) const
 {
 	if ( this->size_ not_eq featureVector.size_ )
-		throw NessieException ("FeatureVector::operator*() : Size of vectors to multiply must be equal");
+		throw NessieException ("FeatureVector::computeEuclideanDistance() : Size of vectors must be equal");
 
 	double result = 0.0;
-
 	for ( unsigned int i = 0; i < this->size_; ++i )
-		result += this->features_.at(i) * featureVector.features_.at(i);
+	{
+		double difference = this->features_[i] - featureVector.features_[i];
+		result += difference * difference;
+	}
 
-	return result;
+	return sqrt(result);
 }
-
@@ -0,0 +1,122 @@
+/// @file
+/// @brief Definition of GeometryModel class
+
+#include "GeometryModel.hpp"
+#include "GlyphGeometry.hpp"
+#include "NessieException.hpp"
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+
+GeometryModel::GeometryModel ()
+:	ranges_()
+{}
+
+
+void GeometryModel::learn (const unsigned int& code, const GlyphGeometry& geometry)
+{
+	if ( not geometry.known() )
+		return;
+
+	Range range;
+	range.samples			= 1;
+	range.minAscent			= range.maxAscent		= geometry.ascent();
+	range.minDescent		= range.maxDescent		= geometry.descent();
+	range.minAspectRatio	= range.maxAspectRatio	= geometry.aspectRatio();
+
+	std::map<unsigned int, Range>::iterator i = ranges_.find(code);
+	if ( i == ranges_.end() )
+		ranges_.insert(std::make_pair(code, range));
+	else
+		extend(i->second, range);
+}
+
+
+void GeometryModel::merge (const GeometryModel& model)
+{
+	for ( std::map<unsigned int, Range>::const_iterator j = model.ranges_.begin(); j != model.ranges_.end(); ++j )
+	{
+		std::map<unsigned int, Range>::iterator i = ranges_.find(j->first);
+		if ( i == ranges_.end() )
+			ranges_.insert(*j);
+		else
+			extend(i->second, j->second);
+	}
+}
+
+
+bool GeometryModel::admits (const unsigned int& code, const GlyphGeometry& geometry) const
+{
+	if ( not geometry.known() )
+		return true;
+
+	std::map<unsigned int, Range>::const_iterator i = ranges_.find(code);
+	if ( i == ranges_.end() or i->second.samples < minimumSamples )
+		return true;
+
+	const Range& range = i->second;
+	const double tolerance	= 0.25;
+	const double factor		= 1.5;
+
+	return geometry.ascent() >= range.minAscent - tolerance and geometry.ascent() <= range.maxAscent + tolerance
+		and geometry.descent() >= range.minDescent - tolerance and geometry.descent() <= range.maxDescent + tolerance
+		and geometry.aspectRatio() >= range.minAspectRatio / factor and geometry.aspectRatio() <= range.maxAspectRatio * factor;
+}
+
+
+void GeometryModel::save (const std::string& filename) const
+{
+	std::ofstream file( filename.data(), std::ios::trunc );
+	if ( not file.is_open() or not file.good() )
+		throw NessieException ("GeometryModel::save() : The file " + filename + " could not be created.");
+
+	file << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+
+	for ( std::map<unsigned int, Range>::const_iterator i = ranges_.begin(); i != ranges_.end(); ++i )
+	{
+		file << i->first << " " << i->second.samples << " " << i->second.minAscent << " " << i->second.maxAscent << " " << i->second.minDescent
+			<< " " << i->second.maxDescent << " " << i->second.minAspectRatio << " " << i->second.maxAspectRatio << std::endl;
+	}
+
+	if ( not file.good() )
+		throw NessieException ("GeometryModel::save() : The file " + filename + " could not be written.");
+}
+
+
+void GeometryModel::load (const std::string& filename)
+{
+	std::ifstream file( filename.data() );
+	if ( not file.is_open() or not file.good() )
+		throw NessieException ("GeometryModel::load() : The file " + filename + " could not be opened.");
+
+	std::map<unsigned int, Range> ranges;
+	unsigned int code;
+	Range range;
+
+	while ( file >> code )
+	{
+		if ( (file >> range.samples >> range.minAscent >> range.maxAscent >> range.minDescent >> range.maxDescent >> range.minAspectRatio >> range.maxAspectRatio).fail() )
+			throw NessieException ("GeometryModel::load() : The file " + filename + " is not a valid geometry model.");
+
+		ranges[code] = range;
+	}
+
+	if ( not file.eof() )
+		throw NessieException ("GeometryModel::load() : The file " + filename + " is not a valid geometry model.");
+
+	ranges_ = ranges;
+}
+
+
+void GeometryModel::extend (Range& range, const Range& other)
+{
+	range.samples			+= other.samples;
+	range.minAscent			= std::min(range.minAscent, other.minAscent);
+	range.maxAscent			= std::max(range.maxAscent, other.maxAscent);
+	range.minDescent		= std::min(range.minDescent, other.minDescent);
+	range.maxDescent		= std::max(range.maxDescent, other.maxDescent);
+	range.minAspectRatio	= std::min(range.minAspectRatio, other.minAspectRatio);
+	range.maxAspectRatio	= std::max(range.maxAspectRatio, other.maxAspectRatio);
+}
@@ -0,0 +1,20 @@
+/// @file
+/// @brief Definition of GlyphGeometry class
+
+#include "GlyphGeometry.hpp"
+
+
+GlyphGeometry::GlyphGeometry ()
+:	ascent_(0.0),
+	descent_(0.0),
+	aspectRatio_(0.0),
+	known_(false)
+{}
+
+
+GlyphGeometry::GlyphGeometry (const double& ascent, const double& descent, const double& aspectRatio)
+:	ascent_(ascent),
+	descent_(descent),
+	aspectRatio_(aspectRatio),
+	known_(true)
+{}
@@ -0,0 +1,343 @@
+/// @file
+/// @brief Definition of InvertedFileIndex class
+
+#include "InvertedFileIndex.hpp"
+#include "SampleMatrix.hpp"
+#include "NeighbourList.hpp"
+#include "NessieException.hpp"
+#include <algorithm>
+#include <utility>
+#include <limits>
+
+
+InvertedFileIndex::InvertedFileIndex (const unsigned int& lists, const unsigned int& subquantizers, const unsigned int& probes)
+:	KnnIndex(),
+	lists_(lists),
+	subquantizers_(subquantizers),
+	probes_(probes),
+	stride_(0),
+	subDimension_(0),
+	codewords_(0),
+	centroids_(0),
+	codebooks_(0),
+	listRows_(0),
+	listCodes_(0)
+{
+	if ( lists_ == 0 or subquantizers_ == 0 or probes_ == 0 )
+		throw NessieException ("InvertedFileIndex::InvertedFileIndex() : The number of lists, subquantizers and probes must be greater than zero.");
+}
+
+
+InvertedFileIndex::~InvertedFileIndex () {}
+
+
+void InvertedFileIndex::build (const SampleMatrix& matrix)
+{
+	if ( matrix.stride() % subquantizers_ != 0 )
+		throw NessieException ("InvertedFileIndex::build() : The number of subquantizers must divide the padded number of features.");
+
+	stride_			= matrix.stride();
+	subDimension_	= stride_ / subquantizers_;
+	codewords_		= 0;
+	centroids_.clear();
+	codebooks_.clear();
+	listRows_.clear();
+	listCodes_.clear();
+
+	unsigned int nRows = matrix.rows();
+	if ( nRows == 0 )
+		return;
+
+	// Train the coarse centroids
+	std::vector<double> points(static_cast<std::size_t>(nRows) * stride_);
+	for ( unsigned int i = 0; i < nRows; ++i )
+		std::copy(matrix.row(i), matrix.row(i) + stride_, points.begin() + static_cast<std::size_t>(i) * stride_);
+
+	unsigned int nLists = std::min(lists_, nRows);
+	kMeans(points, nRows, stride_, nLists, centroids_);
+
+	// Replace every point by its residual with respect to the nearest centroid
+	for ( unsigned int i = 0; i < nRows; ++i )
+	{
+		double* point = &points[static_cast<std::size_t>(i) * stride_];
+		const double* centroid = &centroids_[static_cast<std::size_t>(nearest(&centroids_[0], nLists, stride_, point)) * stride_];
+
+		for ( unsigned int j = 0; j < stride_; ++j )
+			point[j] -= centroid[j];
+	}
+
+	// Train a codebook per subspace
+	codewords_ = std::min(codewords, nRows);
+	codebooks_.reserve(static_cast<std::size_t>(subquantizers_) * codewords_ * subDimension_);
+
+	std::vector<double> subvectors(static_cast<std::size_t>(nRows) * subDimension_);
+	std::vector<double> codebook(0);
+	for ( unsigned int s = 0; s < subquantizers_; ++s )
+	{
+		for ( unsigned int i = 0; i < nRows; ++i )
+		{
+			const double* residual = &points[static_cast<std::size_t>(i) * stride_ + s * subDimension_];
+			std::copy(residual, residual + subDimension_, subvectors.begin() + static_cast<std::size_t>(i) * subDimension_);
+		}
+
+		kMeans(subvectors, nRows, subDimension_, codewords_, codebook);
+		codebooks_.insert(codebooks_.end(), codebook.begin(), codebook.end());
+	}
+
+	// Fill the inverted lists
+	listRows_.assign(nLists, std::vector<unsigned int>(0));
+	listCodes_.assign(nLists, std::vector<unsigned char>(0));
+
+	for ( unsigned int i = 0; i < nRows; ++i )
+		encode(matrix, i);
+}
+
+
+void InvertedFileIndex::append (const SampleMatrix& matrix, const unsigned int& n)
+{
+	if ( not centroids_.empty() )
+		encode(matrix, n);
+}
+
+
+unsigned int InvertedFileIndex::search (const SampleMatrix& matrix, const double* query, NeighbourList& neighbours) const
+{
+	if ( centroids_.empty() )
+	{
+		matrix.search(query, neighbours);
+		return matrix.rows();
+	}
+
+	// Rank the inverted lists by the distance between their centroids and the query
+	unsigned int nLists = listRows_.size();
+	std::vector< std::pair<double, unsigned int> > ranking(nLists);
+
+	for ( unsigned int l = 0; l < nLists; ++l )
+	{
+		const double* centroid = &centroids_[static_cast<std::size_t>(l) * stride_];
+
+		double distance = 0.0;
+		for ( unsigned int j = 0; j < stride_; ++j )
+			distance += (query[j] - centroid[j]) * (query[j] - centroid[j]);
+
+		ranking[l] = std::make_pair(distance, l);
+	}
+
+	unsigned int nProbes = std::min(probes_, nLists);
+	std::partial_sort(ranking.begin(), ranking.begin() + nProbes, ranking.end());
+
+	std::vector<double> residual(stride_, 0.0);
+	std::vector<double> table(static_cast<std::size_t>(subquantizers_) * codewords_, 0.0);
+	unsigned int evaluations = 0;
+
+	for ( unsigned int p = 0; p < nProbes; ++p )
+	{
+		unsigned int l = ranking[p].second;
+		const double* centroid = &centroids_[static_cast<std::size_t>(l) * stride_];
+
+		for ( unsigned int j = 0; j < stride_; ++j )
+			residual[j] = query[j] - centroid[j];
+
+		// Distance between the query residual and every codeword of every subspace
+		for ( unsigned int s = 0; s < subquantizers_; ++s )
+		{
+			const double* subvector = &residual[s * subDimension_];
+
+			for ( unsigned int c = 0; c < codewords_; ++c )
+			{
+				const double* codeword = &codebooks_[(static_cast<std::size_t>(s) * codewords_ + c) * subDimension_];
+
+				double distance = 0.0;
+				for ( unsigned int j = 0; j < subDimension_; ++j )
+					distance += (subvector[j] - codeword[j]) * (subvector[j] - codeword[j]);
+
+				table[s * codewords_ + c] = distance;
+			}
+		}
+
+		// Approximate the distance to every sample in the list by adding up the table entries selected by its code
+		const std::vector<unsigned int>& rows	= listRows_[l];
+		const unsigned char* codes				= listCodes_[l].empty() ? 0 : &listCodes_[l][0];
+		evaluations += rows.size();
+
+		for ( unsigned int i = 0; i < rows.size(); ++i )
+		{
+			const unsigned char* code = codes + static_cast<std::size_t>(i) * subquantizers_;
+
+			double distance = 0.0;
+			for ( unsigned int s = 0; s < subquantizers_; ++s )
+				distance += table[s * codewords_ + code[s]];
+
+			if ( distance < neighbours.bound() and not matrix.removed(rows[i]) )
+				neighbours.insert(distance, rows[i]);
+		}
+	}
+
+	return evaluations;
+}
+
+
+void InvertedFileIndex::remap (const SampleMatrix&, const std::vector<unsigned int>& rows)
+{
+	for ( unsigned int l = 0; l < listRows_.size(); ++l )
+	{
+		std::vector<unsigned int>& listRows		= listRows_[l];
+		std::vector<unsigned char>& listCodes	= listCodes_[l];
+
+		unsigned int kept = 0;
+		for ( unsigned int i = 0; i < listRows.size(); ++i )
+		{
+			if ( rows[listRows[i]] == SampleMatrix::purgedRow )
+				continue;
+
+			listRows[kept] = rows[listRows[i]];
+			std::copy(listCodes.begin() + static_cast<std::size_t>(i) * subquantizers_, listCodes.begin() + static_cast<std::size_t>(i + 1) * subquantizers_,
+					  listCodes.begin() + static_cast<std::size_t>(kept) * subquantizers_);
+			++kept;
+		}
+
+		listRows.resize(kept);
+		listCodes.resize(static_cast<std::size_t>(kept) * subquantizers_);
+	}
+}
+
+
+unsigned int InvertedFileIndex::nearest (const double* points, const unsigned int& nPoints, const unsigned int& dimension, const double* point)
+{
+	unsigned int best		= 0;
+	double bestDistance		= std::numeric_limits<double>::infinity();
+
+	for ( unsigned int i = 0; i < nPoints; ++i )
+	{
+		const double* candidate = &points[static_cast<std::size_t>(i) * dimension];
+
+		double distance = 0.0;
+		for ( unsigned int j = 0; j < dimension and distance < bestDistance; ++j )
+			distance += (point[j] - candidate[j]) * (point[j] - candidate[j]);
+
+		if ( distance < bestDistance )
+		{
+			best			= i;
+			bestDistance	= distance;
+		}
+	}
+
+	return best;
+}
+
+
+void InvertedFileIndex::kMeans (const std::vector<double>& points, const unsigned int& nPoints, const unsigned int& dimension, const unsigned int& k, std::vector<double>& centroids)
+{
+	// Start from evenly spaced points
+	centroids.assign(static_cast<std::size_t>(k) * dimension, 0.0);
+	for ( unsigned int c = 0; c < k; ++c )
+	{
+		const double* point = &points[(static_cast<std::size_t>(c) * nPoints / k) * dimension];
+		std::copy(point, point + dimension, centroids.begin() + static_cast<std::size_t>(c) * dimension);
+	}
+
+	std::vector<double> sums(centroids.size(), 0.0);
+	std::vector<unsigned int> counts(k, 0);
+
+	for ( unsigned int iteration = 0; iteration < iterations; ++iteration )
+	{
+		sums.assign(sums.size(), 0.0);
+		counts.assign(k, 0);
+
+		for ( unsigned int i = 0; i < nPoints; ++i )
+		{
+			const double* point = &points[static_cast<std::size_t>(i) * dimension];
+			unsigned int c = nearest(&centroids[0], k, dimension, point);
+
+			for ( unsigned int j = 0; j < dimension; ++j )
+				sums[static_cast<std::size_t>(c) * dimension + j] += point[j];
+			++counts[c];
+		}
+
+		// Empty clusters keep their previous centroid
+		for ( unsigned int c = 0; c < k; ++c )
+		{
+			if ( counts[c] == 0 )
+				continue;
+
+			for ( unsigned int j = 0; j < dimension; ++j )
+				centroids[static_cast<std::size_t>(c) * dimension + j] = sums[static_cast<std::size_t>(c) * dimension + j] / counts[c];
+		}
+	}
+}
+
+
+void InvertedFileIndex::encode (const SampleMatrix& matrix, const unsigned int& n)
+{
+	const double* point = matrix.row(n);
+	unsigned int l = nearest(&centroids_[0], listRows_.size(), stride_, point);
+	const double* centroid = &centroids_[static_cast<std::size_t>(l) * stride_];
+
+	std::vector<double> residual(stride_);
+	for ( unsigned int j = 0; j < stride_; ++j )
+		residual[j] = point[j] - centroid[j];
+
+	listRows_[l].push_back(n);
+
+	for ( unsigned int s = 0; s < subquantizers_; ++s )
+	{
+		const double* codebook = &codebooks_[static_cast<std::size_t>(s) * codewords_ * subDimension_];
+		listCodes_[l].push_back( static_cast<unsigned char>(nearest(codebook, codewords_, subDimension_, &residual[s * subDimension_])) );
+	}
+}
+
+
+unsigned int InvertedFileIndex::identifier () const
+{
+	return 2;
+}
+
+
+void InvertedFileIndex::write (std::string& buffer) const
+{
+	writeValue(buffer, lists_);
+	writeValue(buffer, subquantizers_);
+	writeValue(buffer, stride_);
+	writeValue(buffer, codewords_);
+	writeArray(buffer, centroids_);
+	writeArray(buffer, codebooks_);
+
+	writeValue(buffer, static_cast<unsigned int>(listRows_.size()));
+	for ( unsigned int i = 0; i < listRows_.size(); ++i )
+	{
+		writeArray(buffer, listRows_[i]);
+		writeArray(buffer, listCodes_[i]);
+	}
+}
+
+
+bool InvertedFileIndex::read (const char*& position, const char* end, const SampleMatrix& matrix)
+{
+	// The number of probes is only used by the search, so an index may be loaded to be searched with a different one
+	unsigned int lists, subquantizers, nLists;
+	if ( not readValue(position, end, lists) or not readValue(position, end, subquantizers) or lists != lists_ or subquantizers != subquantizers_ )
+		return false;
+
+	if ( not readValue(position, end, stride_) or stride_ != matrix.stride() or not readValue(position, end, codewords_) )
+		return false;
+
+	if ( not readArray(position, end, centroids_) or not readArray(position, end, codebooks_) or not readValue(position, end, nLists) )
+		return false;
+
+	subDimension_ = stride_ / subquantizers_;
+	if ( centroids_.size() != static_cast<std::size_t>(nLists) * stride_ or codebooks_.size() != static_cast<std::size_t>(codewords_) * stride_ )
+		return false;
+
+	listRows_.assign(nLists, std::vector<unsigned int>(0));
+	listCodes_.assign(nLists, std::vector<unsigned char>(0));
+	for ( unsigned int i = 0; i < nLists; ++i )
+	{
+		if ( not readArray(position, end, listRows_[i]) or not readArray(position, end, listCodes_[i]) )
+			return false;
+
+		if ( listCodes_[i].size() != listRows_[i].size() * subquantizers_ )
+			return false;
+	}
+
+	return true;
+}
@@ -4,112 +4,252 @@
 #include "KnnClassificationAlgorithm.hpp"
 #include "DatasetEngine.hpp"
 #include "Dataset.hpp"
-#include "PlainTextDataset.hpp"
-#include "MySqlDataset.hpp"
-#include "PostgreSqlDataset.hpp"
+#include "ShardedDataset.hpp"
 #include "FeatureVector.hpp"
+#include "NeighbourList.hpp"
+#include "InvertedFileIndex.hpp"
+#include "PivotIndex.hpp"
+#include "ClassFilterIndex.hpp"
+#include "ClassifierStatistics.hpp"
 #include "Text.hpp"
 #include "NessieException.hpp"
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <utility>
-#include <map>
+#include <algorithm>
 #include <sstream>
 
 
-KnnClassificationAlgorithm::KnnClassificationAlgorithm (const unsigned int& kNeighbours, DatasetEngine engine)
+struct KnnClassificationAlgorithm::ClassificationJob
+{
+	std::vector<double>			queries;	///< Padded features of every query.
+
+	unsigned int				nQueries;	///< Number of queries.
+
+	std::vector<unsigned int>	labels;		///< Label found for every query.
+
+	unsigned int				nShards;	///< Number of shards every chunk is searched in.
+
+	bool						gated;		///< Whether the classes that do not admit the geometry of a query are skipped.
+
+	const std::vector<GlyphGeometry>*	geometries;	///< Geometry of every query, when the search is gated.
+
+	std::vector<unsigned char>	present;	///< Flag for every label telling whether the matrix has rows of it, when the search is gated.
+
+	std::vector<NeighbourList>	found;		///< Neighbours of every query found in every shard, one shard after another, when the matrix is sharded.
+
+	unsigned int				nextTask;	///< Next task waiting to be taken, i.e. a chunk of queries searched in a shard.
+
+	boost::mutex				mutex;		///< Lock that protects the task counter.
+};
+
+
+KnnClassificationAlgorithm::KnnClassificationAlgorithm (const unsigned int& kNeighbours, DatasetEngine engine, const unsigned int& threads, SearchEngine search,
+														DistanceMetric metric)
 :	ClassificationAlgorithm(),
 	kNeighbours_(kNeighbours),
-	dataset_(0)
-{
-#if !defined(_WITH_POSTGRESQL_DATASET_) && !defined(_WITH_MYSQL_DATASET_)
-	if ( engine.type() == DatasetEngineType::PostgreSql() || engine.type() == DatasetEngineType::MySql() )
-		throw NessieException("KnnClassificationAlgorithm::KnnClassificationAlgorithm() : A database-based dataset has been requested, but this program has not been \
-compiled with database support. Try to use a plain-text-based dataset or recompile the program.");
-#endif
-
-#if defined(_WITH_POSTGRESQL_DATASET_)
-	if ( engine.type() == DatasetEngineType::PostgreSql() )
-		dataset_ = new PostgreSqlDataset  (engine.database(), engine.username(), engine.password());
-#endif
-
-#if defined(_WITH_MYSQL_DATASET_)
-	if ( engine.type() == DatasetEngineType::MySql() )
-		dataset_ = new MySqlDataset (engine.database(), engine.username(), engine.password());
-#endif
-	
-	if ( engine.type() == DatasetEngineType::PlainText() )
-		dataset_ = new PlainTextDataset (engine.filename());
+	dataset_(0),
+	matrix_(),
+	index_(0),
+	indexFile_(""),
+	indexSaved_(false),
+	shards_(0),
+	threads_(threads),
+	threadsUsed_(0),
+	concurrency_(0.0),
+	avoidedDistances_(0),
+	gated_(false),
+	storageTime_(0.0)
+{
+	if ( kNeighbours_ == 0 )
+		throw NessieException("KnnClassificationAlgorithm::KnnClassificationAlgorithm() : The number of neighbours must be greater than zero.");
+
+	if ( threads_ == 0 )
+		throw NessieException("KnnClassificationAlgorithm::KnnClassificationAlgorithm() : The number of threads must be greater than zero.");
+
+	if ( metric.type() == DistanceMetricType::Manhattan() and not (search.type() == SearchEngineType::Exact() or search.type() == SearchEngineType::Shards()) )
+		throw NessieException("KnnClassificationAlgorithm::KnnClassificationAlgorithm() : The Manhattan distance can only be used with an exact scan of the dataset.");
+
+	dataset_ = createDataset(engine);
+
+	try
+	{
+		matrix_.assign(*dataset_, metric);
+	}
+	catch (std::exception& e)
+	{
+		delete dataset_;
+
+		std::string message(e.what());
+		throw NessieException ("KnnClassificationAlgorithm::KnnClassificationAlgorithm() : The distance metric could not be applied to the dataset. " + message);
+	}
+
+	try
+	{
+		if ( search.type() == SearchEngineType::InvertedFile() )
+			index_ = new InvertedFileIndex (search.lists(), search.subquantizers(), search.probes());
+
+		if ( search.type() == SearchEngineType::Pivots() )
+			index_ = new PivotIndex (search.pivots());
+
+		if ( search.type() == SearchEngineType::ClassFilter() )
+			index_ = new ClassFilterIndex (search.classes(), search.exact());
+
+		if ( search.type() == SearchEngineType::Shards() )
+			buildShards(search.partitions());
+
+		// An index saved next to the dataset is only loaded if it was built over the same samples
+		if ( index_ != 0 )
+		{
+			std::string datasetFile = engine.filename().empty() ? engine.snapshot() : engine.filename();
+			if ( not datasetFile.empty() )
+				indexFile_ = datasetFile + ".index";
+
+			indexSaved_ = not indexFile_.empty() and index_->load(indexFile_, matrix_);
+			if ( not indexSaved_ )
+				index_->build(matrix_);
+		}
+	}
+	catch (std::exception& e)
+	{
+		delete index_;
+		delete dataset_;
+
+		std::string message(e.what());
+		throw NessieException ("KnnClassificationAlgorithm::KnnClassificationAlgorithm() : The search index could not be built. " + message);
+	}
 }
 
 
 KnnClassificationAlgorithm::~KnnClassificationAlgorithm ()
 {
+	// The index only saves time, so an index that cannot be saved is still valid
+	if ( index_ != 0 and not indexFile_.empty() and not indexSaved_ )
+	{
+		try
+		{
+			// The next program loads the dataset without the rows removed, so the index is saved over a matrix without them too
+			if ( matrix_.removedRows() > 0 )
+				purge();
+
+			index_->save(indexFile_, matrix_);
+		}
+		catch (...) {}
+	}
+
+	delete index_;
 	delete dataset_;
 }
 
 
 std::vector<std::string> KnnClassificationAlgorithm::classify (const std::vector<FeatureVector>& featureVectors) const
 {
+	return classify(featureVectors, geometries_);
+}
+
+
+std::vector<std::string> KnnClassificationAlgorithm::classify (const std::vector<FeatureVector>& featureVectors, const std::vector<GlyphGeometry>& geometries) const
+{
+	if ( featureVectors.empty() )
+		return std::vector<std::string>(0);
+
 	if ( dataset_->features() != featureVectors.begin()->size() )
 		throw NessieException ("KnnClassificationAlgorithm::classify() : The number of features stored in the dataset is different from the one expected by the program.");
 	
-	if ( dataset_->size() > 0 )
+	if ( matrix_.rows() > matrix_.removedRows() )
 	{
-		typedef std::pair<double, unsigned int> Neighbour;	// (distance, label)
-		
-		std::vector<std::string> characters(0);
-		characters.reserve(featureVectors.size());
-
-		for( unsigned int k = 0; k < featureVectors.size(); ++k )
+		// Gather every query into a single block padded to a whole number of query blocks
+		ClassificationJob job;
+		job.nQueries	= featureVectors.size();
+		job.nShards		= std::max(shards_.size(), static_cast<std::size_t>(1));
+		job.nextTask	= 0;
+		job.labels.assign(job.nQueries, 0);
+
+		if ( job.nShards > 1 )
+			job.found.assign(job.nShards * job.nQueries, NeighbourList(kNeighbours_));
+
+		// The geometry only gates the exact search, since an index decides on its own which samples are compared
+		job.gated		= index_ == 0 and not dataset_->geometry().empty() and geometries.size() == job.nQueries;
+		job.geometries	= &geometries;
+		if ( job.gated )
 		{
-			// Search the K nearest neighbours
-			std::multimap<double, unsigned int> kNearestNeighbours;
-
-			for( unsigned int i = 0; i < dataset_->size(); ++i )
+			for ( unsigned int i = 0; i < matrix_.rows(); ++i )
 			{
-				double distance	= featureVectors.at(k).computeEuclideanDistance(dataset_->at(i).first);
+				if ( matrix_.removed(i) )
+					continue;
 
-				if( kNearestNeighbours.size() < kNeighbours_ )
-					kNearestNeighbours.insert( Neighbour(distance, dataset_->at(i).second) );
-				else
-				{
-					std::multimap<double, unsigned int>::iterator j = kNearestNeighbours.upper_bound( distance );
+				if ( matrix_.label(i) >= job.present.size() )
+					job.present.resize(matrix_.label(i) + 1, 0);
 
-					if ( j != kNearestNeighbours.end() )
-					{
-						kNearestNeighbours.insert(j, Neighbour(distance, dataset_->at(i).second));
-						kNearestNeighbours.erase(j);
-					}
-				}
+				job.present[matrix_.label(i)] = 1;
 			}
-			
+		}
+		gated_ = job.gated;
 
-			if ( kNeighbours_ == 1 )
-				characters.push_back( dataset_->character(kNearestNeighbours.begin()->second) );
-			else
-			{
-				// Gather the class of the k nearest neighbours
-				std::map<unsigned int, unsigned int> classes;	// (label, appearances)
+		unsigned int blocks = (job.nQueries + SampleMatrix::queryBlock - 1) / SampleMatrix::queryBlock;
+		job.queries.assign(blocks * SampleMatrix::queryBlock * matrix_.stride(), 0.0);
 
-				for ( std::multimap<double, unsigned int>::iterator i = kNearestNeighbours.begin(); i != kNearestNeighbours.end(); ++i )
-				{
-					if ( classes.count(i->second) == 0 )
-						classes.insert( std::pair<unsigned int, unsigned int>(i->second, 1) );
-					else
-						classes[i->second]++;
-				}
+		std::vector<double> query(matrix_.stride(), 0.0);
+		for( unsigned int k = 0; k < job.nQueries; ++k )
+		{
+			matrix_.load(featureVectors.at(k), query);
+			std::copy(query.begin(), query.end(), job.queries.begin() + k * matrix_.stride());
+		}
 
-				// Get the most probably class
-				unsigned int label = classes.begin()->first;
-				for ( std::map<unsigned int, unsigned>::iterator i = classes.begin(); i != classes.end(); ++i )
-				{
-					if ( classes[label] < i->second )
-						label = i->first;
-				}
+		// Classify the chunks of queries, in parallel if there are enough of them
+		unsigned int chunks	= (job.nQueries + chunkSize - 1) / chunkSize;
+		threadsUsed_		= std::min(threads_, chunks * job.nShards);
+		std::vector<double> busyTimes(threadsUsed_, 0.0);
+		std::vector<long unsigned int> evaluations(threadsUsed_, 0);
+
+		boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+		if ( threadsUsed_ == 1 )
+			classifyChunks(job, busyTimes.front(), evaluations.front());
+		else
+		{
+			boost::thread_group workers;
+			for ( unsigned int i = 0; i < threadsUsed_; ++i )
+				workers.create_thread( boost::bind(&KnnClassificationAlgorithm::classifyChunks, this, boost::ref(job), boost::ref(busyTimes.at(i)), boost::ref(evaluations.at(i))) );
+
+			workers.join_all();
+		}
+
+		double elapsedTime = (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+		double busyTime = 0.0;
+		for ( std::vector<double>::const_iterator i = busyTimes.begin(); i != busyTimes.end(); ++i )
+			busyTime += *i;
+
+		concurrency_ = ( elapsedTime > 0.0 ) ? busyTime / elapsedTime : 1.0;
+
+		// Merge the neighbours found in every shard
+		if ( job.nShards > 1 )
+		{
+			NeighbourList neighbours(kNeighbours_);
+			for ( unsigned int k = 0; k < job.nQueries; ++k )
+			{
+				neighbours.clear();
+				for ( unsigned int s = 0; s < job.nShards; ++s )
+					neighbours.merge(job.found[s * job.nQueries + k]);
 
-				characters.push_back(dataset_->character(label));
+				job.labels[k] = vote(neighbours);
 			}
 		}
 
+		long unsigned int computedDistances = 0;
+		for ( std::vector<long unsigned int>::const_iterator i = evaluations.begin(); i != evaluations.end(); ++i )
+			computedDistances += *i;
+
+		avoidedDistances_ = static_cast<long unsigned int>(job.nQueries) * matrix_.rows() - computedDistances;
+
+		// Translate the labels into characters
+		std::vector<std::string> characters(0);
+		characters.reserve(job.nQueries);
+
+		for( unsigned int k = 0; k < job.nQueries; ++k )
+			characters.push_back( dataset_->character(job.labels.at(k)) );
+
 		return characters;
 	}
 	else
@@ -122,8 +262,10 @@ double KnnClassificationAlgorithm::train (const std::vector<FeatureVector>& feat
 	if ( dataset_->features() != featureVectors.begin()->size() )
 		throw NessieException ("KnnClassificationAlgorithm::train() : The number of features stored in the dataset is different from the one expected by the program.");
 
+	double storageTime = dataset_->storageTime();
 	unsigned int patternNo = 0;
 	double hits = 0.0;
+	bool withGeometry = geometries_.size() == featureVectors.size();
 
 	for ( std::vector<std::string>::const_iterator i = characters.begin(); i != characters.end(); ++i )
 	{
@@ -139,7 +281,12 @@ double KnnClassificationAlgorithm::train (const std::vector<FeatureVector>& feat
 				code = dataset_->code(referenceText.at(patternNo));
 
 			if ( code != 256 )
-				dataset_->addSample(Sample(featureVectors.at(patternNo), code));
+			{
+				addSample(featureVectors.at(patternNo), code);
+
+				if ( withGeometry )
+					dataset_->learnGeometry(code, geometries_.at(patternNo));
+			}
 		}
 		catch (std::exception& e)
 		{
@@ -153,6 +300,11 @@ double KnnClassificationAlgorithm::train (const std::vector<FeatureVector>& feat
 		++patternNo;
 	}
 
+	// A dataset that buffers the samples trained stores all of them at once
+	dataset_->flush();
+
+	storageTime_ = dataset_->storageTime() - storageTime;
+
 	return (hits / characters.size()) * 100;
 }
 
@@ -165,6 +317,7 @@ double KnnClassificationAlgorithm::train (const FeatureVector& featureVector, co
 	if ( dataset_->character(asciiCode).empty() )
 		throw NessieException ("KnnClassificationAlgorithm::train() : The ASCII code passed is invalid.");
 
+	double storageTime = dataset_->storageTime();
 	double hits = 0.0;
 
 	try
@@ -173,7 +326,10 @@ double KnnClassificationAlgorithm::train (const FeatureVector& featureVector, co
 			hits += 1.0;
 		
 		if ( asciiCode != 256 )
-			dataset_->addSample(Sample(featureVector, asciiCode));
+		{
+			addSample(featureVector, asciiCode);
+			dataset_->flush();
+		}
 	}
 	catch (std::exception& e)
 	{
@@ -181,5 +337,254 @@ double KnnClassificationAlgorithm::train (const FeatureVector& featureVector, co
 		throw NessieException ("KnnClassificationAlgorithm::train() : Training of character " + character + " could not be completed. " + message);
 	}
 
+	storageTime_ = dataset_->storageTime() - storageTime;
+
 	return (hits * 100);
 }
+
+
+void KnnClassificationAlgorithm::addSample (const FeatureVector& featureVector, const unsigned int& code)
+{
+	dataset_->addSample(Sample(featureVector, code));
+	matrix_.append(featureVector, code);
+
+	if ( index_ != 0 )
+	{
+		index_->append(matrix_, matrix_.rows() - 1);
+		indexSaved_ = false;
+	}
+}
+
+
+void KnnClassificationAlgorithm::removeSample (const unsigned int& n)
+{
+	if ( n >= matrix_.rows() or matrix_.removed(n) )
+		throw NessieException ("KnnClassificationAlgorithm::removeSample() : The row is beyond the matrix or it was already removed.");
+
+	dataset_->removeSample(n);
+	matrix_.remove(n);
+	indexSaved_ = false;
+
+	if ( index_ != 0 )
+		index_->remove(matrix_, n);
+
+	if ( dataset_->needsPurge() )
+		purge();
+
+	dataset_->flush();
+}
+
+
+unsigned int KnnClassificationAlgorithm::removeClass (const std::string& character)
+{
+	unsigned int code = dataset_->code(character);
+	if ( code == 256 )
+		throw NessieException ("KnnClassificationAlgorithm::removeClass() : The character " + character + " has no class in the dataset.");
+
+	unsigned int removed = 0;
+	for ( unsigned int i = 0; i < matrix_.rows(); ++i )
+	{
+		if ( matrix_.label(i) == code and not matrix_.removed(i) )
+		{
+			dataset_->removeSample(i);
+			matrix_.remove(i);
+			++removed;
+
+			if ( index_ != 0 )
+				index_->remove(matrix_, i);
+		}
+	}
+
+	if ( removed == 0 )
+		return 0;
+
+	indexSaved_ = false;
+
+	if ( dataset_->needsPurge() )
+		purge();
+
+	dataset_->flush();
+
+	return removed;
+}
+
+
+void KnnClassificationAlgorithm::purge ()
+{
+	std::vector<unsigned int> rows(0);
+
+	dataset_->purge();
+	matrix_.purge(rows);
+
+	if ( index_ != 0 )
+		index_->remap(matrix_, rows);
+
+	// Every shard begins at the first row left from the ones it began with
+	for ( std::vector<unsigned int>::iterator s = shards_.begin(); s != shards_.end(); ++s )
+	{
+		unsigned int first = *s;
+		while ( first < rows.size() and rows[first] == SampleMatrix::purgedRow )
+			++first;
+
+		*s = ( first < rows.size() ) ? rows[first] : matrix_.rows();
+	}
+
+	indexSaved_ = false;
+}
+
+
+void KnnClassificationAlgorithm::buildShards (const unsigned int& partitions)
+{
+	const ShardedDataset* sharded = dynamic_cast<const ShardedDataset*>(dataset_);
+
+	if ( partitions == 0 and sharded != 0 )
+	{
+		for ( unsigned int i = 0; i < sharded->shards(); ++i )
+			shards_.push_back(sharded->offset(i));
+	}
+	else
+	{
+		unsigned int n = std::max(partitions, 1u);
+		for ( unsigned int i = 0; i < n; ++i )
+			shards_.push_back(static_cast<unsigned int>(static_cast<long unsigned int>(matrix_.rows()) * i / n));
+	}
+}
+
+
+unsigned int KnnClassificationAlgorithm::vote (const NeighbourList& neighbours) const
+{
+	// No class has this code, so the query is left without a character
+	if ( neighbours.size() == 0 )
+		return 256;
+
+	unsigned int label			= matrix_.label(neighbours.row(0));
+	unsigned int appearances	= 0;
+
+	// The list is short, so counting the appearances of each label in place is cheaper than building a table
+	for ( unsigned int i = 0; i < neighbours.size(); ++i )
+	{
+		unsigned int candidate	= matrix_.label(neighbours.row(i));
+		unsigned int count		= 0;
+
+		for ( unsigned int j = 0; j < neighbours.size(); ++j )
+		{
+			if ( matrix_.label(neighbours.row(j)) == candidate )
+				++count;
+		}
+
+		if ( count > appearances or (count == appearances and candidate < label) )
+		{
+			label		= candidate;
+			appearances	= count;
+		}
+	}
+
+	return label;
+}
+
+
+void KnnClassificationAlgorithm::classifyChunks (ClassificationJob& job, double& busyTime, long unsigned int& evaluations) const
+{
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+	// Scratch space of this thread, reused by every chunk it takes
+	std::vector<NeighbourList> neighbours(chunkSize, NeighbourList(kNeighbours_));
+	std::vector<unsigned char> allowed(job.present.size(), 0);
+
+	while ( true )
+	{
+		unsigned int task;
+		{
+			boost::mutex::scoped_lock lock(job.mutex);
+			task = job.nextTask++;
+		}
+
+		// Consecutive tasks search the same chunk in different shards, so the chunks are finished in order
+		unsigned int first = (task / job.nShards) * chunkSize;
+		if ( first >= job.nQueries )
+			break;
+
+		unsigned int shard		= task % job.nShards;
+		unsigned int firstRow	= ( shards_.empty() ) ? 0 : shards_[shard];
+		unsigned int lastRow	= ( shard + 1 < shards_.size() ) ? shards_[shard + 1] : matrix_.rows();
+
+		unsigned int size = std::min(chunkSize, job.nQueries - first);
+		const double* queries = &job.queries[first * matrix_.stride()];
+
+		for ( unsigned int i = 0; i < size; ++i )
+			neighbours[i].clear();
+
+		// A few queries benefit more from early abandoning than from batching
+		if ( index_ != 0 )
+		{
+			for ( unsigned int i = 0; i < size; ++i )
+				evaluations += index_->search(matrix_, queries + i * matrix_.stride(), neighbours[i]);
+		}
+		else if ( job.gated )
+		{
+			for ( unsigned int i = 0; i < size; ++i )
+			{
+				// A query that no class admits is compared with every sample rather than left without neighbours
+				bool admitted = false;
+				for ( unsigned int label = 0; label < job.present.size(); ++label )
+				{
+					allowed[label] = job.present[label] and dataset_->geometry().admits(label, (*job.geometries)[first + i]);
+					admitted = admitted or allowed[label];
+				}
+
+				if ( not admitted )
+					allowed = job.present;
+
+				evaluations += matrix_.search(queries + i * matrix_.stride(), neighbours[i], firstRow, lastRow, allowed);
+			}
+		}
+		else if ( size < SampleMatrix::queryBlock )
+		{
+			for ( unsigned int i = 0; i < size; ++i )
+				matrix_.search(queries + i * matrix_.stride(), neighbours[i], firstRow, lastRow);
+		}
+		else
+			matrix_.search(queries, size, &neighbours[0], firstRow, lastRow);
+
+		if ( job.nShards > 1 )
+			std::copy(neighbours.begin(), neighbours.begin() + size, job.found.begin() + shard * job.nQueries + first);
+		else
+		{
+			for ( unsigned int i = 0; i < size; ++i )
+				job.labels[first + i] = vote(neighbours[i]);
+		}
+	}
+
+	busyTime = (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+}
+
+
+void KnnClassificationAlgorithm::updateStatistics (ClassifierStatistics& statistics) const
+{
+	if ( threadsUsed_ == 0 )
+		return;
+
+	statistics.classificationThreads(threadsUsed_);
+	statistics.concurrency(concurrency_);
+
+	if ( index_ != 0 or gated_ )
+		statistics.avoidedDistances(avoidedDistances_);
+}
+
+
+const FeatureProjection* KnnClassificationAlgorithm::projection () const
+{
+	return &dataset_->projection();
+}
+
+
+double KnnClassificationAlgorithm::storageTime () const
+{
+	return storageTime_;
+}
+
+
+void KnnClassificationAlgorithm::geometries (const std::vector<GlyphGeometry>& geometries)
+{
+	geometries_ = geometries;
+}
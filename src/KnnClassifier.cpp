@@ -10,10 +10,10 @@
 #include <boost/timer.hpp>
 
 
-KnnClassifier::KnnClassifier (const unsigned int& nNeighbours, DatasetEngine engine)
+KnnClassifier::KnnClassifier (const unsigned int& nNeighbours, DatasetEngine engine, const unsigned int& threads, SearchEngine search, DistanceMetric metric)
 :	Classifier()
 {
-	classificationAlgorithm_ = new KnnClassificationAlgorithm(nNeighbours, engine);
+	classificationAlgorithm_ = new KnnClassificationAlgorithm(nNeighbours, engine, threads, search, metric);
 }
 
 
@@ -31,6 +31,7 @@ std::vector<std::string> KnnClassifier::performClassification (const std::vector
 	std::vector<std::string> characters( classificationAlgorithm_->classify(featureVectors) );
 
 	statistics_.classificationTime(timer.elapsed());
+	classificationAlgorithm_->updateStatistics(statistics_);
 
 	return characters;
 }
@@ -48,6 +49,7 @@ void KnnClassifier::performTraining (const std::vector<FeatureVector>& featureVe
 
 	statistics_.hitRate(hitRate);
 	statistics_.missRate(100.0 - hitRate);
+	statistics_.storageTime(classificationAlgorithm_->storageTime());
 }
 
 
@@ -57,4 +59,5 @@ void KnnClassifier::performTraining (const FeatureVector& featureVector, const s
 
 	statistics_.hitRate(hitRate);
 	statistics_.missRate(100.0 - hitRate);
+	statistics_.storageTime(classificationAlgorithm_->storageTime());
 }
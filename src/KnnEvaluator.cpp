@@ -0,0 +1,260 @@
+/// @file
+/// @brief Definition of KnnEvaluator class
+
+#include "KnnEvaluator.hpp"
+#include "Dataset.hpp"
+#include "NeighbourList.hpp"
+#include "NessieException.hpp"
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <algorithm>
+
+
+struct KnnEvaluator::EvaluationJob
+{
+	std::vector<double>			queries;	///< Padded features of every query.
+
+	unsigned int				nQueries;	///< Number of queries.
+
+	std::vector<unsigned int>	labels;		///< Expected label of every query.
+
+	bool						leaveOneOut;	///< Whether every query is the row of the matrix with the same number, which must not vote.
+
+	std::vector<NeighbourList>	found;		///< Nearest neighbours of every query.
+
+	unsigned int				nextChunk;	///< Next chunk of queries waiting to be taken.
+
+	boost::mutex				mutex;		///< Lock that protects the chunk counter.
+};
+
+
+KnnEvaluator::KnnEvaluator (const Dataset& dataset, const unsigned int& threads)
+:	matrix_(dataset),
+	threads_(threads),
+	kMax_(0),
+	queries_(0),
+	hits_(0),
+	voteTimes_(0),
+	searchTime_(0.0),
+	threadsUsed_(0)
+{
+	if ( threads_ == 0 )
+		throw NessieException ("KnnEvaluator::KnnEvaluator() : The number of threads must be greater than zero.");
+}
+
+
+void KnnEvaluator::evaluate (const Dataset& queries, const unsigned int& kMax)
+{
+	if ( kMax == 0 )
+		throw NessieException ("KnnEvaluator::evaluate() : The number of neighbours must be greater than zero.");
+
+	if ( queries.features() != matrix_.features() )
+		throw NessieException ("KnnEvaluator::evaluate() : The number of features of the queries is different from the one of the reference samples.");
+
+	kMax_ = kMax;
+
+	EvaluationJob job;
+	job.nQueries	= queries.size();
+	job.leaveOneOut	= false;
+	job.labels.assign(job.nQueries, 0);
+
+	// Gather every query into a single block padded to a whole number of query blocks
+	unsigned int blocks = (job.nQueries + SampleMatrix::queryBlock - 1) / SampleMatrix::queryBlock;
+	job.queries.assign(static_cast<std::size_t>(blocks) * SampleMatrix::queryBlock * matrix_.stride(), 0.0);
+
+	std::vector<double> query(matrix_.stride(), 0.0);
+	for ( unsigned int i = 0; i < job.nQueries; ++i )
+	{
+		matrix_.load(queries.at(i).first, query);
+		std::copy(query.begin(), query.end(), job.queries.begin() + static_cast<std::size_t>(i) * matrix_.stride());
+		job.labels[i] = queries.at(i).second;
+	}
+
+	run(job);
+}
+
+
+void KnnEvaluator::leaveOneOut (const unsigned int& kMax)
+{
+	if ( kMax == 0 )
+		throw NessieException ("KnnEvaluator::leaveOneOut() : The number of neighbours must be greater than zero.");
+
+	kMax_ = kMax;
+
+	EvaluationJob job;
+	job.nQueries	= matrix_.rows();
+	job.leaveOneOut	= true;
+	job.labels.assign(job.nQueries, 0);
+
+	unsigned int blocks = (job.nQueries + SampleMatrix::queryBlock - 1) / SampleMatrix::queryBlock;
+	job.queries.assign(static_cast<std::size_t>(blocks) * SampleMatrix::queryBlock * matrix_.stride(), 0.0);
+
+	for ( unsigned int i = 0; i < job.nQueries; ++i )
+	{
+		std::copy(matrix_.row(i), matrix_.row(i) + matrix_.stride(), job.queries.begin() + static_cast<std::size_t>(i) * matrix_.stride());
+		job.labels[i] = matrix_.label(i);
+	}
+
+	run(job);
+}
+
+
+const unsigned int& KnnEvaluator::hits (const unsigned int& k) const
+{
+	if ( k == 0 or k > kMax_ )
+		throw NessieException ("KnnEvaluator::hits() : The number of neighbours requested has not been evaluated.");
+
+	return hits_[k-1];
+}
+
+
+double KnnEvaluator::accuracy (const unsigned int& k) const
+{
+	if ( queries_ == 0 )
+		return 0.0;
+
+	return (static_cast<double>(hits(k)) / queries_) * 100;
+}
+
+
+double KnnEvaluator::latency (const unsigned int& k) const
+{
+	if ( k == 0 or k > kMax_ )
+		throw NessieException ("KnnEvaluator::latency() : The number of neighbours requested has not been evaluated.");
+
+	if ( queries_ == 0 )
+		return 0.0;
+
+	return (searchTime_ + voteTimes_[k-1]) / queries_;
+}
+
+
+void KnnEvaluator::run (EvaluationJob& job)
+{
+	queries_ = job.nQueries;
+	hits_.assign(kMax_, 0);
+	voteTimes_.assign(kMax_, 0.0);
+	searchTime_		= 0.0;
+	threadsUsed_	= 0;
+
+	if ( job.nQueries == 0 )
+		return;
+
+	job.nextChunk = 0;
+	job.found.assign(job.nQueries, NeighbourList(kMax_));
+
+	// Search the neighbours of the chunks of queries, in parallel if there are enough of them
+	unsigned int chunks	= (job.nQueries + chunkSize - 1) / chunkSize;
+	threadsUsed_		= std::min(threads_, chunks);
+	std::vector<double> busyTimes(threadsUsed_, 0.0);
+
+	if ( threadsUsed_ == 1 )
+		searchChunks(job, busyTimes.front());
+	else
+	{
+		boost::thread_group workers;
+		for ( unsigned int i = 0; i < threadsUsed_; ++i )
+			workers.create_thread( boost::bind(&KnnEvaluator::searchChunks, this, boost::ref(job), boost::ref(busyTimes.at(i))) );
+
+		workers.join_all();
+	}
+
+	for ( std::vector<double>::const_iterator i = busyTimes.begin(); i != busyTimes.end(); ++i )
+		searchTime_ += *i;
+
+	// Every number of neighbours votes with the first ones of the same lists
+	for ( unsigned int k = 1; k <= kMax_; ++k )
+	{
+		boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+		unsigned int hits = 0;
+		for ( unsigned int i = 0; i < job.nQueries; ++i )
+		{
+			if ( job.found[i].size() > 0 and vote(job.found[i], k) == job.labels[i] )
+				++hits;
+		}
+
+		hits_[k-1]		= hits;
+		voteTimes_[k-1]	= (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+	}
+}
+
+
+void KnnEvaluator::searchChunks (EvaluationJob& job, double& busyTime) const
+{
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+	// A query of the dataset itself finds its own row too, so one more neighbour is needed to drop it
+	std::vector<NeighbourList> neighbours(chunkSize, NeighbourList(kMax_ + ( job.leaveOneOut ? 1 : 0 )));
+
+	while ( true )
+	{
+		unsigned int chunk;
+		{
+			boost::mutex::scoped_lock lock(job.mutex);
+			chunk = job.nextChunk++;
+		}
+
+		unsigned int first = chunk * chunkSize;
+		if ( first >= job.nQueries )
+			break;
+
+		unsigned int size = std::min(chunkSize, job.nQueries - first);
+		const double* queries = &job.queries[static_cast<std::size_t>(first) * matrix_.stride()];
+
+		for ( unsigned int i = 0; i < size; ++i )
+			neighbours[i].clear();
+
+		// Same choice of kernel as KnnClassificationAlgorithm, so that the distances compared are the same
+		if ( size < SampleMatrix::queryBlock )
+		{
+			for ( unsigned int i = 0; i < size; ++i )
+				matrix_.search(queries + i * matrix_.stride(), neighbours[i]);
+		}
+		else
+			matrix_.search(queries, size, &neighbours[0]);
+
+		for ( unsigned int i = 0; i < size; ++i )
+		{
+			NeighbourList& found = job.found[first + i];
+			found.clear();
+
+			for ( unsigned int j = 0; j < neighbours[i].size(); ++j )
+			{
+				if ( not job.leaveOneOut or neighbours[i].row(j) != first + i )
+					found.insert(neighbours[i].distance(j), neighbours[i].row(j));
+			}
+		}
+	}
+
+	busyTime = (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+}
+
+
+unsigned int KnnEvaluator::vote (const NeighbourList& neighbours, const unsigned int& k) const
+{
+	unsigned int voters			= std::min(k, neighbours.size());
+	unsigned int label			= matrix_.label(neighbours.row(0));
+	unsigned int appearances	= 0;
+
+	for ( unsigned int i = 0; i < voters; ++i )
+	{
+		unsigned int candidate	= matrix_.label(neighbours.row(i));
+		unsigned int count		= 0;
+
+		for ( unsigned int j = 0; j < voters; ++j )
+		{
+			if ( matrix_.label(neighbours.row(j)) == candidate )
+				++count;
+		}
+
+		if ( count > appearances or (count == appearances and candidate < label) )
+		{
+			label		= candidate;
+			appearances	= count;
+		}
+	}
+
+	return label;
+}
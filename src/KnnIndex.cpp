@@ -0,0 +1,102 @@
+/// @file
+/// @brief Definition of KnnIndex class
+
+#include "KnnIndex.hpp"
+#include "SampleMatrix.hpp"
+#include "BinaryDataset.hpp"
+#include "NessieException.hpp"
+#include <fstream>
+#include <cstdio>
+
+
+///	@brief	Identifier written at the beginning of an index file.
+static const char indexMagic[8] = {'N', 'e', 's', 's', 'i', 'e', 'I', 'X'};
+
+///	@brief	Version of the index file format.
+static const unsigned int indexVersion = 1;
+
+
+///	@brief	Positions of the fields of the header of an index file, which is followed by the content written by the index.
+enum IndexHeaderField
+{
+	versionField		= 8,
+	identifierField		= 12,
+	rowsField			= 16,
+	matrixField			= 20,
+	checksumField		= 24,
+	indexHeaderSize		= 28
+};
+
+
+KnnIndex::KnnIndex () {}
+
+KnnIndex::~KnnIndex () {}
+
+
+void KnnIndex::remove (const SampleMatrix&, const unsigned int&) {}
+
+
+void KnnIndex::save (const std::string& filename, const SampleMatrix& matrix) const
+{
+	std::string file(indexMagic, sizeof(indexMagic));
+	writeValue(file, indexVersion);
+	writeValue(file, identifier());
+	writeValue(file, matrix.rows());
+	writeValue(file, matrix.checksum());
+	writeValue(file, 0u);
+
+	write(file);
+
+	unsigned int checksum = BinaryDataset::checksum(file.data() + indexHeaderSize, file.size() - indexHeaderSize);
+	std::memcpy(&file[checksumField], &checksum, sizeof(checksum));
+
+	std::string temporaryFile(filename + ".tmp");
+	{
+		std::ofstream stream(temporaryFile.data(), std::ios::binary | std::ios::trunc);
+		if ( not stream.is_open() )
+			throw NessieException ("KnnIndex::save() : The file " + temporaryFile + " could not be created.");
+
+		stream.write(file.data(), file.size());
+
+		if ( not stream.good() )
+			throw NessieException ("KnnIndex::save() : The file " + temporaryFile + " could not be written.");
+	}
+
+	if ( std::rename(temporaryFile.data(), filename.data()) != 0 )
+		throw NessieException ("KnnIndex::save() : The file " + filename + " could not be replaced.");
+}
+
+
+bool KnnIndex::load (const std::string& filename, const SampleMatrix& matrix)
+{
+	std::ifstream stream(filename.data(), std::ios::binary | std::ios::ate);
+	if ( not stream.is_open() )
+		return false;
+
+	// The whole file is read at once, as the tables of an index take several megabytes
+	std::string file(static_cast<std::size_t>(stream.tellg()), '\0');
+	stream.seekg(0);
+	stream.read(&file[0], file.size());
+
+	if ( not stream.good() or file.size() < indexHeaderSize or std::memcmp(file.data(), indexMagic, sizeof(indexMagic)) != 0 )
+		return false;
+
+	const char* position	= file.data() + sizeof(indexMagic);
+	const char* end			= file.data() + file.size();
+
+	unsigned int version, kind, rows, content, checksum;
+	readValue(position, end, version);
+	readValue(position, end, kind);
+	readValue(position, end, rows);
+	readValue(position, end, content);
+	readValue(position, end, checksum);
+
+	// The checksum of the matrix is only computed once the cheaper fields have matched
+	if ( version != indexVersion or kind != identifier() or rows != matrix.rows() )
+		return false;
+
+	if ( checksum != BinaryDataset::checksum(position, end - position) or content != matrix.checksum() )
+		return false;
+
+	return read(position, end, matrix) and position == end;
+}
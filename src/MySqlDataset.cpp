@@ -4,30 +4,39 @@
 #include "MySqlDataset.hpp"
 #include "NessieException.hpp"
 #include <mysql++/mysql++.h>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <utility>
-#include <sstream>
 #include <exception>
+#include <cstdio>
 
 
-MySqlDataset::MySqlDataset (const std::string& database, const std::string& username, const std::string& password)
+MySqlDataset::MySqlDataset (const std::string& database, const std::string& username, const std::string& password, const unsigned int& batchSize)
 :	Dataset(),
 	database_(database),
 	username_(username),
 	password_(password),
+	connection_(0),
 	sampleIds_(0),
 	classIds_(),
-	featureColumns_()
+	featureColumns_(),
+	batchSize_(batchSize),
+	pending_(0),
+	removedIds_(0)
 {
+	if ( batchSize_ == 0 )
+		throw NessieException ("MySqlDataset::MySqlDataset() : The number of samples inserted at once must be greater than zero.");
+
 	try
 	{
-		mysqlpp::Connection connection (database_.data(), 0, username_.data(), password_.data());
-		mysqlpp::Transaction dbTransaction(connection);
+		connection_ = new mysqlpp::Connection (database_.data(), 0, username_.data(), password_.data());
+		mysqlpp::Transaction dbTransaction(*connection_);
 
-		// Get the number of features stored in the database
-		mysqlpp::Query query(&connection);
+		// Get the number of features stored in the database, in the order of the table
+		mysqlpp::Query query(connection_);
 		mysqlpp::StoreQueryResult registers = query.store("SELECT column_name\
 														FROM information_schema.columns\
-														WHERE table_name = 'samples' AND column_name LIKE 'm__'");
+														WHERE table_name = 'samples' AND column_name LIKE 'm__'\
+														ORDER BY ordinal_position");
 
 		if ( !registers )
 			throw NessieException ("The table 'samples' has not any feature column.");
@@ -88,7 +97,7 @@ MySqlDataset::MySqlDataset (const std::string& database, const std::string& user
 			++size_;
 		}
 
-		if ( connection.errnum() )
+		if ( connection_->errnum() )
 			throw NessieException ("The table 'samples' could not be accessed.");
 	}
 	catch (const std::exception& e)
@@ -99,13 +108,25 @@ MySqlDataset::MySqlDataset (const std::string& database, const std::string& user
 		classIds_.clear();
 		size_ = 0;
 
+		delete connection_;
+		connection_ = 0;
+
 		std::string message(e.what());
 		throw NessieException ("MySqlDataset::MySqlDataset() : The dataset could not be built from the database. " + message);
 	}
 }
 
 
-MySqlDataset::~MySqlDataset () {}
+MySqlDataset::~MySqlDataset ()
+{
+	try
+	{
+		flush();
+	}
+	catch (...) {}
+
+	delete connection_;
+}
 
 
 void MySqlDataset::addSample (const Sample& sample)
@@ -113,69 +134,140 @@ void MySqlDataset::addSample (const Sample& sample)
 	if ( sample.first.size() != features_ )
 		throw NessieException ("MySqlDataset::addSample() : The number of features in the sample is different from the one expected by the dataset.");
 
-	// Build the query section regarding the feature values
-	std::string featureValues;
-	for( unsigned int i = 0; i < sample.first.size(); ++i )
-	{
-		std::stringstream value;
-		value << sample.first.at(i);
-		featureValues.append(value.str() + ", ");
-	}
+	if ( classIds_.find(sample.second) == classIds_.end() )
+		throw NessieException ("MySqlDataset::addSample() : The class of the sample is not in the database.");
 
-	// Get the class ID and its ASCII code
-	std::stringstream idClass;
-	idClass << classIds_[sample.second];
+	samples_.push_back(sample);
+	size_ = samples_.size();
+	++pending_;
+}
 
-	try
-	{
-		mysqlpp::Connection connection (database_.data(), 0, username_.data(), password_.data());
-		mysqlpp::Transaction dbTransaction(connection);
 
-		mysqlpp::Query query(connection.query("INSERT INTO samples (id_sample, " + featureColumns_ + ", id_class) VALUES\
-											(DEFAULT, " + featureValues + idClass.str() + ")"));
-		mysqlpp::SimpleResult registers = query.execute();
+void MySqlDataset::removeSample (const unsigned int& n)
+{
+	if ( n >= size_ or removed(n) )
+		throw NessieException ("MySqlDataset::removeSample() : The row is beyond the size of the dataset or it was already removed.");
 
-		if ( !registers )
-			throw NessieException("");
+	// A sample that has not been inserted yet is only left out of the next flush
+	if ( n < sampleIds_.size() )
+		removedIds_.push_back(sampleIds_[n]);
 
-		samples_.push_back(sample);
-		sampleIds_.push_back(registers.insert_id());
-		size_ = samples_.size();
+	markRemoved(n);
+}
 
-		dbTransaction.commit();
-	}
-	catch (const std::exception& e)
-	{
-		std::string message(e.what());
-		throw NessieException ("MySqlDataset::addSample() : The sample could not be inserted in the dataset. " + message);
-	}
+
+void MySqlDataset::purge ()
+{
+	if ( removedSamples_ == 0 )
+		return;
+
+	// The samples not inserted yet have no id_sample, so only the ids of the ones inserted are dropped
+	purgeRows(sampleIds_);
+	Dataset::purge();
+
+	pending_ = size_ - sampleIds_.size();
 }
 
 
-void MySqlDataset::removeSample (const unsigned int& n)
+void MySqlDataset::flush ()
 {
+	if ( pending_ == 0 and removedIds_.empty() )
+		return;
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+	std::vector<unsigned int> newIds(0);
+	newIds.reserve(pending_);
+
 	try
 	{
-		std::stringstream id_sample;
-		id_sample << sampleIds_.at(n);
+		mysqlpp::Transaction dbTransaction(*connection_);
+		mysqlpp::Query query(connection_->query());
 
-		mysqlpp::Connection connection (database_.data(), 0, username_.data(), password_.data());
-		mysqlpp::Transaction dbTransaction(connection);
+		char field[32];
 
-		mysqlpp::Query query(connection.query("DELETE FROM samples WHERE id_sample = " + id_sample.str()));
-		if ( !query.exec() )
-			throw NessieException("");
+		if ( not removedIds_.empty() )
+		{
+			std::string ids;
+			for ( std::vector<unsigned int>::const_iterator i = removedIds_.begin(); i != removedIds_.end(); ++i )
+			{
+				int length = std::snprintf(field, sizeof(field), "%u,", *i);
+				ids.append(field, length);
+			}
+			ids.erase(ids.end() - 1);
+
+			if ( !query.exec("DELETE FROM samples WHERE id_sample IN (" + ids + ")") )
+				throw NessieException ("The samples removed could not be deleted.");
+		}
+
+		if ( pending_ > 0 )
+		{
+			// The new samples are numbered after the last one, whose row stays locked until the commit so that no other program takes the same keys
+			mysqlpp::StoreQueryResult registers = query.store("SELECT id_sample FROM samples ORDER BY id_sample DESC LIMIT 1 FOR UPDATE");
+			if ( !registers )
+				throw NessieException ("The last id_sample could not be retrieved from the database.");
+
+			unsigned int lastId = 0;
+			if ( registers.num_rows() > 0 )
+				lastId = registers[0][0];
+
+			const std::string prefix("INSERT INTO samples (id_sample, " + featureColumns_ + ", id_class) VALUES ");
+
+			std::string statement;
+			unsigned int batched = 0;
+			for ( unsigned int i = size_ - pending_; i < size_; ++i )
+			{
+				// A sample removed before it was inserted keeps no id_sample
+				if ( removed(i) )
+				{
+					newIds.push_back(0);
+					continue;
+				}
+
+				const Sample& sample = samples_[i];
+				newIds.push_back(++lastId);
+
+				statement.append( statement.empty() ? prefix : std::string(",") );
+
+				int length = std::snprintf(field, sizeof(field), "(%u", lastId);
+				statement.append(field, length);
+
+				for ( unsigned int j = 0; j < features_; ++j )
+				{
+					length = std::snprintf(field, sizeof(field), ",%.17g", sample.first[j]);
+					statement.append(field, length);
+				}
+
+				length = std::snprintf(field, sizeof(field), ",%u)", classIds_[sample.second]);
+				statement.append(field, length);
+
+				if ( ++batched == batchSize_ )
+				{
+					if ( !query.exec(statement) )
+						throw NessieException ("The new samples could not be inserted.");
+
+					statement.clear();
+					batched = 0;
+				}
+			}
+
+			if ( not statement.empty() and !query.exec(statement) )
+				throw NessieException ("The new samples could not be inserted.");
+		}
 
 		dbTransaction.commit();
 	}
 	catch (const std::exception& e)
 	{
+		storageTime_ += (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+
 		std::string message(e.what());
-		throw NessieException ("MySqlDataset::removeSample() : The sample could not be removed from the dataset. " + message);
+		throw NessieException ("MySqlDataset::flush() : The changes could not be written to the database. " + message);
 	}
 
-	samples_.erase(samples_.begin() + n);
-	sampleIds_.erase(sampleIds_.begin() + n);
-	size_ = samples_.size();
-}
+	sampleIds_.insert(sampleIds_.end(), newIds.begin(), newIds.end());
+	pending_ = 0;
+	removedIds_.clear();
 
+	storageTime_ += (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+}
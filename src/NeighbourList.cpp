@@ -0,0 +1,13 @@
+/// @file
+/// @brief Definition of NeighbourList class
+
+#include "NeighbourList.hpp"
+
+
+NeighbourList::NeighbourList (const unsigned int& k)
+:	distances_(k, 0.0),
+	rows_(k, 0),
+	capacity_(k),
+	size_(0),
+	bound_(std::numeric_limits<double>::infinity())
+{}
@@ -5,6 +5,7 @@
 #include "NessieException.hpp"
 #include "Pattern.hpp"
 #include "FeatureVector.hpp"
+#include "FeatureProjection.hpp"
 
 #include "PreprocessorStatistics.hpp"
 #include "FeatureExtractorStatistics.hpp"
@@ -40,7 +41,7 @@ const Text& NessieOcr::recognize (const Magick::Image& page, const unsigned int&
 		throw NessieException ("NessieOcr::train() : The classifier is set to a null value. Please, provide a valid classifier.");
 
 	doPreprocessing(page, x, y, height, width);
-	doFeatureExtraction();
+	doFeatureExtraction(classifier);
 	doClassification(classifier);
 	doPostprocessing();
 
@@ -54,7 +55,7 @@ void NessieOcr::train (const std::auto_ptr<Classifier>& classifier, const Magick
 		throw NessieException ("NessieOcr::train() : The classifier is set to a null value. Please, provide a valid classifier.");
 
 	doPreprocessing(page, x, y, height, width);
-	doFeatureExtraction();
+	doFeatureExtraction(classifier);
 	characters_ = classifier->performClassification(featureVectors_);
 
 	const boost::regex pattern("\\s*");
@@ -97,7 +98,7 @@ void NessieOcr::train (const std::auto_ptr<Classifier>& classifier, const Magick
 	patterns_.push_back(p);
 
 	// Extract features from the pattern
-	doFeatureExtraction();
+	doFeatureExtraction(classifier);
 
 	// Classify and train the pattern
 	characters_ = classifier->performClassification(featureVectors_);
@@ -158,12 +159,25 @@ void NessieOcr::doPreprocessing (const Magick::Image& page, const unsigned int&
 }
 
 
-void NessieOcr::doFeatureExtraction ()
+void NessieOcr::doFeatureExtraction (const std::auto_ptr<Classifier>& classifier)
 {
 	FeatureExtractor featureExtractor;
 	featureExtractor.computeMoments(patterns_);
+
+	const FeatureProjection* projection = classifier->projection();
+	if ( projection != 0 and not projection->empty() )
+		featureExtractor.project(*projection);
+
 	featureVectors_ = featureExtractor.featureVectors();
 
+	// The feature vectors do not keep the geometry of the regions, so it is passed to the classifier on its own
+	std::vector<GlyphGeometry> geometries(0);
+	geometries.reserve(patterns_.size());
+	for ( std::vector<Pattern>::const_iterator i = patterns_.begin(); i != patterns_.end(); ++i )
+		geometries.push_back(i->geometry());
+
+	classifier->geometries(geometries);
+
 	featureExtractionStatistics_.reset ( new FeatureExtractorStatistics(featureExtractor.statistics()) );
 }
 
@@ -11,7 +11,8 @@ Pattern::Pattern ()
 :	pixels_(std::vector<unsigned int>(Pattern::planeSize() * Pattern::planeSize(), 0)),
 	height_(Pattern::planeSize()),
 	width_(Pattern::planeSize()),
-	size_(Pattern::planeSize() * Pattern::planeSize())
+	size_(Pattern::planeSize() * Pattern::planeSize()),
+	geometry_()
 {}
 
 
@@ -0,0 +1,153 @@
+/// @file
+/// @brief Definition of PerceptronClassificationAlgorithm class
+
+#include "PerceptronClassificationAlgorithm.hpp"
+#include "DatasetEngine.hpp"
+#include "Dataset.hpp"
+#include "FeatureVector.hpp"
+#include "Text.hpp"
+#include "NessieException.hpp"
+#include <sstream>
+
+
+PerceptronClassificationAlgorithm::PerceptronClassificationAlgorithm (const std::string& model, DatasetEngine engine)
+:	ClassificationAlgorithm(),
+	dataset_(0),
+	model_(),
+	storageTime_(0.0)
+{
+	dataset_ = createDataset(engine);
+
+	try
+	{
+		model_.load(model);
+
+		if ( model_.features() != dataset_->features() )
+			throw NessieException ("The number of features of the model is different from the one of the dataset.");
+	}
+	catch (std::exception& e)
+	{
+		delete dataset_;
+
+		std::string message(e.what());
+		throw NessieException ("PerceptronClassificationAlgorithm::PerceptronClassificationAlgorithm() : The model could not be loaded. " + message);
+	}
+}
+
+
+PerceptronClassificationAlgorithm::~PerceptronClassificationAlgorithm ()
+{
+	delete dataset_;
+}
+
+
+std::vector<std::string> PerceptronClassificationAlgorithm::classify (const std::vector<FeatureVector>& featureVectors) const
+{
+	if ( featureVectors.empty() )
+		return std::vector<std::string>(0);
+
+	if ( model_.features() != featureVectors.begin()->size() )
+		throw NessieException ("PerceptronClassificationAlgorithm::classify() : The number of features of the model is different from the one expected by the program.");
+
+	std::vector<unsigned int> labels( model_.classify(featureVectors) );
+
+	std::vector<std::string> characters(0);
+	characters.reserve(labels.size());
+
+	for ( std::vector<unsigned int>::const_iterator i = labels.begin(); i != labels.end(); ++i )
+		characters.push_back( dataset_->character(*i) );
+
+	return characters;
+}
+
+
+double PerceptronClassificationAlgorithm::train (const std::vector<FeatureVector>& featureVectors, const std::vector<std::string>& characters, const Text& referenceText)
+{
+	if ( dataset_->features() != featureVectors.begin()->size() )
+		throw NessieException ("PerceptronClassificationAlgorithm::train() : The number of features stored in the dataset is different from the one expected by the program.");
+
+	double storageTime = dataset_->storageTime();
+	unsigned int patternNo = 0;
+	double hits = 0.0;
+
+	for ( std::vector<std::string>::const_iterator i = characters.begin(); i != characters.end(); ++i )
+	{
+		try
+		{
+			unsigned int code;
+			if ( *i == referenceText.at(patternNo) )
+			{
+				code = dataset_->code(*i);
+				hits += 1.0;
+			}
+			else
+				code = dataset_->code(referenceText.at(patternNo));
+
+			if ( code != 256 )
+				dataset_->addSample(Sample(featureVectors.at(patternNo), code));
+		}
+		catch (std::exception& e)
+		{
+			std::stringstream patternNoStr;
+			patternNoStr << patternNo;
+
+			std::string message(e.what());
+			throw NessieException ("PerceptronClassificationAlgorithm::train() : Training of sample " + patternNoStr.str() + " could not be completed. " + message);
+		}
+
+		++patternNo;
+	}
+
+	// A dataset that buffers the samples trained stores all of them at once
+	dataset_->flush();
+
+	storageTime_ = dataset_->storageTime() - storageTime;
+
+	return (hits / characters.size()) * 100;
+}
+
+
+double PerceptronClassificationAlgorithm::train (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode)
+{
+	if ( dataset_->features() != featureVector.size() )
+		throw NessieException ("PerceptronClassificationAlgorithm::train() : The number of features stored in the dataset is different from the one expected by the program.");
+
+	if ( dataset_->character(asciiCode).empty() )
+		throw NessieException ("PerceptronClassificationAlgorithm::train() : The ASCII code passed is invalid.");
+
+	double storageTime = dataset_->storageTime();
+	double hits = 0.0;
+
+	try
+	{
+		if ( dataset_->code(character) == asciiCode )
+			hits += 1.0;
+
+		if ( asciiCode != 256 )
+		{
+			dataset_->addSample(Sample(featureVector, asciiCode));
+			dataset_->flush();
+		}
+	}
+	catch (std::exception& e)
+	{
+		std::string message(e.what());
+		throw NessieException ("PerceptronClassificationAlgorithm::train() : Training of character " + character + " could not be completed. " + message);
+	}
+
+	storageTime_ = dataset_->storageTime() - storageTime;
+
+	return (hits * 100);
+}
+
+
+const FeatureProjection* PerceptronClassificationAlgorithm::projection () const
+{
+	return &dataset_->projection();
+}
+
+
+double PerceptronClassificationAlgorithm::storageTime () const
+{
+	return storageTime_;
+}
@@ -0,0 +1,63 @@
+/// @file
+/// @brief Definition of PerceptronClassifier class
+
+#include "PerceptronClassifier.hpp"
+#include "PerceptronClassificationAlgorithm.hpp"
+#include "Text.hpp"
+#include "DatasetEngine.hpp"
+#include "FeatureVector.hpp"
+#include "NessieException.hpp"
+#include <boost/timer.hpp>
+
+
+PerceptronClassifier::PerceptronClassifier (const std::string& model, DatasetEngine engine)
+:	Classifier()
+{
+	classificationAlgorithm_ = new PerceptronClassificationAlgorithm(model, engine);
+}
+
+
+PerceptronClassifier::~PerceptronClassifier ()
+{
+	delete classificationAlgorithm_;
+}
+
+
+std::vector<std::string> PerceptronClassifier::performClassification (const std::vector<FeatureVector>& featureVectors)
+{
+	boost::timer timer;
+	timer.restart();
+
+	std::vector<std::string> characters( classificationAlgorithm_->classify(featureVectors) );
+
+	statistics_.classificationTime(timer.elapsed());
+	classificationAlgorithm_->updateStatistics(statistics_);
+
+	return characters;
+}
+
+
+void PerceptronClassifier::performTraining (const std::vector<FeatureVector>& featureVectors, const std::vector<std::string>& characters, const Text& referenceText)
+{
+	if ( featureVectors.size() != characters.size() )
+		throw NessieException ("PerceptronClassifier::performTraining() : The number of feature vectors is different from the number of characters classified.");
+
+	if ( referenceText.size() != characters.size() )
+		throw NessieException ("PerceptronClassifier::performTraining() : The size of reference text is different from the number of characters classified.");
+
+	double hitRate = classificationAlgorithm_->train(featureVectors, characters, referenceText);
+
+	statistics_.hitRate(hitRate);
+	statistics_.missRate(100.0 - hitRate);
+	statistics_.storageTime(classificationAlgorithm_->storageTime());
+}
+
+
+void PerceptronClassifier::performTraining (const FeatureVector& featureVector, const std::string& character, const unsigned int& asciiCode)
+{
+	double hitRate = classificationAlgorithm_->train(featureVector, character, asciiCode);
+
+	statistics_.hitRate(hitRate);
+	statistics_.missRate(100.0 - hitRate);
+	statistics_.storageTime(classificationAlgorithm_->storageTime());
+}
@@ -0,0 +1,492 @@
+/// @file
+/// @brief Definition of PerceptronModel class
+
+#include "PerceptronModel.hpp"
+#include "Dataset.hpp"
+#include "FeatureVector.hpp"
+#include "NessieException.hpp"
+#include <fstream>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+///	@brief	Identifier written at the beginning of a model file.
+static const char modelMagic[8] = {'N', 'e', 's', 's', 'i', 'e', 'P', 'M'};
+
+///	@brief	Version of the model file format.
+static const unsigned int modelVersion = 1;
+
+///	@brief	Value written in a model file to detect a different byte order.
+static const unsigned int modelByteOrder = 0x01020304;
+
+///	@brief	Largest standardised feature that is represented without saturation, in standard deviations.
+static const double featureRange = 8.0;
+
+
+///	@brief	Linear congruential generator, so that training does not depend on the state of std::rand().
+class ModelRandom
+{
+	public:
+
+		explicit ModelRandom (const unsigned long& seed) : state_(seed) {};
+
+		///	@brief	Get a number uniformly distributed in [0, 1).
+		double uniform ()
+		{
+			state_ = (state_ * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+			return static_cast<double>(state_) / 2147483648.0;
+		};
+
+		///	@brief	Get an integer uniformly distributed in [0, n).
+		unsigned int below (const unsigned int& n)
+		{
+			return std::min(static_cast<unsigned int>(uniform() * n), n - 1);
+		};
+
+	private:
+
+		unsigned long state_;	///< State of the generator.
+};
+
+
+///	@brief	Write an array of values to a binary stream.
+template <typename T>
+static void writeValues (std::ofstream& file, const T* values, const std::size_t& n)
+{
+	if ( n > 0 )
+		file.write(reinterpret_cast<const char*>(values), n * sizeof(T));
+}
+
+
+///	@brief	Read an array of values from a binary stream.
+template <typename T>
+static void readValues (std::ifstream& file, T* values, const std::size_t& n)
+{
+	if ( n > 0 )
+		file.read(reinterpret_cast<char*>(values), n * sizeof(T));
+}
+
+
+PerceptronModel::PerceptronModel ()
+:	features_(0),
+	hidden_(0),
+	labels_(0),
+	means_(0),
+	scales_(0),
+	inputScale_(1.0f),
+	layers_(0)
+{}
+
+
+void PerceptronModel::train (const Dataset& dataset, const unsigned int& hidden, const unsigned int& epochs, const double& learningRate)
+{
+	// The rows removed from the dataset take no part in the training
+	std::vector<unsigned int> rows(0);
+	rows.reserve(dataset.size());
+	for ( unsigned int i = 0; i < dataset.size(); ++i )
+	{
+		if ( not dataset.removed(i) )
+			rows.push_back(i);
+	}
+
+	unsigned int nSamples	= rows.size();
+	unsigned int nFeatures	= dataset.features();
+
+	if ( nSamples == 0 or nFeatures == 0 )
+		throw NessieException ("PerceptronModel::train() : The dataset is empty.");
+
+	if ( nFeatures > maxInputs or hidden > maxInputs )
+		throw NessieException ("PerceptronModel::train() : The number of features or hidden units is too large.");
+
+	// Number the classes in ascending order of label
+	std::map<unsigned int, unsigned int> classIndex;
+	for ( unsigned int i = 0; i < nSamples; ++i )
+		classIndex[dataset.at(rows[i]).second] = 0;
+
+	std::vector<unsigned int> labels(0);
+	for ( std::map<unsigned int, unsigned int>::iterator c = classIndex.begin(); c != classIndex.end(); ++c )
+	{
+		c->second = labels.size();
+		labels.push_back(c->first);
+	}
+	unsigned int nClasses = labels.size();
+
+	// Standardise the features
+	std::vector<double> means(nFeatures, 0.0);
+	std::vector<double> deviations(nFeatures, 0.0);
+
+	for ( unsigned int i = 0; i < nSamples; ++i )
+	{
+		for ( unsigned int j = 0; j < nFeatures; ++j )
+			means[j] += dataset.at(rows[i]).first.at(j);
+	}
+	for ( unsigned int j = 0; j < nFeatures; ++j )
+		means[j] /= nSamples;
+
+	for ( unsigned int i = 0; i < nSamples; ++i )
+	{
+		for ( unsigned int j = 0; j < nFeatures; ++j )
+			deviations[j] += (dataset.at(rows[i]).first.at(j) - means[j]) * (dataset.at(rows[i]).first.at(j) - means[j]);
+	}
+
+	std::vector<float> featureMeans(nFeatures, 0.0f);
+	std::vector<float> featureScales(nFeatures, 1.0f);
+	for ( unsigned int j = 0; j < nFeatures; ++j )
+	{
+		double deviation = std::sqrt(deviations[j] / nSamples);
+
+		featureMeans[j]		= static_cast<float>(means[j]);
+		featureScales[j]	= static_cast<float>( deviation > 0.0 ? 1.0 / deviation : 1.0 );
+	}
+
+	std::vector<double> inputs(static_cast<std::size_t>(nSamples) * nFeatures, 0.0);
+	std::vector<unsigned int> targets(nSamples, 0);
+	double range = 0.0;
+
+	for ( unsigned int i = 0; i < nSamples; ++i )
+	{
+		for ( unsigned int j = 0; j < nFeatures; ++j )
+		{
+			double x = (static_cast<float>(dataset.at(rows[i]).first.at(j)) - featureMeans[j]) * featureScales[j];
+
+			inputs[static_cast<std::size_t>(i) * nFeatures + j] = x;
+			range = std::max(range, std::fabs(x));
+		}
+
+		targets[i] = classIndex[dataset.at(rows[i]).second];
+	}
+	range = std::min(range, featureRange);
+
+
+	// Initialise the weights with small random values scaled by the size of every layer
+	ModelRandom random(2026);
+	unsigned int firstOutputs = ( hidden > 0 ) ? hidden : nClasses;
+
+	std::vector<double> firstWeights(static_cast<std::size_t>(firstOutputs) * nFeatures, 0.0);
+	std::vector<double> firstBiases(firstOutputs, 0.0);
+	std::vector<double> secondWeights(static_cast<std::size_t>(nClasses) * hidden, 0.0);
+	std::vector<double> secondBiases(nClasses, 0.0);
+
+	double limit = std::sqrt(6.0 / (nFeatures + firstOutputs));
+	for ( std::vector<double>::iterator w = firstWeights.begin(); w != firstWeights.end(); ++w )
+		*w = limit * (2.0 * random.uniform() - 1.0);
+
+	limit = std::sqrt(6.0 / (hidden + nClasses));
+	for ( std::vector<double>::iterator w = secondWeights.begin(); w != secondWeights.end(); ++w )
+		*w = limit * (2.0 * random.uniform() - 1.0);
+
+
+	// Stochastic gradient descent on the softmax cross-entropy
+	std::vector<unsigned int> order(nSamples, 0);
+	for ( unsigned int i = 0; i < nSamples; ++i )
+		order[i] = i;
+
+	std::vector<double> activations(hidden, 0.0);
+	std::vector<double> activationErrors(hidden, 0.0);
+	std::vector<double> scores(nClasses, 0.0);
+
+	for ( unsigned int epoch = 0; epoch < epochs; ++epoch )
+	{
+		for ( unsigned int i = nSamples - 1; i > 0; --i )
+			std::swap(order[i], order[random.below(i + 1)]);
+
+		double rate = learningRate * (1.0 - 0.9 * epoch / epochs);
+
+		for ( std::vector<unsigned int>::const_iterator s = order.begin(); s != order.end(); ++s )
+		{
+			const double* x = &inputs[static_cast<std::size_t>(*s) * nFeatures];
+
+			// Forward pass
+			for ( unsigned int o = 0; o < firstOutputs; ++o )
+			{
+				const double* w = &firstWeights[static_cast<std::size_t>(o) * nFeatures];
+
+				double sum = firstBiases[o];
+				for ( unsigned int j = 0; j < nFeatures; ++j )
+					sum += w[j] * x[j];
+
+				if ( hidden > 0 )
+					activations[o] = std::max(sum, 0.0);
+				else
+					scores[o] = sum;
+			}
+
+			for ( unsigned int c = 0; hidden > 0 and c < nClasses; ++c )
+			{
+				const double* w = &secondWeights[static_cast<std::size_t>(c) * hidden];
+
+				double sum = secondBiases[c];
+				for ( unsigned int h = 0; h < hidden; ++h )
+					sum += w[h] * activations[h];
+
+				scores[c] = sum;
+			}
+
+			// Probabilities minus the expected ones are the errors of the scores
+			double highest = *std::max_element(scores.begin(), scores.end());
+			double total = 0.0;
+			for ( unsigned int c = 0; c < nClasses; ++c )
+			{
+				scores[c] = std::exp(scores[c] - highest);
+				total += scores[c];
+			}
+			for ( unsigned int c = 0; c < nClasses; ++c )
+				scores[c] = scores[c] / total - ( c == targets[*s] ? 1.0 : 0.0 );
+
+			// Backward pass
+			if ( hidden > 0 )
+			{
+				std::fill(activationErrors.begin(), activationErrors.end(), 0.0);
+
+				for ( unsigned int c = 0; c < nClasses; ++c )
+				{
+					double* w = &secondWeights[static_cast<std::size_t>(c) * hidden];
+					double step = rate * scores[c];
+
+					for ( unsigned int h = 0; h < hidden; ++h )
+					{
+						activationErrors[h] += w[h] * scores[c];
+						w[h] -= step * activations[h];
+					}
+					secondBiases[c] -= step;
+				}
+
+				for ( unsigned int h = 0; h < hidden; ++h )
+				{
+					if ( activations[h] <= 0.0 )
+						continue;
+
+					double* w = &firstWeights[static_cast<std::size_t>(h) * nFeatures];
+					double step = rate * activationErrors[h];
+
+					for ( unsigned int j = 0; j < nFeatures; ++j )
+						w[j] -= step * x[j];
+					firstBiases[h] -= step;
+				}
+			}
+			else
+			{
+				for ( unsigned int c = 0; c < nClasses; ++c )
+				{
+					double* w = &firstWeights[static_cast<std::size_t>(c) * nFeatures];
+					double step = rate * scores[c];
+
+					for ( unsigned int j = 0; j < nFeatures; ++j )
+						w[j] -= step * x[j];
+					firstBiases[c] -= step;
+				}
+			}
+		}
+	}
+
+
+	// Keep only the quantized model
+	features_	= nFeatures;
+	hidden_		= hidden;
+	labels_		= labels;
+	means_		= featureMeans;
+	scales_		= featureScales;
+	inputScale_	= static_cast<float>( range > 0.0 ? range / 32767.0 : 1.0 );
+
+	layers_.clear();
+	layers_.push_back( quantize(firstWeights, firstBiases, nFeatures) );
+	if ( hidden_ > 0 )
+		layers_.push_back( quantize(secondWeights, secondBiases, hidden_) );
+}
+
+
+std::vector<unsigned int> PerceptronModel::classify (const std::vector<FeatureVector>& featureVectors) const
+{
+	if ( layers_.empty() )
+		throw NessieException ("PerceptronModel::classify() : The model has not been trained or loaded.");
+
+	std::vector<unsigned int> labels(0);
+	labels.reserve(featureVectors.size());
+
+	// Scratch space reused by every feature vector
+	std::vector<short> input(features_, 0);
+	std::vector<short> hiddenInput(hidden_, 0);
+	std::vector<float> activations(hidden_, 0.0f);
+	std::vector<float> scores(labels_.size(), 0.0f);
+
+	for ( std::vector<FeatureVector>::const_iterator v = featureVectors.begin(); v != featureVectors.end(); ++v )
+	{
+		if ( v->size() != features_ )
+			throw NessieException ("PerceptronModel::classify() : The number of features of the model is different from the one of the feature vector.");
+
+		for ( unsigned int j = 0; j < features_; ++j )
+		{
+			float x = (static_cast<float>(v->at(j)) - means_[j]) * scales_[j] / inputScale_;
+			input[j] = static_cast<short>( std::floor(std::max(-32767.0f, std::min(32767.0f, x)) + 0.5f) );
+		}
+
+		if ( hidden_ > 0 )
+		{
+			evaluate(layers_[0], input, inputScale_, activations);
+
+			// Rectify the hidden units and quantize them with the largest one as the full range
+			float highest = 0.0f;
+			for ( unsigned int h = 0; h < hidden_; ++h )
+			{
+				activations[h] = std::max(activations[h], 0.0f);
+				highest = std::max(highest, activations[h]);
+			}
+
+			float hiddenScale = ( highest > 0.0f ) ? highest / 32767.0f : 1.0f;
+			for ( unsigned int h = 0; h < hidden_; ++h )
+				hiddenInput[h] = static_cast<short>( std::floor(activations[h] / hiddenScale + 0.5f) );
+
+			evaluate(layers_[1], hiddenInput, hiddenScale, scores);
+		}
+		else
+			evaluate(layers_[0], input, inputScale_, scores);
+
+		labels.push_back( labels_[std::max_element(scores.begin(), scores.end()) - scores.begin()] );
+	}
+
+	return labels;
+}
+
+
+void PerceptronModel::save (const std::string& filename) const
+{
+	if ( layers_.empty() )
+		throw NessieException ("PerceptronModel::save() : The model has not been trained or loaded.");
+
+	std::ofstream file(filename.data(), std::ios::binary | std::ios::trunc);
+	if ( not file.is_open() )
+		throw NessieException ("PerceptronModel::save() : The file " + filename + " could not be created.");
+
+	unsigned int classes = labels_.size();
+
+	file.write(modelMagic, sizeof(modelMagic));
+	writeValues(file, &modelVersion, 1);
+	writeValues(file, &modelByteOrder, 1);
+	writeValues(file, &features_, 1);
+	writeValues(file, &hidden_, 1);
+	writeValues(file, &classes, 1);
+	writeValues(file, &labels_[0], labels_.size());
+	writeValues(file, &means_[0], means_.size());
+	writeValues(file, &scales_[0], scales_.size());
+	writeValues(file, &inputScale_, 1);
+
+	for ( std::vector<Layer>::const_iterator layer = layers_.begin(); layer != layers_.end(); ++layer )
+	{
+		writeValues(file, &layer->scales[0], layer->scales.size());
+		writeValues(file, &layer->biases[0], layer->biases.size());
+		writeValues(file, &layer->weights[0], layer->weights.size());
+	}
+
+	if ( not file.good() )
+		throw NessieException ("PerceptronModel::save() : The file " + filename + " could not be written.");
+}
+
+
+void PerceptronModel::load (const std::string& filename)
+{
+	std::ifstream file(filename.data(), std::ios::binary);
+	if ( not file.is_open() )
+		throw NessieException ("PerceptronModel::load() : The file " + filename + " could not be opened.");
+
+	char magic[sizeof(modelMagic)];
+	unsigned int version = 0, byteOrder = 0, features = 0, hidden = 0, classes = 0;
+
+	file.read(magic, sizeof(magic));
+	readValues(file, &version, 1);
+	readValues(file, &byteOrder, 1);
+	readValues(file, &features, 1);
+	readValues(file, &hidden, 1);
+	readValues(file, &classes, 1);
+
+	if ( not file.good() or std::memcmp(magic, modelMagic, sizeof(magic)) != 0 or version != modelVersion )
+		throw NessieException ("PerceptronModel::load() : The file " + filename + " is not a valid model.");
+
+	if ( byteOrder != modelByteOrder )
+		throw NessieException ("PerceptronModel::load() : The file " + filename + " was written on a machine with a different byte order.");
+
+	if ( features == 0 or features > maxInputs or hidden > maxInputs or classes == 0 )
+		throw NessieException ("PerceptronModel::load() : The file " + filename + " is not a valid model.");
+
+	std::vector<unsigned int> labels(classes, 0);
+	std::vector<float> means(features, 0.0f);
+	std::vector<float> scales(features, 0.0f);
+	float inputScale = 0.0f;
+
+	readValues(file, &labels[0], labels.size());
+	readValues(file, &means[0], means.size());
+	readValues(file, &scales[0], scales.size());
+	readValues(file, &inputScale, 1);
+
+	std::vector<Layer> layers( hidden > 0 ? 2 : 1 );
+	for ( unsigned int l = 0; l < layers.size(); ++l )
+	{
+		Layer& layer	= layers[l];
+		layer.inputs	= ( l == 0 ) ? features : hidden;
+		layer.outputs	= ( l + 1 < layers.size() ) ? hidden : classes;
+		layer.scales.assign(layer.outputs, 0.0f);
+		layer.biases.assign(layer.outputs, 0.0f);
+		layer.weights.assign(static_cast<std::size_t>(layer.outputs) * layer.inputs, 0);
+
+		readValues(file, &layer.scales[0], layer.scales.size());
+		readValues(file, &layer.biases[0], layer.biases.size());
+		readValues(file, &layer.weights[0], layer.weights.size());
+	}
+
+	if ( not file.good() or file.peek() != std::char_traits<char>::eof() or not (inputScale > 0.0f) )
+		throw NessieException ("PerceptronModel::load() : The file " + filename + " is not a valid model.");
+
+	features_	= features;
+	hidden_		= hidden;
+	labels_		= labels;
+	means_		= means;
+	scales_		= scales;
+	inputScale_	= inputScale;
+	layers_		= layers;
+}
+
+
+PerceptronModel::Layer PerceptronModel::quantize (const std::vector<double>& weights, const std::vector<double>& biases, const unsigned int& inputs)
+{
+	Layer layer;
+	layer.inputs	= inputs;
+	layer.outputs	= biases.size();
+	layer.weights.assign(weights.size(), 0);
+	layer.scales.assign(layer.outputs, 1.0f);
+	layer.biases.assign(layer.outputs, 0.0f);
+
+	for ( unsigned int o = 0; o < layer.outputs; ++o )
+	{
+		const double* w = &weights[static_cast<std::size_t>(o) * inputs];
+
+		double highest = 0.0;
+		for ( unsigned int i = 0; i < inputs; ++i )
+			highest = std::max(highest, std::fabs(w[i]));
+
+		layer.scales[o] = static_cast<float>( highest > 0.0 ? highest / 127.0 : 1.0 );
+		layer.biases[o] = static_cast<float>(biases[o]);
+
+		for ( unsigned int i = 0; i < inputs; ++i )
+			layer.weights[static_cast<std::size_t>(o) * inputs + i] = static_cast<signed char>( std::floor(w[i] / layer.scales[o] + 0.5) );
+	}
+
+	return layer;
+}
+
+
+void PerceptronModel::evaluate (const Layer& layer, const std::vector<short>& input, const float& inputScale, std::vector<float>& output)
+{
+	const short* x = &input[0];
+
+	for ( unsigned int o = 0; o < layer.outputs; ++o )
+	{
+		const signed char* w = &layer.weights[static_cast<std::size_t>(o) * layer.inputs];
+
+		int sum = 0;
+		for ( unsigned int i = 0; i < layer.inputs; ++i )
+			sum += w[i] * x[i];
+
+		output[o] = sum * (layer.scales[o] * inputScale) + layer.biases[o];
+	}
+}
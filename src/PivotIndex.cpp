@@ -0,0 +1,227 @@
+/// @file
+/// @brief Definition of PivotIndex class
+
+#include "PivotIndex.hpp"
+#include "SampleMatrix.hpp"
+#include "NeighbourList.hpp"
+#include "NessieException.hpp"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+///	@brief	Largest number of pivots, so that the distances from a query to the pivots fit on the stack during a search.
+static const unsigned int maxPivots = 256;
+
+
+PivotIndex::PivotIndex (const unsigned int& pivots)
+:	KnnIndex(),
+	pivots_(pivots),
+	pivotRows_(0),
+	isPivot_(0),
+	table_(0)
+{
+	if ( pivots_ == 0 )
+		throw NessieException ("PivotIndex::PivotIndex() : The number of pivots must be greater than zero.");
+
+	if ( pivots_ > maxPivots )
+		throw NessieException ("PivotIndex::PivotIndex() : The number of pivots must not be greater than 256.");
+}
+
+
+PivotIndex::~PivotIndex () {}
+
+
+void PivotIndex::build (const SampleMatrix& matrix)
+{
+	pivotRows_.clear();
+	isPivot_.assign(matrix.rows(), false);
+	table_.clear();
+
+	unsigned int nRows		= matrix.rows();
+	unsigned int nPivots	= std::min(pivots_, nRows);
+	if ( nPivots == 0 )
+		return;
+
+	// Choose every pivot as the sample farthest from the pivots already chosen, starting from the first sample
+	std::vector<double> columns(static_cast<std::size_t>(nPivots) * nRows, 0.0);
+	std::vector<double> nearestPivot(nRows, std::numeric_limits<double>::infinity());
+
+	unsigned int pivot = 0;
+	for ( unsigned int p = 0; p < nPivots; ++p )
+	{
+		pivotRows_.push_back(pivot);
+		isPivot_[pivot] = true;
+
+		unsigned int farthest = 0;
+		for ( unsigned int i = 0; i < nRows; ++i )
+		{
+			double distance = std::sqrt( matrix.squaredDistance(matrix.row(pivot), i, std::numeric_limits<double>::infinity()) );
+			columns[static_cast<std::size_t>(p) * nRows + i] = distance;
+
+			nearestPivot[i] = std::min(nearestPivot[i], distance);
+			if ( nearestPivot[i] > nearestPivot[farthest] )
+				farthest = i;
+		}
+
+		pivot = farthest;
+	}
+
+	// Store the distances sample by sample, so that the lower bound of a sample reads a contiguous block
+	table_.resize(columns.size());
+	for ( unsigned int i = 0; i < nRows; ++i )
+	{
+		for ( unsigned int p = 0; p < nPivots; ++p )
+			table_[static_cast<std::size_t>(i) * nPivots + p] = columns[static_cast<std::size_t>(p) * nRows + i];
+	}
+}
+
+
+void PivotIndex::append (const SampleMatrix& matrix, const unsigned int& n)
+{
+	if ( not pivotRows_.empty() )
+		addRow(matrix, n);
+}
+
+
+unsigned int PivotIndex::search (const SampleMatrix& matrix, const double* query, NeighbourList& neighbours) const
+{
+	if ( pivotRows_.empty() )
+	{
+		matrix.search(query, neighbours);
+		return matrix.rows();
+	}
+
+	// Distances to the pivots, which are samples themselves
+	unsigned int nPivots = pivotRows_.size();
+	double queryDistances[maxPivots];
+
+	for ( unsigned int p = 0; p < nPivots; ++p )
+	{
+		double distance = matrix.squaredDistance(query, pivotRows_[p], std::numeric_limits<double>::infinity());
+		queryDistances[p] = std::sqrt(distance);
+
+		// A pivot removed from the matrix still bounds the distances, but it is not a neighbour
+		if ( not matrix.removed(pivotRows_[p]) )
+			neighbours.insert(distance, pivotRows_[p]);
+	}
+
+	// Skip every sample that is farther from some pivot than the worst neighbour kept allows. The radius is widened slightly so that the
+	// rounding of the square roots never prunes a sample lying exactly at the bound.
+	unsigned int evaluations	= nPivots;
+	double bound				= neighbours.bound();
+	double radius				= std::sqrt(bound) * (1.0 + 1e-9);
+
+	for ( unsigned int i = 0; i < matrix.rows(); ++i )
+	{
+		const double* distances = &table_[static_cast<std::size_t>(i) * nPivots];
+
+		unsigned int p = 0;
+		while ( p < nPivots and std::fabs(queryDistances[p] - distances[p]) <= radius )
+			++p;
+
+		if ( p < nPivots or isPivot_[i] or matrix.removed(i) )
+			continue;
+
+		double distance = matrix.squaredDistance(query, i, bound);
+		++evaluations;
+
+		if ( not (distance > bound) )
+		{
+			neighbours.insert(distance, i);
+			bound	= neighbours.bound();
+			radius	= std::sqrt(bound) * (1.0 + 1e-9);
+		}
+	}
+
+	return evaluations;
+}
+
+
+void PivotIndex::remap (const SampleMatrix& matrix, const std::vector<unsigned int>& rows)
+{
+	if ( pivotRows_.empty() )
+		return;
+
+	// A pivot purged cannot be compared with the queries any more, so its distances are dropped too
+	unsigned int nPivots = pivotRows_.size();
+	std::vector<unsigned int> kept(0);
+	for ( unsigned int p = 0; p < nPivots; ++p )
+	{
+		if ( rows[pivotRows_[p]] != SampleMatrix::purgedRow )
+			kept.push_back(p);
+	}
+
+	if ( kept.empty() )
+	{
+		build(matrix);
+		return;
+	}
+
+	std::vector<double> table(0);
+	table.reserve(static_cast<std::size_t>(matrix.rows()) * kept.size());
+	for ( unsigned int i = 0; i < rows.size(); ++i )
+	{
+		if ( rows[i] == SampleMatrix::purgedRow )
+			continue;
+
+		const double* distances = &table_[static_cast<std::size_t>(i) * nPivots];
+		for ( std::vector<unsigned int>::const_iterator p = kept.begin(); p != kept.end(); ++p )
+			table.push_back(distances[*p]);
+	}
+	table_.swap(table);
+
+	std::vector<unsigned int> pivotRows(0);
+	isPivot_.assign(matrix.rows(), false);
+	for ( std::vector<unsigned int>::const_iterator p = kept.begin(); p != kept.end(); ++p )
+	{
+		pivotRows.push_back(rows[pivotRows_[*p]]);
+		isPivot_[pivotRows.back()] = true;
+	}
+	pivotRows_.swap(pivotRows);
+}
+
+
+void PivotIndex::addRow (const SampleMatrix& matrix, const unsigned int& n)
+{
+	isPivot_.resize(matrix.rows(), false);
+
+	for ( std::vector<unsigned int>::const_iterator p = pivotRows_.begin(); p != pivotRows_.end(); ++p )
+		table_.push_back( std::sqrt(matrix.squaredDistance(matrix.row(*p), n, std::numeric_limits<double>::infinity())) );
+}
+
+
+unsigned int PivotIndex::identifier () const
+{
+	return 1;
+}
+
+
+void PivotIndex::write (std::string& buffer) const
+{
+	writeValue(buffer, pivots_);
+	writeArray(buffer, pivotRows_);
+	writeArray(buffer, table_);
+}
+
+
+bool PivotIndex::read (const char*& position, const char* end, const SampleMatrix& matrix)
+{
+	unsigned int pivots;
+	if ( not readValue(position, end, pivots) or pivots != pivots_ or not readArray(position, end, pivotRows_) or not readArray(position, end, table_) )
+		return false;
+
+	if ( pivotRows_.size() > pivots_ or table_.size() != static_cast<std::size_t>(matrix.rows()) * pivotRows_.size() )
+		return false;
+
+	isPivot_.assign(matrix.rows(), false);
+	for ( std::vector<unsigned int>::const_iterator p = pivotRows_.begin(); p != pivotRows_.end(); ++p )
+	{
+		if ( *p >= matrix.rows() )
+			return false;
+
+		isPivot_[*p] = true;
+	}
+
+	return true;
+}
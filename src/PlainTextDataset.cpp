@@ -6,12 +6,234 @@
 #include <utility>
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
 #include <sys/stat.h>
+#include <unistd.h>
+
+
+///	@brief	Number of bytes read from a dataset file at once.
+static const std::size_t readBlockSize = 1 << 20;
+
+///	@brief	Size of the journal, relative to the size of the file, beyond which the dataset is compacted on destruction.
+static const double compactRatio = 0.5;
+
+///	@brief	Exact powers of ten, which keep a decimal number with up to 15 significant digits correctly rounded.
+static const double exactPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+										  1e20, 1e21, 1e22};
+
+
+///	@brief	Check whether a character separates two fields of a sample.
+///
+///	@param	c	Character to check.
+///
+///	@return	True if the character is a blank other than a line break.
+static inline bool isBlank (const char& c)
+{
+	return c == ' ' or c == '\t' or c == '\r' or c == '\v' or c == '\f';
+}
+
+
+///	@brief	Check whether a character ends a field of a sample.
+///
+///	@param	c	Character to check.
+///
+///	@return	True if the character is a blank, a line break or the end of the text parsed.
+static inline bool endsField (const char& c)
+{
+	return isBlank(c) or c == '\n' or c == '\0';
+}
+
+
+///	@brief	Parse a floating point number.
+///
+///	@details	A number with up to 15 significant digits and a small exponent, like the ones written by PlainTextDataset, is the product or quotient
+///	of two numbers that doubles represent exactly, which gives the correctly rounded value. Any other number is left to std::strtod().
+///
+///	@param	begin	First character of the number, in a text that ends with a null character.
+///	@param	value	Number parsed.
+///
+///	@return	Pointer past the last character of the number, or a null pointer if it is not a valid number.
+static const char* parseNumber (const char* begin, double& value)
+{
+	const char* p = begin;
+
+	bool negative = ( *p == '-' );
+	if ( *p == '-' or *p == '+' )
+		++p;
+
+	double mantissa		= 0.0;
+	int digits			= 0;
+	int exponent		= 0;
+	bool any			= false;
+
+	for ( ; *p >= '0' and *p <= '9'; ++p, any = true )
+	{
+		if ( digits < 16 )
+			mantissa = mantissa * 10.0 + (*p - '0');
+		else
+			++exponent;
+
+		if ( mantissa > 0.0 )
+			++digits;
+	}
+
+	if ( *p == '.' )
+	{
+		for ( ++p; *p >= '0' and *p <= '9'; ++p, any = true )
+		{
+			if ( digits < 16 )
+			{
+				mantissa = mantissa * 10.0 + (*p - '0');
+				--exponent;
+			}
+
+			if ( mantissa > 0.0 )
+				++digits;
+		}
+	}
+
+	if ( not any )
+		return 0;
+
+	if ( *p == 'e' or *p == 'E' )
+	{
+		++p;
+
+		bool negativeExponent = ( *p == '-' );
+		if ( *p == '-' or *p == '+' )
+			++p;
+
+		if ( *p < '0' or *p > '9' )
+			return 0;
+
+		int power = 0;
+		for ( ; *p >= '0' and *p <= '9'; ++p )
+		{
+			if ( power < 10000 )
+				power = power * 10 + (*p - '0');
+		}
+
+		exponent += negativeExponent ? -power : power;
+	}
+
+	if ( not endsField(*p) )
+		return 0;
+
+	if ( digits <= 15 and exponent >= -22 and exponent <= 22 )
+		value = ( exponent < 0 ) ? mantissa / exactPowersOfTen[-exponent] : mantissa * exactPowersOfTen[exponent];
+	else
+	{
+		// Like the streams of the standard library, a number too large for a double is not valid
+		char* stop;
+		errno = 0;
+		value = std::strtod(begin, &stop);
+
+		return ( stop == p and not (errno == ERANGE and std::fabs(value) == HUGE_VAL) ) ? p : 0;
+	}
+
+	if ( negative )
+		value = -value;
+
+	return p;
+}
+
+
+///	@brief	Parse an unsigned integer.
+///
+///	@param	begin	First character of the number, in a text that ends with a null character.
+///	@param	value	Number parsed.
+///
+///	@return	Pointer past the last character of the number, or a null pointer if it is not a valid number.
+static const char* parseCode (const char* begin, unsigned int& value)
+{
+	const char* p = begin;
+	if ( *p == '+' )
+		++p;
+
+	if ( *p < '0' or *p > '9' )
+		return 0;
+
+	value = 0;
+	for ( ; *p >= '0' and *p <= '9'; ++p )
+		value = value * 10 + (*p - '0');
+
+	return endsField(*p) ? p : 0;
+}
+
+
+///	@brief	Parse the features and the class of a sample.
+///
+///	@param	begin	First character of the sample, in a text that ends with a null character.
+///	@param	sample	Sample whose feature vector already has the number of features to parse.
+///
+///	@return	Pointer past the class of the sample, or a null pointer if some field is not valid.
+static const char* parseFields (const char* begin, Sample& sample)
+{
+	const char* p = begin;
+	unsigned int features = sample.first.size();
+
+	for ( unsigned int i = 0; i <= features and p != 0; ++i )
+	{
+		while ( isBlank(*p) )
+			++p;
+
+		p = ( i < features ) ? parseNumber(p, sample.first[i]) : parseCode(p, sample.second);
+	}
+
+	return p;
+}
+
+
+///	@brief	Write the features and the class of a sample as text.
+///
+///	@details	Every feature is written with six significant digits, like the default precision of the streams of the standard library.
+///
+///	@param	sample	Sample to write.
+///	@param	text	Text where the sample is appended, without a line break.
+static void formatFields (const Sample& sample, std::string& text)
+{
+	char field[32];
+
+	for ( unsigned int i = 0; i < sample.first.size(); ++i )
+	{
+		int length = std::snprintf(field, sizeof(field), "%g ", sample.first[i]);
+		text.append(field, length);
+	}
+
+	int length = std::snprintf(field, sizeof(field), "%u", sample.second);
+	text.append(field, length);
+}
+
+
+///	@brief	Convert a number to text.
+///
+///	@param	n	Number to convert.
+///
+///	@return	The number as text.
+static std::string toString (const unsigned int& n)
+{
+	std::stringstream text;
+	text << n;
+
+	return text.str();
+}
 
 
 PlainTextDataset::PlainTextDataset (const std::string& filename)
 :	Dataset(),
-	filename_(filename)
+	filename_(filename),
+	generation_(0),
+	purgeDeferred_(false),
+	fileSize_(0),
+	journalSize_(0),
+	journalRepair_(false)
 {
 	// Open the samples input file
 	struct stat fileInfo;
@@ -23,57 +245,95 @@ PlainTextDataset::PlainTextDataset (const std::string& filename)
 	if ( not S_ISREG(fileInfo.st_mode) )
 		throw NessieException ("PlainTextDataset::PlainTextDataset() : File " + filename + " exists but it is not a regular file.");
 
-	std::ifstream inputFile( filename_.data() );
+	fileSize_ = fileInfo.st_size;
+
+	std::ifstream inputFile( filename_.data(), std::ios::binary );
 	if ( not inputFile.is_open() or not inputFile.good() )
 		throw NessieException ("PlainTextDataset::PlainTextDataset() : File " + filename + " could not be opened.");
 
-	// Read the number of features stored from file's first line
-	if ( (inputFile >> features_).fail() )
-		throw NessieException ("PlainTextDataset::PlainTextDataset() : The number of features read has not a valid format.");
-
-	if ( features_ == 0 )
-		throw NessieException ("PlainTextDataset::PlainTextDataset() : The number of features read is zero.");
+	// Read the file in large blocks, parsing only whole lines and carrying the rest of every block over to the next one
+	std::vector<char> buffer(readBlockSize + 1);
+	std::size_t carried		= 0;
+	unsigned int lineNo		= 1;
+	bool header				= true;
+	bool reserved			= false;
 
-	// Read every sample from the following lines
-	std::string line;
-	getline(inputFile, line);
-	unsigned int lineNo = 2;
-	while ( inputFile.good() )
+	while ( true )
 	{
-		if ( !line.empty() )
+		// A line longer than the buffer makes it grow
+		if ( carried == buffer.size() - 1 )
+			buffer.resize(2 * buffer.size() - 1);
+
+		inputFile.read(&buffer[carried], buffer.size() - 1 - carried);
+		std::size_t length	= carried + inputFile.gcount();
+		bool last			= not inputFile.good();
+
+		std::size_t parsed = length;
+		if ( not last )
 		{
-			std::stringstream lineStream(line);
-			
-			while ( !lineStream.eof() )
+			while ( parsed > 0 and buffer[parsed - 1] != '\n' )
+				--parsed;
+
+			if ( parsed == 0 )
 			{
-				FeatureVector features(features_);
-				for ( unsigned int i = 0; i < features_; ++i )
-				{
-					if ( (lineStream >> features.at(i)).fail() )
-					{
-						std::stringstream lineNoAsString;
-						lineNoAsString << lineNo;
-						throw NessieException ("PlainTextDataset::PlainTextDataset() : An invalid sample has been found at line " + lineNoAsString.str() + ".");
-					}
-				}
-			
-				unsigned int code;
-				if ( (lineStream >> code).fail() )
-				{
-					std::stringstream lineNoAsString;
-					lineNoAsString << lineNo;
-					throw NessieException ("PlainTextDataset::PlainTextDataset() : An invalid sample has been found at line " + lineNoAsString.str() + ".");
-				}
-			
-				samples_.push_back( Sample(features, code) );
-			} 
+				carried = length;
+				continue;
+			}
 		}
 
-		getline(inputFile, line);
-		++lineNo;
+		// The samples are parsed in place, so the dataset is reserved once from the density of lines of the first block
+		if ( not reserved )
+		{
+			std::size_t lines = std::count(buffer.begin(), buffer.begin() + parsed, '\n');
+			if ( last )
+				samples_.reserve(lines + 1);
+			else
+				samples_.reserve(static_cast<std::size_t>(static_cast<double>(fileInfo.st_size) / parsed * lines * 1.05));
+
+			reserved = true;
+		}
+
+		char following = buffer[parsed];
+		buffer[parsed] = '\0';
+		parseSamples(&buffer[0], &buffer[parsed], lineNo, header);
+		buffer[parsed] = following;
+
+		carried = length - parsed;
+		std::memmove(&buffer[0], &buffer[parsed], carried);
+
+		if ( last )
+			break;
 	}
 	inputFile.close();
+
+	if ( header )
+		throw NessieException ("PlainTextDataset::PlainTextDataset() : The number of features read has not a valid format.");
+
 	size_ = samples_.size();
+	replayJournal();
+
+	// The journal numbers the rows of its records after the purges it recorded, so the rows it left removed are purged before anything else.
+	// The purge is recorded along with the next change, so that a dataset only read never writes to the disk.
+	if ( removedSamples_ > 0 )
+	{
+		Dataset::purge();
+		purgeDeferred_ = true;
+	}
+
+	// Load the projection the samples were transformed with, if any
+	std::string projectionFile(filename_ + ".projection");
+	if ( stat(projectionFile.data(), &fileInfo) == 0 )
+	{
+		projection_.load(projectionFile);
+
+		if ( projection_.outputs() != features_ )
+			throw NessieException ("PlainTextDataset::PlainTextDataset() : The number of outputs of the projection " + projectionFile + " is different from the number of features.");
+	}
+
+	// Load the range of the geometry of every class, if any
+	std::string geometryFile(filename_ + ".geometry");
+	if ( stat(geometryFile.data(), &fileInfo) == 0 )
+		geometry_.load(geometryFile);
 
 	// Generate the character/code map
 	typedef std::pair<std::string, unsigned int> Register;
@@ -140,27 +400,81 @@ PlainTextDataset::~PlainTextDataset ()
 {
 	try
 	{
-		std::ofstream stream( filename_.data(), std::ios::trunc );
-		if ( not stream.is_open() or not stream.good() )
+		// The samples added or removed are already in the journal
+		if ( not geometry_.empty() )
+			geometry_.save(filename_ + ".geometry");
+	}
+	catch (...) {}
+
+	try
+	{
+		// Only a dataset that has changed compacts, so that a program that just reads the file never rewrites it
+		if ( journal_.is_open() and journalSize_ > compactRatio * fileSize_ )
+			compact();
+	}
+	catch (...) {}
+}
+
+
+void PlainTextDataset::parseSamples (const char* begin, const char* end, unsigned int& lineNo, bool& header)
+{
+	const char* p = begin;
+
+	// The number of features comes first, followed by the generation of the file if it has been compacted, and anything else in its line is ignored
+	if ( header )
+	{
+		while ( p < end and (isBlank(*p) or *p == '\n') )
 		{
-			stream.close();
-			return;
+			if ( *p == '\n' )
+				++lineNo;
+			++p;
 		}
 
-		stream << features_ << std::endl;
+		if ( p == end )
+			return;
 
-		for ( unsigned int i = 0; i < size_; ++i )
-		{
-			FeatureVector features	= samples_.at(i).first;
-			unsigned int code		= samples_.at(i).second;
+		p = parseCode(p, features_);
+		if ( p == 0 )
+			throw NessieException ("PlainTextDataset::PlainTextDataset() : The number of features read has not a valid format.");
+
+		if ( features_ == 0 )
+			throw NessieException ("PlainTextDataset::PlainTextDataset() : The number of features read is zero.");
+
+		while ( p < end and isBlank(*p) )
+			++p;
 
-			for ( unsigned int j = 0; j < features.size(); ++j )
-				stream << features.at(j) << " ";
+		if ( p < end and parseCode(p, generation_) == 0 )
+			generation_ = 0;
 
-			stream << code << std::endl;
+		p = static_cast<const char*>( std::memchr(p, '\n', end - p) );
+		if ( p == 0 )
+			p = end;
+
+		header = false;
+	}
+
+	while ( p < end )
+	{
+		if ( *p == '\n' )
+		{
+			++lineNo;
+			++p;
+			continue;
 		}
+
+		if ( isBlank(*p) )
+		{
+			++p;
+			continue;
+		}
+
+		// Every sample is parsed into its final place, and a line may hold several of them
+		samples_.push_back( Sample(FeatureVector(features_), 0) );
+
+		p = parseFields(p, samples_.back());
+		if ( p == 0 )
+			throw NessieException ("PlainTextDataset::PlainTextDataset() : An invalid sample has been found at line " + toString(lineNo) + ".");
 	}
-	catch (...) {}
 }
 
 
@@ -170,6 +484,12 @@ void PlainTextDataset::addSample (const Sample& sample)
 		throw NessieException ("PlainTextDataset::addSample() : The number of features in the sample is different from the one expected by the dataset.");
 	else
 	{
+		std::string record("+ ");
+		formatFields(sample, record);
+		record.push_back('\n');
+
+		appendRecord(record);
+
 		samples_.push_back(sample);
 		size_ = samples_.size();
 	}
@@ -178,7 +498,203 @@ void PlainTextDataset::addSample (const Sample& sample)
 
 void PlainTextDataset::removeSample (const unsigned int& n)
 {
-	samples_.erase(samples_.begin() + n);
-	size_ = samples_.size();
+	if ( n >= size_ or removed(n) )
+		throw NessieException ("PlainTextDataset::removeSample() : The row is beyond the size of the dataset or it was already removed.");
+
+	appendRecord("~ " + toString(n) + "\n");
+	markRemoved(n);
+}
+
+
+void PlainTextDataset::purge ()
+{
+	if ( removedSamples_ == 0 )
+		return;
+
+	appendRecord("*\n");
+	Dataset::purge();
+}
+
+
+void PlainTextDataset::appendRecord (const std::string& record)
+{
+	if ( not journal_.is_open() )
+	{
+		std::string journalFile(filename_ + ".journal");
+
+		// The bytes the replay left out are dropped before anything is appended after them
+		if ( journalRepair_ and truncate(journalFile.data(), journalSize_) != 0 )
+			throw NessieException ("PlainTextDataset::appendRecord() : The journal " + journalFile + " could not be repaired.");
+
+		journalRepair_ = false;
+
+		// A new journal starts telling the generation of the file it belongs to
+		bool created = ( journalSize_ == 0 );
+
+		journal_.clear();
+		journal_.open(journalFile.data(), std::ios::binary | std::ios::app);
+		if ( not journal_.is_open() )
+			throw NessieException ("PlainTextDataset::appendRecord() : The journal " + journalFile + " could not be opened.");
+
+		if ( created )
+		{
+			std::string header("= " + toString(generation_) + "\n");
+			journal_.write(header.data(), header.size());
+			journalSize_ = header.size();
+		}
+	}
+
+	// The purge made on load comes first, since the rows of the record are numbered after it
+	std::string text( purgeDeferred_ ? "*\n" + record : record );
+
+	// Every record reaches the file before the dataset changes, so an interrupted program loses nothing it was told to keep
+	journal_.write(text.data(), text.size());
+	journal_.flush();
+
+	if ( not journal_.good() )
+		throw NessieException ("PlainTextDataset::appendRecord() : The journal " + filename_ + ".journal could not be written.");
+
+	journalSize_	+= text.size();
+	purgeDeferred_	= false;
+}
+
+
+void PlainTextDataset::replayJournal ()
+{
+	std::string journalFile(filename_ + ".journal");
+
+	std::ifstream input(journalFile.data(), std::ios::binary);
+	if ( not input.is_open() )
+		return;
+
+	std::string journal;
+	struct stat fileInfo;
+	if ( stat(journalFile.data(), &fileInfo) == 0 )
+		journal.reserve(fileInfo.st_size);
+
+	journal.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+	input.close();
+
+	// A record without its line break was being written when the program stopped, so it is ignored, and only dropped from the file before the
+	// next record is appended
+	std::string::size_type complete = journal.rfind('\n');
+	complete = ( complete == std::string::npos ) ? 0 : complete + 1;
+
+	if ( complete < journal.size() )
+	{
+		journal.resize(complete);
+		journalRepair_ = true;
+	}
+
+	journalSize_ = journal.size();
+
+	if ( journal.empty() )
+		return;
+
+	// The first line tells the generation of the file the journal belongs to
+	const char* p = journal.c_str();
+	unsigned int generation;
+
+	if ( *p != '=' or (p = parseCode(p + 2, generation)) == 0 or *p != '\n' )
+		throw NessieException ("PlainTextDataset::replayJournal() : The journal " + journalFile + " has not a valid format.");
+
+	// A compaction that stopped after replacing the file leaves behind a journal that is already folded into it, which the next record replaces
+	if ( generation != generation_ )
+	{
+		journalSize_	= 0;
+		journalRepair_	= true;
+		return;
+	}
+
+	unsigned int lineNo = 2;
+	for ( ++p; *p != '\0'; ++p, ++lineNo )
+	{
+		char operation = *p;
+		const char* q = 0;
+
+		if ( operation == '+' and p[1] == ' ' )
+		{
+			samples_.push_back( Sample(FeatureVector(features_), 0) );
+			size_ = samples_.size();
+			q = parseFields(p + 2, samples_.back());
+		}
+		else if ( operation == '~' and p[1] == ' ' )
+		{
+			unsigned int n;
+			q = parseCode(p + 2, n);
+
+			if ( q != 0 and n < size_ and not removed(n) )
+				markRemoved(n);
+			else
+				q = 0;
+		}
+		else if ( operation == '*' )
+		{
+			Dataset::purge();
+			q = p + 1;
+		}
+
+		while ( q != 0 and isBlank(*q) )
+			++q;
+
+		if ( q == 0 or *q != '\n' )
+			throw NessieException ("PlainTextDataset::replayJournal() : An invalid record has been found at line " + toString(lineNo) + " of the journal " + journalFile + ".");
+
+		p = q;
+	}
+}
+
+
+void PlainTextDataset::compact ()
+{
+	std::string temporaryFile(filename_ + ".tmp");
+	std::size_t written = 0;
+	{
+		std::ofstream output(temporaryFile.data(), std::ios::binary | std::ios::trunc);
+		if ( not output.is_open() )
+			throw NessieException ("PlainTextDataset::compact() : The file " + temporaryFile + " could not be created.");
+
+		// The new generation tells a journal written before this compaction from one written after it
+		std::string text(toString(features_) + " " + toString(generation_ + 1) + "\n");
+		text.reserve(readBlockSize + 1024);
+
+		for ( unsigned int i = 0; i < size_; ++i )
+		{
+			if ( removed(i) )
+				continue;
+
+			formatFields(samples_[i], text);
+			text.push_back('\n');
+
+			if ( text.size() >= readBlockSize )
+			{
+				output.write(text.data(), text.size());
+				written += text.size();
+				text.clear();
+			}
+		}
+		output.write(text.data(), text.size());
+		written += text.size();
+
+		if ( not output.good() )
+			throw NessieException ("PlainTextDataset::compact() : The file " + temporaryFile + " could not be written.");
+	}
+
+	if ( std::rename(temporaryFile.data(), filename_.data()) != 0 )
+		throw NessieException ("PlainTextDataset::compact() : The file " + filename_ + " could not be replaced.");
+
+	++generation_;
+	fileSize_ = written;
+
+	if ( journal_.is_open() )
+		journal_.close();
+
+	std::remove((filename_ + ".journal").data());
+	journalSize_	= 0;
+	journalRepair_	= false;
+	purgeDeferred_	= false;
+
+	// The file has no rows removed now, and neither has the dataset
+	Dataset::purge();
 }
 
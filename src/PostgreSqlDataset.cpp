@@ -2,43 +2,165 @@
 ///	@brief	Definition of PostgreSqlDataset class
 
 #include "PostgreSqlDataset.hpp"
+#include "BinaryDataset.hpp"
 #include "NessieException.hpp"
 #include <pqxx/pqxx>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <utility>
-#include <sstream>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
 
 
-PostgreSqlDataset::PostgreSqlDataset (const std::string& database, const std::string& username, const std::string& password)
+///	@brief	Identifier written at the beginning of a snapshot file.
+static const char snapshotMagic[8] = {'N', 'e', 's', 's', 'i', 'e', 'S', 'N'};
+
+///	@brief	Version of the snapshot file format.
+static const unsigned int snapshotVersion = 1;
+
+///	@brief	Positions of the fields of the header of a snapshot file, which is followed by the names of the feature columns and then by the
+///			id_sample, the class and the features of every sample.
+enum SnapshotHeaderField
+{
+	versionField		= 8,
+	featuresField		= 12,
+	samplesField		= 16,
+	rowsField			= 20,
+	lastIdField			= 24,
+	columnsBytesField	= 28,
+	checksumField		= 32,
+	snapshotHeaderSize	= 36
+};
+
+
+///	@brief	Read an unsigned integer from any position of a buffer.
+///
+///	@param	bytes	First byte of the integer.
+///
+///	@return	The integer.
+static unsigned int readField (const char* bytes)
+{
+	unsigned int value;
+	std::memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+
+///	@brief	Append the bytes of a value to a buffer.
+///
+///	@param	buffer	Buffer to append to.
+///	@param	value	Value to append.
+template <typename T>
+static void appendField (std::string& buffer, const T& value)
+{
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+///	@brief	Stream the rows of a query over the samples table with COPY, decoding every row straight into the dataset.
+///
+///	@param	transaction	Transaction to run the query in.
+///	@param	query		Query that selects the id_sample, the features and the id_class of the samples, in this order.
+///	@param	features	Number of features of every sample.
+///	@param	asciiCodes	ASCII code of every id_class.
+///	@param	samples		Array the samples with a known class are appended to.
+///	@param	sampleIds	Array the id_sample of the samples appended is appended to.
+///	@param	lastId		Greatest id_sample read, which is updated with the rows of the query.
+///
+///	@return	Number of rows read, including the ones left out.
+static unsigned int copySamples (pqxx::work& transaction, const std::string& query, const unsigned int& features,
+								 const std::map<unsigned int, unsigned int>& asciiCodes, std::vector<Sample>& samples, std::vector<unsigned int>& sampleIds,
+								 unsigned int& lastId)
+{
+	// COPY takes a query in place of a table, so the rows are streamed in text form with no list of columns
+	std::vector<std::string> noColumns(0);
+	pqxx::tablereader reader(transaction, "(" + query + ")", noColumns.begin(), noColumns.end());
+
+	unsigned int rows = 0;
+	std::string line;
+	while ( reader.get_raw_line(line) )
+	{
+		samples.push_back( Sample(FeatureVector(features), 0) );
+		Sample& sample = samples.back();
+
+		char* field = const_cast<char*>(line.c_str());
+		unsigned int id_sample = std::strtoul(field, &field, 10);
+		if ( *field != '\t' )
+			throw NessieException ("The table 'samples' has an invalid id_sample column.");
+
+		++rows;
+		if ( id_sample > lastId )
+			lastId = id_sample;
+
+		for ( unsigned int j = 0; j < features; ++j )
+		{
+			char* begin = field + 1;
+			sample.first[j] = std::strtod(begin, &field);
+
+			if ( field == begin or *field != '\t' )
+				throw NessieException ("The table 'samples' has an invalid feature column.");
+		}
+
+		// Like the join of both tables, samples without a known class are left out
+		char* begin = field + 1;
+		std::map<unsigned int, unsigned int>::const_iterator code = asciiCodes.find(std::strtoul(begin, &field, 10));
+		if ( field == begin or *field != '\0' or code == asciiCodes.end() )
+		{
+			samples.pop_back();
+			continue;
+		}
+
+		sample.second = code->second;
+		sampleIds.push_back(id_sample);
+	}
+	reader.complete();
+
+	return rows;
+}
+
+
+PostgreSqlDataset::PostgreSqlDataset (const std::string& database, const std::string& username, const std::string& password, const std::string& snapshot)
 :	Dataset(),
 	database_(database),
 	username_(username),
 	password_(password),
+	connection_(0),
 	sampleIds_(0),
 	classIds_(),
-	featureColumns_()
+	columns_(0),
+	pending_(0),
+	removedIds_(0),
+	snapshot_(snapshot),
+	rows_(0),
+	lastId_(0),
+	snapshotOutdated_(false)
 {
 	try
 	{
-		pqxx::connection connection("dbname=" + database_ + " user=" + username_ + " password=" + password_);
-		pqxx::work dbTransaction(connection, "constructorTransaction");
+		connection_ = new pqxx::connection("dbname=" + database_ + " user=" + username_ + " password=" + password_);
+		pqxx::work dbTransaction(*connection_, "constructorTransaction");
 		
-		// Get the name of feature columns
+		// Get the name of feature columns, in the order of the table
 		pqxx::result registers = dbTransaction.exec("SELECT column_name\
 													FROM information_schema.columns\
-													WHERE table_name = 'samples' AND column_name LIKE 'm__'");
+													WHERE table_name = 'samples' AND column_name LIKE 'm__'\
+													ORDER BY ordinal_position");
 
 		if ( registers.empty() )
 			throw NessieException ("The table 'samples' has not any feature column.");
 		
+		columns_.push_back("id_sample");
 		for ( pqxx::result::const_iterator i = registers.begin(); i != registers.end(); ++i )
 		{
 			std::string column;
 			i->at(0).to(column);
 
-			featureColumns_.append(column + ",");
+			columns_.push_back(column);
 			++features_;
 		}
-		featureColumns_.erase(featureColumns_.end() - 1);
+		columns_.push_back("id_class");
 		
 
 		// Get the classes
@@ -46,6 +168,8 @@ PostgreSqlDataset::PostgreSqlDataset (const std::string& database, const std::st
 
 		typedef std::pair<std::string, unsigned int> asciiCodeRegister;
 		typedef std::pair<unsigned int, unsigned int> ClassIdRegister;
+
+		std::map<unsigned int, unsigned int> asciiCodes;
 		
 		for ( pqxx::result::const_iterator i = registers.begin(); i != registers.end(); ++i )
 		{
@@ -63,37 +187,65 @@ PostgreSqlDataset::PostgreSqlDataset (const std::string& database, const std::st
 
 			classes_.insert(asciiCodeRegister(label, asciiCode));
 			classIds_.insert(ClassIdRegister(asciiCode, idClass));
+			asciiCodes.insert(ClassIdRegister(idClass, asciiCode));
 		}
 
 
-		// Get the samples
-		registers = dbTransaction.exec("SELECT id_sample, " + featureColumns_ + ", asciiCode\
-										FROM samples s, classes c\
-										WHERE s.id_class = c.id_class");
-		size_ = registers.size();
-		samples_.reserve(size_);
-		sampleIds_.reserve(size_);
-		
-		for ( pqxx::result::const_iterator i = registers.begin(); i != registers.end(); ++i )
+		std::string columns(columns_.front());
+		for ( std::vector<std::string>::const_iterator i = columns_.begin() + 1; i != columns_.end(); ++i )
+			columns.append(", " + *i);
+
+		// Use the snapshot if the table has only grown since it was written, fetching just the rows added after it
+		bool loaded = false;
+		if ( not snapshot_.empty() and readSnapshot() )
 		{
-			unsigned int id_sample;
-			if ( !i->at(0).to(id_sample) )
-				throw NessieException ("The table 'samples' has an invalid id_sample column.");
+			registers = dbTransaction.exec("SELECT COALESCE(max(id_sample), 0), count(*) FROM samples");
 
-			unsigned int asciiCode;
-			if ( !i->at(i->size()-1).to(asciiCode) )
-				throw NessieException ("The table 'samples' has an invalid asciiCode column.");
+			unsigned int lastId, rows;
+			if ( !registers.front().at(0).to(lastId) or !registers.front().at(1).to(rows) )
+				throw NessieException ("The watermark of the table 'samples' could not be retrieved from the database.");
 
-			FeatureVector fv(features_);
-			for( unsigned int j = 0; j < features_; ++j )
+			if ( lastId > lastId_ )
 			{
-				if ( !i->at(j+1).to(fv.at(j)) )
-					throw NessieException ("The table 'samples' has an invalid feature column.");
+				char watermark[16];
+				std::snprintf(watermark, sizeof(watermark), "%u", lastId_);
+
+				rows_ += copySamples(dbTransaction, "SELECT " + columns + " FROM samples WHERE id_sample > " + std::string(watermark) + " ORDER BY id_sample",
+									 features_, asciiCodes, samples_, sampleIds_, lastId_);
+
+				lastId_				= lastId;
+				snapshotOutdated_	= true;
 			}
 
-			sampleIds_.push_back(id_sample);
-			samples_.push_back(Sample(fv, asciiCode));
+			// Rows removed from the table leave it with fewer rows than the snapshot plus the rows fetched
+			loaded = ( lastId == lastId_ and rows == rows_ );
+			if ( not loaded )
+			{
+				samples_.clear();
+				sampleIds_.clear();
+				rows_	= 0;
+				lastId_	= 0;
+			}
+		}
+
+		// Otherwise stream the whole table with COPY, decoding every row straight into the dataset
+		if ( not loaded )
+		{
+			registers = dbTransaction.exec("SELECT count(*) FROM samples");
+
+			unsigned int rows;
+			if ( !registers.front().at(0).to(rows) )
+				throw NessieException ("The number of samples could not be retrieved from the database.");
+
+			samples_.reserve(rows);
+			sampleIds_.reserve(rows);
+
+			rows_ = copySamples(dbTransaction, "SELECT " + columns + " FROM samples", features_, asciiCodes, samples_, sampleIds_, lastId_);
+
+			snapshotOutdated_ = not snapshot_.empty();
 		}
+
+		size_ = samples_.size();
 	}
 	catch (const std::exception& e)
 	{
@@ -103,13 +255,38 @@ PostgreSqlDataset::PostgreSqlDataset (const std::string& database, const std::st
 		classIds_.clear();
 		size_ = 0;
 
+		delete connection_;
+		connection_ = 0;
+
 		std::string message(e.what());
 		throw NessieException ("PostgreSqlDataset::PostgreSqlDataset() : The dataset could not be built from the database. " + message);
 	}
+
+	// The snapshot only saves time, so a dataset that cannot write it is still valid
+	if ( snapshotOutdated_ )
+	{
+		try
+		{
+			writeSnapshot();
+		}
+		catch (...) {}
+	}
 }
 
 
-PostgreSqlDataset::~PostgreSqlDataset () {}
+PostgreSqlDataset::~PostgreSqlDataset ()
+{
+	try
+	{
+		flush();
+
+		if ( snapshotOutdated_ )
+			writeSnapshot();
+	}
+	catch (...) {}
+
+	delete connection_;
+}
 
 
 void PostgreSqlDataset::addSample (const Sample& sample)
@@ -117,66 +294,252 @@ void PostgreSqlDataset::addSample (const Sample& sample)
 	if ( sample.first.size() != features_ )
 		throw NessieException ("PostgreSqlDataset::addSample() : The number of features in the sample is different from the one expected by the dataset.");
 
-	// Build the query section regarding the feature values
-	std::string featureValues;
-	for( unsigned int i = 0; i < sample.first.size(); ++i )
+	if ( classIds_.find(sample.second) == classIds_.end() )
+		throw NessieException ("PostgreSqlDataset::addSample() : The class of the sample is not in the database.");
+
+	samples_.push_back(sample);
+	size_ = samples_.size();
+	++pending_;
+}
+
+
+void PostgreSqlDataset::removeSample (const unsigned int& n)
+{
+	if ( n >= size_ or removed(n) )
+		throw NessieException ("PostgreSqlDataset::removeSample() : The row is beyond the size of the dataset or it was already removed.");
+
+	// A sample that has not been inserted yet is only left out of the next flush
+	if ( n < sampleIds_.size() )
+		removedIds_.push_back(sampleIds_[n]);
+
+	markRemoved(n);
+}
+
+
+void PostgreSqlDataset::purge ()
+{
+	if ( removedSamples_ == 0 )
+		return;
+
+	// The samples not inserted yet have no id_sample, so only the ids of the ones inserted are dropped
+	purgeRows(sampleIds_);
+	Dataset::purge();
+
+	pending_ = size_ - sampleIds_.size();
+}
+
+
+void PostgreSqlDataset::flush ()
+{
+	if ( pending_ == 0 and removedIds_.empty() )
+		return;
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+	// A sample removed before it was inserted is not inserted at all
+	unsigned int inserted = 0;
+	for ( unsigned int i = size_ - pending_; i < size_; ++i )
 	{
-		std::stringstream value;
-		value << sample.first.at(i);
-		featureValues.append(value.str() + ", ");
+		if ( not removed(i) )
+			++inserted;
 	}
-	
-	// Get the class ID and its ASCII code
-	std::stringstream idClass;
-	idClass << classIds_[sample.second];
-	
+
+	std::vector<unsigned int> newIds(0);
+	newIds.reserve(inserted);
+
 	try
 	{
-		pqxx::connection connection("dbname=" + database_ + " user=" + username_ + " password=" + password_);
-		pqxx::work dbTransaction(connection, "addSampleTransaction");
+		pqxx::work dbTransaction(*connection_, "flushTransaction");
 
-		pqxx::result registers = dbTransaction.exec("INSERT INTO samples (id_sample, " + featureColumns_ + ", id_class) VALUES\
-										(DEFAULT, " + featureValues + idClass.str() + ") RETURNING id_sample");
-		
-		unsigned int id_sample;
-		if ( !registers.front().at(0).to(id_sample) )
-			throw NessieException ("The new id_sample could not be retrieved from the database.");
+		char field[32];
+
+		if ( not removedIds_.empty() )
+		{
+			std::string ids;
+			for ( std::vector<unsigned int>::const_iterator i = removedIds_.begin(); i != removedIds_.end(); ++i )
+			{
+				int length = std::snprintf(field, sizeof(field), "%u,", *i);
+				ids.append(field, length);
+			}
+			ids.erase(ids.end() - 1);
+
+			dbTransaction.exec("DELETE FROM samples WHERE id_sample IN (" + ids + ")");
+		}
+
+		if ( inserted > 0 )
+		{
+			// COPY does not return the keys of the rows, so they are taken from the sequence of the table beforehand
+			std::snprintf(field, sizeof(field), "%u", inserted);
+			pqxx::result registers = dbTransaction.exec("SELECT nextval(pg_get_serial_sequence('samples', 'id_sample'))\
+														FROM generate_series(1, " + std::string(field) + ")");
+
+			for ( pqxx::result::const_iterator i = registers.begin(); i != registers.end(); ++i )
+			{
+				unsigned int id_sample;
+				if ( !i->at(0).to(id_sample) )
+					throw NessieException ("The new id_sample could not be retrieved from the database.");
+
+				newIds.push_back(id_sample);
+			}
+
+			pqxx::tablewriter writer(dbTransaction, "samples", columns_.begin(), columns_.end());
+
+			std::vector<std::string> row(features_ + 2);
+			for ( unsigned int i = size_ - pending_, k = 0; i < size_; ++i )
+			{
+				if ( removed(i) )
+					continue;
+
+				const Sample& sample = samples_[i];
+
+				std::snprintf(field, sizeof(field), "%u", newIds.at(k++));
+				row.front() = field;
+
+				for ( unsigned int j = 0; j < features_; ++j )
+				{
+					std::snprintf(field, sizeof(field), "%.17g", sample.first[j]);
+					row[j + 1] = field;
+				}
+
+				std::snprintf(field, sizeof(field), "%u", classIds_[sample.second]);
+				row.back() = field;
+
+				writer.insert(row);
+			}
+			writer.complete();
+		}
 
-		samples_.push_back(sample);
-		sampleIds_.push_back(id_sample);
-		size_ = samples_.size();
-		
 		dbTransaction.commit();
 	}
 	catch (const std::exception& e)
 	{
+		storageTime_ += (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+
 		std::string message(e.what());
-		throw NessieException ("PostgreSqlDataset::addSample() : The sample could not be inserted in the dataset. " + message);
+		throw NessieException ("PostgreSqlDataset::flush() : The changes could not be written to the database. " + message);
+	}
+
+	// The table is still in sync with the dataset, unless another program changed it meanwhile, which the next watermark will tell
+	rows_ = rows_ + newIds.size() - removedIds_.size();
+	if ( not newIds.empty() and newIds.back() > lastId_ )
+		lastId_ = newIds.back();
+	snapshotOutdated_ = not snapshot_.empty();
+
+	// A sample removed before it was inserted keeps no id_sample
+	for ( unsigned int i = size_ - pending_, k = 0; i < size_; ++i )
+		sampleIds_.push_back( removed(i) ? 0 : newIds[k++] );
+
+	pending_ = 0;
+	removedIds_.clear();
+
+	storageTime_ += (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+}
+
+
+bool PostgreSqlDataset::readSnapshot ()
+{
+	std::ifstream input(snapshot_.data(), std::ios::binary);
+	if ( not input.is_open() )
+		return false;
+
+	std::string file( (std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>() );
+	if ( file.size() < snapshotHeaderSize or std::memcmp(file.data(), snapshotMagic, sizeof(snapshotMagic)) != 0 )
+		return false;
+
+	const char* header = file.data();
+	unsigned int samples		= readField(header + samplesField);
+	unsigned int columnsBytes	= readField(header + columnsBytesField);
+
+	std::size_t sampleBytes = 2 * sizeof(unsigned int) + features_ * sizeof(double);
+	if ( readField(header + versionField) != snapshotVersion or readField(header + featuresField) != features_
+		 or file.size() != snapshotHeaderSize + columnsBytes + samples * sampleBytes )
+		return false;
+
+	if ( BinaryDataset::checksum(header + snapshotHeaderSize, file.size() - snapshotHeaderSize) != readField(header + checksumField) )
+		return false;
+
+	// A snapshot of a table whose feature columns have changed is of no use
+	std::string columns;
+	for ( std::vector<std::string>::const_iterator i = columns_.begin(); i != columns_.end(); ++i )
+		columns.append(*i + ",");
+
+	if ( columns != file.substr(snapshotHeaderSize, columnsBytes) )
+		return false;
+
+	samples_.reserve(samples);
+	sampleIds_.reserve(samples);
+
+	const char* sample = header + snapshotHeaderSize + columnsBytes;
+	for ( unsigned int i = 0; i < samples; ++i, sample += sampleBytes )
+	{
+		FeatureVector fv(features_);
+		for ( unsigned int j = 0; j < features_; ++j )
+			std::memcpy(&fv[j], sample + 2 * sizeof(unsigned int) + j * sizeof(double), sizeof(double));
+
+		sampleIds_.push_back(readField(sample));
+		samples_.push_back(Sample(fv, readField(sample + sizeof(unsigned int))));
 	}
+
+	rows_	= readField(header + rowsField);
+	lastId_	= readField(header + lastIdField);
+
+	return true;
 }
 
 
-void PostgreSqlDataset::removeSample (const unsigned int& n)
+void PostgreSqlDataset::writeSnapshot ()
 {
-	try
+	// Only the samples already inserted in the table, and not removed since, are part of its snapshot
+	unsigned int samples = 0;
+	for ( unsigned int i = 0; i < sampleIds_.size(); ++i )
 	{
-		std::stringstream id_sample;
-		id_sample << sampleIds_.at(n);
-		
-		pqxx::connection connection("dbname=" + database_ + " user=" + username_ + " password=" + password_);
-		pqxx::work dbTransaction(connection, "removeSampleTransaction");
-		
-		dbTransaction.exec("DELETE FROM samples WHERE id_sample = " + id_sample.str());
-		dbTransaction.commit();
+		if ( not removed(i) )
+			++samples;
 	}
-	catch (const std::exception& e)
+
+	std::string columns;
+	for ( std::vector<std::string>::const_iterator i = columns_.begin(); i != columns_.end(); ++i )
+		columns.append(*i + ",");
+
+	std::string file(snapshotMagic, sizeof(snapshotMagic));
+	file.reserve(snapshotHeaderSize + columns.size() + samples * (2 * sizeof(unsigned int) + features_ * sizeof(double)));
+
+	appendField(file, snapshotVersion);
+	appendField(file, features_);
+	appendField(file, samples);
+	appendField(file, rows_);
+	appendField(file, lastId_);
+	appendField(file, static_cast<unsigned int>(columns.size()));
+	appendField(file, 0u);
+	file.append(columns);
+
+	for ( unsigned int i = 0; i < sampleIds_.size(); ++i )
 	{
-		std::string message(e.what());
-		throw NessieException ("PostgreSqlDataset::removeSample() : The sample could not be removed from the dataset. " + message);
+		if ( removed(i) )
+			continue;
+
+		appendField(file, sampleIds_[i]);
+		appendField(file, samples_[i].second);
+		file.append(reinterpret_cast<const char*>(samples_[i].first.data()), features_ * sizeof(double));
 	}
 
-	samples_.erase(samples_.begin() + n);
-	sampleIds_.erase(sampleIds_.begin() + n);
-	size_ = samples_.size();
-}
+	unsigned int checksum = BinaryDataset::checksum(file.data() + snapshotHeaderSize, file.size() - snapshotHeaderSize);
+	std::memcpy(&file[checksumField], &checksum, sizeof(checksum));
+
+	std::string temporaryFile(snapshot_ + ".tmp");
+	{
+		std::ofstream output(temporaryFile.data(), std::ios::binary | std::ios::trunc);
+		if ( not output.is_open() )
+			throw NessieException ("PostgreSqlDataset::writeSnapshot() : The file " + temporaryFile + " could not be created.");
+
+		output.write(file.data(), file.size());
 
+		if ( not output.good() )
+			throw NessieException ("PostgreSqlDataset::writeSnapshot() : The file " + temporaryFile + " could not be written.");
+	}
+
+	if ( std::rename(temporaryFile.data(), snapshot_.data()) != 0 )
+		throw NessieException ("PostgreSqlDataset::writeSnapshot() : The file " + snapshot_ + " could not be replaced.");
+
+	snapshotOutdated_ = false;
+}
@@ -753,7 +753,10 @@ void Preprocessor::buildPatterns ()
 	for( RegionLines::iterator k = inlineRegions_.begin(); k != inlineRegions_.end(); ++k )
 	{
 		std::list<RegionIterator> line(k->second);
-		for( std::list<RegionIterator>::iterator i = line.begin(); i != line.end(); ++i )
+		std::vector<GlyphGeometry> geometries = measureGeometry(line);
+		std::vector<GlyphGeometry>::const_iterator geometry = geometries.begin();
+
+		for( std::list<RegionIterator>::iterator i = line.begin(); i != line.end(); ++i, ++geometry )
 		{
 			(*i)->normalizeCoordinates();
 
@@ -798,6 +801,7 @@ void Preprocessor::buildPatterns ()
 			
 			// Build the pattern
 			pattern.clean();
+			pattern.geometry(*geometry);
 			for ( unsigned int i = 0; i < normalizedRegion.size(); ++i )
 				pattern.at(normalizedRegion.at(i).first, normalizedRegion.at(i).second) = 1;
 
@@ -846,6 +850,42 @@ void Preprocessor::buildPatterns ()
 }
 
 
+std::vector<GlyphGeometry> Preprocessor::measureGeometry (const std::list<RegionIterator>& line) const
+{
+	if ( line.size() < 3 )
+		return std::vector<GlyphGeometry>(line.size(), GlyphGeometry());
+
+	std::vector<unsigned int> tops(0);
+	std::vector<unsigned int> bottoms(0);
+	for ( std::list<RegionIterator>::const_iterator i = line.begin(); i != line.end(); ++i )
+	{
+		tops.push_back((*i)->topBorderRow());
+		bottoms.push_back((*i)->bottomBorderRow());
+	}
+
+	std::nth_element(tops.begin(), tops.begin() + tops.size() / 2, tops.end());
+	std::nth_element(bottoms.begin(), bottoms.begin() + bottoms.size() / 2, bottoms.end());
+
+	double top		= tops.at(tops.size() / 2);
+	double baseline	= bottoms.at(bottoms.size() / 2);
+	double xHeight	= std::max(baseline - top + 1.0, 1.0);
+
+	std::vector<GlyphGeometry> geometries(0);
+	geometries.reserve(line.size());
+
+	for ( std::list<RegionIterator>::const_iterator i = line.begin(); i != line.end(); ++i )
+	{
+		double ascent		= (top - (*i)->topBorderRow()) / xHeight;
+		double descent		= ((*i)->bottomBorderRow() - baseline) / xHeight;
+		double aspectRatio	= static_cast<double>((*i)->height()) / std::max((*i)->width(), 1u);
+
+		geometries.push_back(GlyphGeometry(ascent, descent, aspectRatio));
+	}
+
+	return geometries;
+}
+
+
 void Preprocessor::skeletonizePatterns()
 {
 	boost::timer timer;
@@ -0,0 +1,341 @@
+/// @file
+/// @brief Definition of SampleMatrix class
+
+#include "SampleMatrix.hpp"
+#include "Dataset.hpp"
+#include "FeatureVector.hpp"
+#include "NeighbourList.hpp"
+#include "BinaryDataset.hpp"
+#include "NessieException.hpp"
+#include <algorithm>
+
+
+SampleMatrix::SampleMatrix ()
+:	data_(0),
+	labels_(0),
+	norms_(0),
+	removed_(0),
+	removedRows_(0),
+	rows_(0),
+	features_(0),
+	stride_(0),
+	metric_(DistanceMetric::Euclidean()),
+	transformation_(0)
+{}
+
+
+SampleMatrix::SampleMatrix (const Dataset& dataset, const DistanceMetric& metric)
+:	data_(0),
+	labels_(0),
+	norms_(0),
+	removed_(0),
+	removedRows_(0),
+	rows_(0),
+	features_(0),
+	stride_(0),
+	metric_(metric),
+	transformation_(0)
+{
+	assign(dataset, metric);
+}
+
+
+void SampleMatrix::assign (const Dataset& dataset, const DistanceMetric& metric)
+{
+	transformation_	= metric.transformation(dataset);
+	metric_			= metric;
+	features_		= dataset.features();
+	stride_			= ((features_ + lanes - 1) / lanes) * lanes;
+	rows_			= 0;
+
+	data_.clear();
+	labels_.clear();
+	norms_.clear();
+	removed_.clear();
+	removedRows_ = 0;
+	data_.reserve(static_cast<std::size_t>(dataset.size()) * stride_);
+	labels_.reserve(dataset.size());
+	norms_.reserve(dataset.size());
+	removed_.reserve(dataset.size());
+
+	// The rows removed from the dataset are kept as removed rows, so that both number their samples alike
+	for ( unsigned int i = 0; i < dataset.size(); ++i )
+	{
+		append(dataset.at(i).first, dataset.at(i).second);
+
+		if ( dataset.removed(i) )
+			remove(i);
+	}
+}
+
+
+void SampleMatrix::assign (const SampleMatrix& matrix, const std::vector<unsigned int>& rows)
+{
+	metric_			= matrix.metric_;
+	transformation_	= matrix.transformation_;
+	features_		= matrix.features_;
+	stride_			= matrix.stride_;
+	rows_			= 0;
+
+	data_.clear();
+	labels_.clear();
+	norms_.clear();
+	removed_.clear();
+	removedRows_ = 0;
+	data_.reserve(rows.size() * stride_);
+	labels_.reserve(rows.size());
+	norms_.reserve(rows.size());
+	removed_.reserve(rows.size());
+
+	for ( std::vector<unsigned int>::const_iterator i = rows.begin(); i != rows.end(); ++i )
+		append(matrix, *i);
+}
+
+
+void SampleMatrix::append (const SampleMatrix& matrix, const unsigned int& n)
+{
+	if ( matrix.features_ != features_ )
+		throw NessieException ("SampleMatrix::append() : The number of features in the sample is different from the one expected by the matrix.");
+
+	data_.insert(data_.end(), matrix.row(n), matrix.row(n) + stride_);
+	labels_.push_back(matrix.labels_[n]);
+	norms_.push_back(matrix.norms_[n]);
+	removed_.push_back(matrix.removed_[n]);
+	removedRows_ += matrix.removed_[n];
+	++rows_;
+}
+
+
+void SampleMatrix::append (const FeatureVector& features, const unsigned int& label)
+{
+	if ( features.size() != features_ )
+		throw NessieException ("SampleMatrix::append() : The number of features in the sample is different from the one expected by the matrix.");
+
+	data_.resize(data_.size() + stride_, 0.0);
+
+	double* row = &data_[static_cast<std::size_t>(rows_) * stride_];
+	transform(features, row);
+
+	labels_.push_back(label);
+	norms_.push_back(dotProduct(row, row));
+	removed_.push_back(0);
+	++rows_;
+}
+
+
+void SampleMatrix::remove (const unsigned int& n)
+{
+	if ( n >= rows_ or removed_[n] )
+		throw NessieException ("SampleMatrix::remove() : The row is beyond the matrix or it was already removed.");
+
+	removed_[n] = 1;
+	++removedRows_;
+}
+
+
+void SampleMatrix::purge (std::vector<unsigned int>& rows)
+{
+	rows.assign(rows_, purgedRow);
+
+	unsigned int kept = 0;
+	for ( unsigned int i = 0; i < rows_; ++i )
+	{
+		if ( removed_[i] )
+			continue;
+
+		if ( kept != i )
+		{
+			std::copy(row(i), row(i) + stride_, data_.begin() + static_cast<std::size_t>(kept) * stride_);
+			labels_[kept]	= labels_[i];
+			norms_[kept]	= norms_[i];
+		}
+
+		rows[i] = kept++;
+	}
+
+	rows_ = kept;
+	data_.resize(static_cast<std::size_t>(rows_) * stride_);
+	labels_.resize(rows_);
+	norms_.resize(rows_);
+	removed_.assign(rows_, 0);
+	removedRows_ = 0;
+}
+
+
+void SampleMatrix::load (const FeatureVector& featureVector, std::vector<double>& buffer) const
+{
+	if ( featureVector.size() != features_ )
+		throw NessieException ("SampleMatrix::load() : The number of features in the query is different from the one expected by the matrix.");
+
+	buffer.assign(stride_, 0.0);
+	transform(featureVector, &buffer[0]);
+}
+
+
+unsigned int SampleMatrix::checksum () const
+{
+	unsigned int hash = BinaryDataset::checksum(reinterpret_cast<const char*>(&stride_), sizeof(stride_));
+	if ( rows_ == 0 )
+		return hash;
+
+	hash = BinaryDataset::checksum(reinterpret_cast<const char*>(&data_[0]), static_cast<std::size_t>(rows_) * stride_ * sizeof(double), hash);
+	return BinaryDataset::checksum(reinterpret_cast<const char*>(&labels_[0]), rows_ * sizeof(unsigned int), hash);
+}
+
+
+void SampleMatrix::search (const double* query, NeighbourList& neighbours) const
+{
+	search(query, neighbours, 0, rows_);
+}
+
+
+void SampleMatrix::search (const double* query, NeighbourList& neighbours, const unsigned int& first, const unsigned int& last) const
+{
+	dispatch(query, neighbours, first, last, 0);
+}
+
+
+unsigned int SampleMatrix::search (const double* query, NeighbourList& neighbours, const unsigned int& first, const unsigned int& last,
+								   const std::vector<unsigned char>& allowed) const
+{
+	return dispatch(query, neighbours, first, last, &allowed);
+}
+
+
+void SampleMatrix::search (const double* queries, const unsigned int& nQueries, NeighbourList* neighbours) const
+{
+	search(queries, nQueries, neighbours, 0, rows_);
+}
+
+
+void SampleMatrix::search (const double* queries, const unsigned int& nQueries, NeighbourList* neighbours, const unsigned int& first, const unsigned int& last) const
+{
+	// The expansion of the distance only holds for the Euclidean distance, so the Manhattan distance scans once per query
+	if ( metric_.type() == DistanceMetricType::Manhattan() )
+	{
+		for ( unsigned int q = 0; q < nQueries; ++q )
+			dispatch(queries + static_cast<std::size_t>(q) * stride_, neighbours[q], first, last, 0);
+	}
+	else if ( stride_ == fixedStride )
+		scanBatch<fixedStride>(queries, nQueries, neighbours, first, last);
+	else
+		scanBatch<0>(queries, nQueries, neighbours, first, last);
+}
+
+
+void SampleMatrix::transform (const FeatureVector& featureVector, double* row) const
+{
+	if ( transformation_.empty() )
+	{
+		for ( unsigned int i = 0; i < features_; ++i )
+			row[i] = featureVector[i];
+
+		return;
+	}
+
+	for ( unsigned int i = 0; i < features_; ++i )
+	{
+		const double* coefficients = &transformation_[static_cast<std::size_t>(i) * features_];
+
+		double sum = 0.0;
+		for ( unsigned int j = 0; j <= i; ++j )
+			sum += coefficients[j] * featureVector[j];
+
+		row[i] = sum;
+	}
+}
+
+
+unsigned int SampleMatrix::dispatch (const double* query, NeighbourList& neighbours, const unsigned int& first, const unsigned int& last,
+									 const std::vector<unsigned char>* allowed) const
+{
+	if ( metric_.type() == DistanceMetricType::Manhattan() )
+	{
+		if ( stride_ == fixedStride )
+			return scan<AbsoluteDifference, fixedStride>(query, neighbours, first, last, allowed);
+		else
+			return scan<AbsoluteDifference, 0>(query, neighbours, first, last, allowed);
+	}
+
+	if ( stride_ == fixedStride )
+		return scan<SquaredDifference, fixedStride>(query, neighbours, first, last, allowed);
+	else
+		return scan<SquaredDifference, 0>(query, neighbours, first, last, allowed);
+}
+
+
+template <class Term, unsigned int Stride>
+unsigned int SampleMatrix::scan (const double* query, NeighbourList& neighbours, const unsigned int& first, const unsigned int& last,
+								 const std::vector<unsigned char>* allowed) const
+{
+	double bound = neighbours.bound();
+	unsigned int evaluations = 0;
+
+	for ( unsigned int i = first; i < last; ++i )
+	{
+		if ( removed(i) or (allowed != 0 and (labels_[i] >= allowed->size() or not (*allowed)[labels_[i]])) )
+			continue;
+
+		double distance = this->distance<Term, Stride>(query, row(i), bound);
+		++evaluations;
+
+		if ( distance < bound )
+		{
+			neighbours.insert(distance, i);
+			bound = neighbours.bound();
+		}
+	}
+
+	return evaluations;
+}
+
+
+template <unsigned int Stride>
+void SampleMatrix::scanBatch (const double* queries, const unsigned int& nQueries, NeighbourList* neighbours, const unsigned int& first, const unsigned int& last) const
+{
+	const unsigned int stride = ( Stride > 0 ) ? Stride : stride_;
+
+	// Every block of rows is reused by all the queries while it is still in cache
+	for ( unsigned int firstRow = first; firstRow < last; firstRow += rowBlock )
+	{
+		unsigned int lastRow = std::min(last, firstRow + rowBlock);
+
+		for ( unsigned int firstQuery = 0; firstQuery < nQueries; firstQuery += queryBlock )
+		{
+			unsigned int lastQuery = std::min(nQueries, firstQuery + queryBlock);
+			const double* query = queries + static_cast<std::size_t>(firstQuery) * stride_;
+
+			double queryNorms[queryBlock];
+			for ( unsigned int q = 0; q < queryBlock; ++q )
+				queryNorms[q] = dotProduct(query + q * stride_, query + q * stride_);
+
+			for ( unsigned int i = firstRow; i < lastRow; ++i )
+			{
+				if ( removed(i) )
+					continue;
+
+				const double* sample = row(i);
+				double products[queryBlock] = {0.0};
+
+				// Each feature of the row is loaded once and multiplied by every query of the block
+				for ( unsigned int j = 0; j < stride; ++j )
+				{
+					for ( unsigned int q = 0; q < queryBlock; ++q )
+						products[q] += query[q * stride + j] * sample[j];
+				}
+
+				for ( unsigned int q = firstQuery; q < lastQuery; ++q )
+				{
+					double distance = queryNorms[q - firstQuery] + norms_[i] - 2.0 * products[q - firstQuery];
+
+					// Rounding may leave a tiny negative value for duplicated samples
+					if ( distance < 0.0 )
+						distance = 0.0;
+
+					if ( distance < neighbours[q].bound() )
+						neighbours[q].insert(distance, i);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,28 @@
+/// @file
+/// @brief Definition of SearchEngine class
+
+#include "SearchEngine.hpp"
+
+
+SearchEngineType::SearchEngineType (const unsigned int& type)
+:	id_(type)
+{}
+
+
+bool SearchEngineType::operator== (const SearchEngineType& engine) const
+{
+	return this->id_ == engine.id_;
+}
+
+
+SearchEngine::SearchEngine (SearchEngineType type, const unsigned int& lists, const unsigned int& subquantizers, const unsigned int& probes,
+							const unsigned int& pivots, const unsigned int& classes, const unsigned int& partitions, const bool& exact)
+:	type_(type),
+	lists_(lists),
+	subquantizers_(subquantizers),
+	probes_(probes),
+	pivots_(pivots),
+	classes_(classes),
+	partitions_(partitions),
+	exact_(exact)
+{}
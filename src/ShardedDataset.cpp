@@ -0,0 +1,137 @@
+/// @file
+/// @brief Definition of ShardedDataset class
+
+#include "ShardedDataset.hpp"
+#include "NessieException.hpp"
+#include <algorithm>
+
+
+ShardedDataset::ShardedDataset (const std::vector<Dataset*>& shards)
+:	Dataset(),
+	shards_(shards),
+	offsets_(0)
+{
+	bool valid = not shards_.empty();
+	for ( std::vector<Dataset*>::const_iterator i = shards_.begin(); valid and i != shards_.end(); ++i )
+		valid = (*i)->features() == shards_.front()->features();
+
+	if ( not valid )
+	{
+		for ( std::vector<Dataset*>::iterator i = shards_.begin(); i != shards_.end(); ++i )
+			delete *i;
+
+		throw NessieException ("ShardedDataset::ShardedDataset() : There must be at least one shard and every shard must have the same number of features.");
+	}
+
+	features_	= shards_.front()->features();
+	projection_	= shards_.front()->projection();
+
+	for ( std::vector<Dataset*>::const_iterator i = shards_.begin(); i != shards_.end(); ++i )
+		geometry_.merge((*i)->geometry());
+
+	updateOffsets();
+
+	// The rows removed from a shard are removed from the dataset too
+	for ( unsigned int i = 0; i < shards_.size(); ++i )
+	{
+		for ( unsigned int n = 0; shards_[i]->removedSamples() > 0 and n < shards_[i]->size(); ++n )
+		{
+			if ( shards_[i]->removed(n) )
+				markRemoved(offsets_[i] + n);
+		}
+	}
+}
+
+
+ShardedDataset::~ShardedDataset ()
+{
+	for ( std::vector<Dataset*>::iterator i = shards_.begin(); i != shards_.end(); ++i )
+		delete *i;
+}
+
+
+const Sample& ShardedDataset::at (const unsigned int& n) const
+{
+	if ( n >= size_ )
+		throw NessieException ("ShardedDataset::at() : The row requested is out of range.");
+
+	unsigned int i = locate(n);
+	return shards_[i]->at(n - offsets_[i]);
+}
+
+
+unsigned int ShardedDataset::code (const std::string& character) const
+{
+	return shards_.front()->code(character);
+}
+
+
+std::string ShardedDataset::character (const unsigned int& code) const
+{
+	return shards_.front()->character(code);
+}
+
+
+void ShardedDataset::addSample (const Sample& sample)
+{
+	shards_.back()->addSample(sample);
+	updateOffsets();
+}
+
+
+void ShardedDataset::removeSample (const unsigned int& n)
+{
+	if ( n >= size_ or removed(n) )
+		throw NessieException ("ShardedDataset::removeSample() : The row requested is out of range or it was already removed.");
+
+	unsigned int i = locate(n);
+	shards_[i]->removeSample(n - offsets_[i]);
+	markRemoved(n);
+}
+
+
+void ShardedDataset::purge ()
+{
+	if ( removedSamples_ == 0 )
+		return;
+
+	for ( std::vector<Dataset*>::iterator i = shards_.begin(); i != shards_.end(); ++i )
+		(*i)->purge();
+
+	removed_.clear();
+	removedSamples_ = 0;
+	updateOffsets();
+}
+
+
+void ShardedDataset::learnGeometry (const unsigned int& code, const GlyphGeometry& geometry)
+{
+	geometry_.learn(code, geometry);
+	shards_.back()->learnGeometry(code, geometry);
+}
+
+
+void ShardedDataset::flush ()
+{
+	for ( std::vector<Dataset*>::iterator i = shards_.begin(); i != shards_.end(); ++i )
+		(*i)->flush();
+}
+
+
+unsigned int ShardedDataset::locate (const unsigned int& n) const
+{
+	// The last offset is the size of the dataset, so the shard found is always a valid one
+	std::vector<long unsigned int>::const_iterator i = std::upper_bound(offsets_.begin(), offsets_.end(), static_cast<long unsigned int>(n));
+	return (i - offsets_.begin()) - 1;
+}
+
+
+void ShardedDataset::updateOffsets ()
+{
+	offsets_.assign(shards_.size() + 1, 0);
+
+	for ( unsigned int i = 0; i < shards_.size(); ++i )
+		offsets_[i+1] = offsets_[i] + shards_[i]->size();
+
+	size_ = offsets_.back();
+}
@@ -0,0 +1,325 @@
+///	@file
+///	@brief	Definition of SqliteDataset class
+
+#include "SqliteDataset.hpp"
+#include "NessieException.hpp"
+#include <sqlite3.h>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <fstream>
+#include <utility>
+#include <cstring>
+
+
+///	@brief	Identifier written at the beginning of every SQLite database file.
+static const char sqliteMagic[16] = {'S', 'Q', 'L', 'i', 't', 'e', ' ', 'f', 'o', 'r', 'm', 'a', 't', ' ', '3', '\0'};
+
+
+///	@brief	Prepared statement of a SQLite database, which is finalized when it goes out of scope.
+class SqliteStatement
+{
+	public:
+
+		///	@brief		Constructor.
+		///
+		///	@param		connection	Connection to the database.
+		///	@param		sql			Text of the statement.
+		///
+		///	@exception	NessieException	The statement could not be prepared.
+		SqliteStatement (sqlite3* connection, const std::string& sql)
+		:	statement_(0)
+		{
+			if ( sqlite3_prepare_v2(connection, sql.data(), sql.size(), &statement_, 0) != SQLITE_OK )
+			{
+				std::string message(sqlite3_errmsg(connection));
+				sqlite3_finalize(statement_);
+				throw NessieException ("The statement '" + sql + "' could not be prepared. " + message);
+			}
+		};
+
+		///	@brief	Destructor.
+		~SqliteStatement () { sqlite3_finalize(statement_); };
+
+		///	@brief	Get the statement.
+		///
+		///	@return	The statement, to pass to the functions of SQLite.
+		sqlite3_stmt* get () const { return statement_; };
+
+	private:
+
+		sqlite3_stmt*	statement_;	///< Statement prepared.
+
+		// Do not implement these methods, as they are only declared here to prevent objects to be copied.
+		SqliteStatement (const SqliteStatement&);
+		SqliteStatement& operator= (const SqliteStatement&);
+};
+
+
+///	@brief		Execute a statement that returns no rows.
+///
+///	@param		connection	Connection to the database.
+///	@param		sql			Text of the statement.
+///
+///	@exception	NessieException	The statement failed.
+static void execute (sqlite3* connection, const std::string& sql)
+{
+	char* error = 0;
+	if ( sqlite3_exec(connection, sql.data(), 0, 0, &error) != SQLITE_OK )
+	{
+		std::string message(error != 0 ? error : sqlite3_errmsg(connection));
+		sqlite3_free(error);
+		throw NessieException ("The statement '" + sql + "' failed. " + message);
+	}
+}
+
+
+SqliteDataset::SqliteDataset (const std::string& filename)
+:	Dataset(),
+	filename_(filename),
+	connection_(0),
+	sampleIds_(0),
+	classIds_(),
+	pending_(0),
+	removedIds_(0)
+{
+	try
+	{
+		// The database is not created here, as a database without classes could not hold any sample
+		if ( sqlite3_open_v2(filename_.data(), &connection_, SQLITE_OPEN_READWRITE, 0) != SQLITE_OK )
+			throw NessieException ("The file " + filename_ + " could not be opened. " + std::string(sqlite3_errmsg(connection_)));
+
+		// A reader never waits for a writer in write-ahead logging mode, and a commit only needs to reach the log
+		execute(connection_, "PRAGMA journal_mode = WAL");
+		execute(connection_, "PRAGMA synchronous = NORMAL");
+		sqlite3_busy_timeout(connection_, 5000);
+
+		{
+			SqliteStatement statement(connection_, "PRAGMA user_version");
+			if ( sqlite3_step(statement.get()) != SQLITE_ROW or sqlite3_column_int(statement.get(), 0) <= 0 )
+				throw NessieException ("The number of features is not set in the user_version field of the database.");
+
+			features_ = sqlite3_column_int(statement.get(), 0);
+		}
+
+
+		// Get the classes
+		typedef std::pair<std::string, unsigned int> asciiCodeRegister;
+		typedef std::pair<unsigned int, unsigned int> ClassIdRegister;
+
+		std::map<unsigned int, unsigned int> asciiCodes;
+		{
+			SqliteStatement statement(connection_, "SELECT id_class, label, asciiCode FROM classes");
+
+			int status;
+			while ( (status = sqlite3_step(statement.get())) == SQLITE_ROW )
+			{
+				const unsigned char* label = sqlite3_column_text(statement.get(), 1);
+				if ( sqlite3_column_type(statement.get(), 0) != SQLITE_INTEGER or label == 0 or sqlite3_column_type(statement.get(), 2) != SQLITE_INTEGER )
+					throw NessieException ("The table 'classes' has an invalid row.");
+
+				unsigned int idClass	= sqlite3_column_int(statement.get(), 0);
+				unsigned int asciiCode	= sqlite3_column_int(statement.get(), 2);
+
+				classes_.insert(asciiCodeRegister(reinterpret_cast<const char*>(label), asciiCode));
+				classIds_.insert(ClassIdRegister(asciiCode, idClass));
+				asciiCodes.insert(ClassIdRegister(idClass, asciiCode));
+			}
+
+			if ( status != SQLITE_DONE )
+				throw NessieException ("The table 'classes' could not be read. " + std::string(sqlite3_errmsg(connection_)));
+		}
+
+
+		// Get the samples, copying the array of features of every row straight into the dataset
+		{
+			SqliteStatement statement(connection_, "SELECT count(*) FROM samples");
+			if ( sqlite3_step(statement.get()) == SQLITE_ROW )
+			{
+				samples_.reserve(sqlite3_column_int(statement.get(), 0));
+				sampleIds_.reserve(sqlite3_column_int(statement.get(), 0));
+			}
+		}
+
+		SqliteStatement statement(connection_, "SELECT id_sample, features, id_class FROM samples ORDER BY id_sample");
+
+		int status;
+		while ( (status = sqlite3_step(statement.get())) == SQLITE_ROW )
+		{
+			// Like the join of both tables, samples without a known class are left out
+			std::map<unsigned int, unsigned int>::const_iterator code = asciiCodes.find(sqlite3_column_int(statement.get(), 2));
+			if ( sqlite3_column_type(statement.get(), 2) != SQLITE_INTEGER or code == asciiCodes.end() )
+				continue;
+
+			const void* features = sqlite3_column_blob(statement.get(), 1);
+			if ( static_cast<unsigned int>(sqlite3_column_bytes(statement.get(), 1)) != features_ * sizeof(double) )
+				throw NessieException ("The table 'samples' has a features column with a different number of features than the database.");
+
+			samples_.push_back( Sample(FeatureVector(features_), code->second) );
+			std::memcpy(&samples_.back().first[0], features, features_ * sizeof(double));
+
+			sampleIds_.push_back(sqlite3_column_int(statement.get(), 0));
+		}
+
+		if ( status != SQLITE_DONE )
+			throw NessieException ("The table 'samples' could not be read. " + std::string(sqlite3_errmsg(connection_)));
+
+		size_ = samples_.size();
+	}
+	catch (const std::exception& e)
+	{
+		samples_.clear();
+		sampleIds_.clear();
+		classes_.clear();
+		classIds_.clear();
+		size_ = 0;
+
+		sqlite3_close(connection_);
+		connection_ = 0;
+
+		std::string message(e.what());
+		throw NessieException ("SqliteDataset::SqliteDataset() : The dataset could not be built from the database. " + message);
+	}
+}
+
+
+SqliteDataset::~SqliteDataset ()
+{
+	try
+	{
+		flush();
+	}
+	catch (...) {}
+
+	sqlite3_close(connection_);
+}
+
+
+void SqliteDataset::addSample (const Sample& sample)
+{
+	if ( sample.first.size() != features_ )
+		throw NessieException ("SqliteDataset::addSample() : The number of features in the sample is different from the one expected by the dataset.");
+
+	if ( classIds_.find(sample.second) == classIds_.end() )
+		throw NessieException ("SqliteDataset::addSample() : The class of the sample is not in the database.");
+
+	samples_.push_back(sample);
+	size_ = samples_.size();
+	++pending_;
+}
+
+
+void SqliteDataset::removeSample (const unsigned int& n)
+{
+	if ( n >= size_ or removed(n) )
+		throw NessieException ("SqliteDataset::removeSample() : The row is beyond the size of the dataset or it was already removed.");
+
+	// A sample that has not been inserted yet is only left out of the next flush
+	if ( n < sampleIds_.size() )
+		removedIds_.push_back(sampleIds_[n]);
+
+	markRemoved(n);
+}
+
+
+void SqliteDataset::purge ()
+{
+	if ( removedSamples_ == 0 )
+		return;
+
+	// The samples not inserted yet have no id_sample, so only the ids of the ones inserted are dropped
+	purgeRows(sampleIds_);
+	Dataset::purge();
+
+	pending_ = size_ - sampleIds_.size();
+}
+
+
+void SqliteDataset::flush ()
+{
+	if ( pending_ == 0 and removedIds_.empty() )
+		return;
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+	std::vector<unsigned int> newIds(0);
+	newIds.reserve(pending_);
+
+	try
+	{
+		execute(connection_, "BEGIN IMMEDIATE");
+
+		try
+		{
+			if ( not removedIds_.empty() )
+			{
+				SqliteStatement statement(connection_, "DELETE FROM samples WHERE id_sample = ?");
+
+				for ( std::vector<unsigned int>::const_iterator i = removedIds_.begin(); i != removedIds_.end(); ++i )
+				{
+					sqlite3_bind_int64(statement.get(), 1, *i);
+					if ( sqlite3_step(statement.get()) != SQLITE_DONE )
+						throw NessieException ("A sample could not be deleted. " + std::string(sqlite3_errmsg(connection_)));
+
+					sqlite3_reset(statement.get());
+				}
+			}
+
+			if ( pending_ > 0 )
+			{
+				SqliteStatement statement(connection_, "INSERT INTO samples (features, id_class) VALUES (?, ?)");
+
+				for ( unsigned int i = size_ - pending_; i < size_; ++i )
+				{
+					// A sample removed before it was inserted keeps no id_sample
+					if ( removed(i) )
+					{
+						newIds.push_back(0);
+						continue;
+					}
+
+					const Sample& sample = samples_[i];
+
+					// The features are bound in place, since the statement is executed before the sample can change
+					sqlite3_bind_blob(statement.get(), 1, sample.first.data(), features_ * sizeof(double), SQLITE_STATIC);
+					sqlite3_bind_int64(statement.get(), 2, classIds_[sample.second]);
+
+					if ( sqlite3_step(statement.get()) != SQLITE_DONE )
+						throw NessieException ("A sample could not be inserted. " + std::string(sqlite3_errmsg(connection_)));
+
+					sqlite3_reset(statement.get());
+					newIds.push_back(sqlite3_last_insert_rowid(connection_));
+				}
+			}
+
+			execute(connection_, "COMMIT");
+		}
+		catch (...)
+		{
+			sqlite3_exec(connection_, "ROLLBACK", 0, 0, 0);
+			throw;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		storageTime_ += (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+
+		std::string message(e.what());
+		throw NessieException ("SqliteDataset::flush() : The changes could not be written to the database. " + message);
+	}
+
+	sampleIds_.insert(sampleIds_.end(), newIds.begin(), newIds.end());
+	pending_ = 0;
+	removedIds_.clear();
+
+	storageTime_ += (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+}
+
+
+bool SqliteDataset::recognizes (const std::string& filename)
+{
+	std::ifstream file(filename.data(), std::ios::binary);
+
+	char magic[sizeof(sqliteMagic)];
+	file.read(magic, sizeof(magic));
+
+	return file.good() and std::memcmp(magic, sqliteMagic, sizeof(magic)) == 0;
+}
@@ -0,0 +1,829 @@
+/// @file
+/// @brief Implementation of a command line program for measuring the KNN search engines.
+
+#include "PlainTextDataset.hpp"
+#include "BinaryDataset.hpp"
+#include "FeatureVector.hpp"
+#include "SampleMatrix.hpp"
+#include "NeighbourList.hpp"
+#include "InvertedFileIndex.hpp"
+#include "PivotIndex.hpp"
+#include "ClassFilterIndex.hpp"
+#include "DatasetCondenser.hpp"
+#include "PerceptronModel.hpp"
+#include "FeatureProjection.hpp"
+#include "KnnEvaluator.hpp"
+
+#include <boost/program_options.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+
+///	@brief	Get the elapsed time since a given instant.
+///
+///	@param	start	Instant of reference.
+///
+///	@return	Elapsed time in seconds.
+static double elapsedTime (const boost::posix_time::ptime& start)
+{
+	return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+}
+
+
+///	@brief	Get the most voted label among the neighbours found.
+///
+///	@param	matrix		Matrix that was searched.
+///	@param	neighbours	List of nearest neighbours.
+///
+///	@return	The label with the most appearances, resolving ties in favour of the lowest label like KnnClassificationAlgorithm does.
+static unsigned int vote (const SampleMatrix& matrix, const NeighbourList& neighbours)
+{
+	if ( neighbours.size() == 0 )
+		return 0;
+
+	unsigned int label			= matrix.label(neighbours.row(0));
+	unsigned int appearances	= 0;
+
+	for ( unsigned int i = 0; i < neighbours.size(); ++i )
+	{
+		unsigned int candidate	= matrix.label(neighbours.row(i));
+		unsigned int count		= 0;
+
+		for ( unsigned int j = 0; j < neighbours.size(); ++j )
+		{
+			if ( matrix.label(neighbours.row(j)) == candidate )
+				++count;
+		}
+
+		if ( count > appearances or (count == appearances and candidate < label) )
+		{
+			label		= candidate;
+			appearances	= count;
+		}
+	}
+
+	return label;
+}
+
+
+///	@brief	Build an index, search every query with it and print a row with the fraction of queries whose neighbours are identical to the exact
+///			ones, the fraction whose classification agrees with the exact one, the fraction of distance evaluations avoided and the times spent.
+///
+///	@param	name			Name of the index in the table.
+///	@param	index			Index to measure.
+///	@param	matrix			Matrix of reference samples.
+///	@param	paddedQueries	Queries padded by SampleMatrix::load(), one after another.
+///	@param	exact			Exact neighbours of every query.
+///	@param	exactLabels		Classification of every query by its exact neighbours.
+///	@param	exactTime		Time spent by the exact search, in seconds.
+static void measureIndex (const std::string& name, KnnIndex& index, const SampleMatrix& matrix, const std::vector<double>& paddedQueries,
+						  const std::vector<NeighbourList>& exact, const std::vector<unsigned int>& exactLabels, const double& exactTime)
+{
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	index.build(matrix);
+	double buildTime = elapsedTime(start);
+
+	unsigned int nQueries			= exact.size();
+	unsigned int identical			= 0;
+	unsigned int agreements			= 0;
+	long unsigned int evaluations	= 0;
+	double searchTime				= 0.0;
+
+	NeighbourList neighbours(exact.front().capacity());
+	for ( unsigned int i = 0; i < nQueries; ++i )
+	{
+		neighbours.clear();
+
+		start = boost::posix_time::microsec_clock::universal_time();
+		evaluations += index.search(matrix, &paddedQueries[static_cast<std::size_t>(i) * matrix.stride()], neighbours);
+		searchTime += elapsedTime(start);
+
+		bool same = ( neighbours.size() == exact.at(i).size() );
+		for ( unsigned int j = 0; same and j < neighbours.size(); ++j )
+			same = ( neighbours.row(j) == exact.at(i).row(j) );
+
+		if ( same )
+			++identical;
+
+		if ( vote(matrix, neighbours) == exactLabels.at(i) )
+			++agreements;
+	}
+
+	double scanned = static_cast<double>(nQueries) * matrix.rows();
+	std::cout << std::setw(12) << name << std::setw(11) << static_cast<double>(identical) / nQueries << std::setw(11) << static_cast<double>(agreements) / nQueries
+		<< std::setw(10) << ( scanned > 0.0 ? 1.0 - evaluations / scanned : 0.0 )
+		<< std::setw(10) << buildTime << std::setw(10) << searchTime << std::setw(9) << ( searchTime > 0.0 ? exactTime / searchTime : 0.0 ) << std::endl;
+}
+
+
+///	@brief	Search every sample of the queries dataset in the reference dataset, first exactly and then with the indexes, and print a table that
+///			compares the recall, the agreement with the exact classification, the accuracy and the search time of each engine.
+///
+///	@param	passedOptions	Command line options.
+///	@param	probes			Numbers of inverted lists visited per query to measure.
+///	@param	pivots			Numbers of pivot samples to measure.
+///	@param	classes			Numbers of classes scanned first to measure.
+///
+///	@return	0 if the measures were taken, 1 otherwise.
+static int compareEngines (const po::variables_map& passedOptions, const std::vector<unsigned int>& probes, const std::vector<unsigned int>& pivots,
+						   const std::vector<unsigned int>& classes)
+{
+	unsigned int k = passedOptions["knn"].as<unsigned int>();
+
+	PlainTextDataset reference( passedOptions["file"].as<std::string>() );
+	PlainTextDataset queries( passedOptions["queries"].as<std::string>() );
+
+	SampleMatrix matrix(reference);
+	unsigned int nQueries = queries.size();
+	if ( nQueries == 0 )
+	{
+		std::cerr << "knntest: The queries dataset is empty." << std::endl;
+		return 1;
+	}
+
+	std::vector<double> buffer(0);
+	std::vector<double> paddedQueries(0);
+	paddedQueries.reserve(static_cast<std::size_t>(nQueries) * matrix.stride());
+
+	for ( unsigned int i = 0; i < nQueries; ++i )
+	{
+		matrix.load(queries.at(i).first, buffer);
+		paddedQueries.insert(paddedQueries.end(), buffer.begin(), buffer.end());
+	}
+
+
+	// Exact search as the reference of every measure
+	std::vector<NeighbourList> exact(nQueries, NeighbourList(k));
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for ( unsigned int i = 0; i < nQueries; ++i )
+		matrix.search(&paddedQueries[static_cast<std::size_t>(i) * matrix.stride()], exact.at(i));
+	double exactTime = elapsedTime(start);
+
+	std::vector<unsigned int> exactLabels(nQueries, 0);
+	unsigned int exactHits = 0;
+	for ( unsigned int i = 0; i < nQueries; ++i )
+	{
+		exactLabels.at(i) = vote(matrix, exact.at(i));
+		if ( exactLabels.at(i) == queries.at(i).second )
+			++exactHits;
+	}
+
+	std::cout << "Reference samples : " << matrix.rows() << std::endl;
+	std::cout << "Queries           : " << nQueries << std::endl;
+	std::cout << "Neighbours        : " << k << std::endl << std::endl;
+
+	std::cout << std::setw(8) << "probes" << std::setw(10) << "recall" << std::setw(11) << "agreement"
+		<< std::setw(10) << "accuracy" << std::setw(10) << "build(s)" << std::setw(10) << "search(s)" << std::setw(9) << "speedup" << std::endl;
+
+	std::cout << std::fixed << std::setprecision(4);
+	std::cout << std::setw(8) << "exact" << std::setw(10) << 1.0 << std::setw(11) << 1.0
+		<< std::setw(10) << static_cast<double>(exactHits) / nQueries << std::setw(10) << 0.0 << std::setw(10) << exactTime << std::setw(9) << 1.0 << std::endl;
+
+
+	// Approximate searches
+	NeighbourList approximate(k);
+	for ( std::vector<unsigned int>::const_iterator p = probes.begin(); p != probes.end(); ++p )
+	{
+		start = boost::posix_time::microsec_clock::universal_time();
+		InvertedFileIndex index(passedOptions["lists"].as<unsigned int>(), passedOptions["subquantizers"].as<unsigned int>(), *p);
+		index.build(matrix);
+		double buildTime = elapsedTime(start);
+
+		unsigned int found		= 0;
+		unsigned int expected	= 0;
+		unsigned int agreements	= 0;
+		unsigned int hits		= 0;
+		double searchTime		= 0.0;
+
+		for ( unsigned int i = 0; i < nQueries; ++i )
+		{
+			approximate.clear();
+
+			start = boost::posix_time::microsec_clock::universal_time();
+			index.search(matrix, &paddedQueries[static_cast<std::size_t>(i) * matrix.stride()], approximate);
+			searchTime += elapsedTime(start);
+
+			// Fraction of the exact neighbours retrieved by the approximate search
+			for ( unsigned int j = 0; j < exact.at(i).size(); ++j )
+			{
+				for ( unsigned int l = 0; l < approximate.size(); ++l )
+				{
+					if ( approximate.row(l) == exact.at(i).row(j) )
+					{
+						++found;
+						break;
+					}
+				}
+			}
+			expected += exact.at(i).size();
+
+			unsigned int label = vote(matrix, approximate);
+			if ( label == exactLabels.at(i) )
+				++agreements;
+			if ( label == queries.at(i).second )
+				++hits;
+		}
+
+		std::cout << std::setw(8) << *p << std::setw(10) << ( expected > 0 ? static_cast<double>(found) / expected : 1.0 )
+			<< std::setw(11) << static_cast<double>(agreements) / nQueries << std::setw(10) << static_cast<double>(hits) / nQueries
+			<< std::setw(10) << buildTime << std::setw(10) << searchTime << std::setw(9) << ( searchTime > 0.0 ? exactTime / searchTime : 0.0 ) << std::endl;
+	}
+
+
+	// Searches over the other indexes
+	std::cout << std::endl << std::setw(12) << "index" << std::setw(11) << "identical" << std::setw(11) << "agreement" << std::setw(10) << "avoided"
+		<< std::setw(10) << "build(s)" << std::setw(10) << "search(s)" << std::setw(9) << "speedup" << std::endl;
+
+	for ( std::vector<unsigned int>::const_iterator p = pivots.begin(); p != pivots.end(); ++p )
+	{
+		std::ostringstream name;
+		name << "pivots " << *p;
+
+		PivotIndex index(*p);
+		measureIndex(name.str(), index, matrix, paddedQueries, exact, exactLabels, exactTime);
+	}
+
+	for ( std::vector<unsigned int>::const_iterator c = classes.begin(); c != classes.end(); ++c )
+	{
+		std::ostringstream name;
+		name << "classes " << *c;
+
+		ClassFilterIndex exactIndex(*c, true);
+		measureIndex(name.str(), exactIndex, matrix, paddedQueries, exact, exactLabels, exactTime);
+
+		ClassFilterIndex approximateIndex(*c, false);
+		measureIndex(name.str() + "~", approximateIndex, matrix, paddedQueries, exact, exactLabels, exactTime);
+	}
+
+	return 0;
+}
+
+
+///	@brief	Reduce the reference dataset with DatasetCondenser, print the size and the leave-one-out accuracy after every step, and save the
+///			prototypes kept.
+///
+///	@param	passedOptions	Command line options.
+///	@param	steps			Reduction steps to apply, in order.
+///
+///	@return	0 if the dataset was reduced, 1 otherwise.
+static int condenseDataset (const po::variables_map& passedOptions, const std::vector<std::string>& steps)
+{
+	unsigned int k = passedOptions["knn"].as<unsigned int>();
+
+	PlainTextDataset reference( passedOptions["file"].as<std::string>() );
+	DatasetCondenser condenser(reference);
+
+	std::cout << "Reference samples : " << condenser.samples() << std::endl;
+	std::cout << "Neighbours        : " << k << std::endl << std::endl;
+
+	std::cout << std::setw(12) << "step" << std::setw(12) << "prototypes" << std::setw(11) << "reduction" << std::setw(10) << "accuracy"
+		<< std::setw(8) << "delta" << std::setw(9) << "time(s)" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+
+	double originalAccuracy = condenser.accuracy(k);
+	std::cout << std::setw(12) << "original" << std::setw(12) << condenser.prototypes() << std::setw(10) << 0.0 << "%" << std::setw(10) << originalAccuracy
+		<< std::setw(8) << 0.0 << std::setw(9) << 0.0 << std::endl;
+
+	for ( std::vector<std::string>::const_iterator step = steps.begin(); step != steps.end(); ++step )
+	{
+		boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+		if ( *step == "duplicates" )
+			condenser.collapseDuplicates();
+		else if ( *step == "wilson" )
+			condenser.edit(passedOptions["edit-knn"].as<unsigned int>());
+		else if ( *step == "hart" )
+			condenser.condense();
+		else
+		{
+			std::cerr << "knntest: Unknown reduction step " << *step << "." << std::endl;
+			return 1;
+		}
+
+		double stepTime	= elapsedTime(start);
+		double accuracy	= condenser.accuracy(k);
+
+		std::cout << std::setw(12) << *step << std::setw(12) << condenser.prototypes()
+			<< std::setw(10) << 100.0 * (1.0 - static_cast<double>(condenser.prototypes()) / condenser.samples()) << "%"
+			<< std::setw(10) << accuracy << std::setw(8) << accuracy - originalAccuracy << std::setw(9) << stepTime << std::endl;
+	}
+
+	// Save the prototypes in a new plain text dataset
+	std::string filename( passedOptions["condense"].as<std::string>() );
+	std::ofstream outputFile( filename.data(), std::ios::trunc );
+	if ( not outputFile.is_open() or not outputFile.good() )
+	{
+		std::cerr << "knntest: The file " << filename << " could not be created." << std::endl;
+		return 1;
+	}
+	outputFile << reference.features() << std::endl;
+	outputFile.close();
+
+	PlainTextDataset output(filename);
+	condenser.copyTo(output);
+	output.compact();
+
+	return 0;
+}
+
+
+///	@brief	Train a perceptron model on the reference dataset, save it, and print its size and its accuracy and classification time compared with
+///			an exact KNN search.
+///
+///	@param	passedOptions	Command line options.
+///
+///	@return	0 if the model was trained and saved, 1 otherwise.
+static int trainModel (const po::variables_map& passedOptions)
+{
+	unsigned int k = passedOptions["knn"].as<unsigned int>();
+	std::string filename( passedOptions["train-model"].as<std::string>() );
+
+	PlainTextDataset reference( passedOptions["file"].as<std::string>() );
+	PerceptronModel model;
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	model.train(reference, passedOptions["hidden"].as<unsigned int>(), passedOptions["epochs"].as<unsigned int>(), passedOptions["rate"].as<double>());
+	double trainingTime = elapsedTime(start);
+
+	// Measure the model as it is read back, so that the file is checked too
+	model.save(filename);
+	PerceptronModel loaded;
+	loaded.load(filename);
+
+	std::ifstream modelFile( filename.data(), std::ios::binary | std::ios::ate );
+
+	std::cout << "Reference samples : " << reference.size() << std::endl;
+	std::cout << "Classes           : " << loaded.classes() << std::endl;
+	std::cout << "Hidden units      : " << loaded.hidden() << std::endl;
+	std::cout << "Model size        : " << modelFile.tellg() << " bytes" << std::endl;
+	std::cout << "Training time     : " << std::fixed << std::setprecision(2) << trainingTime << " s" << std::endl;
+
+	std::vector<FeatureVector> referenceVectors(0);
+	for ( unsigned int i = 0; i < reference.size(); ++i )
+		referenceVectors.push_back(reference.at(i).first);
+
+	std::vector<unsigned int> labels( loaded.classify(referenceVectors) );
+	unsigned int hits = 0;
+	for ( unsigned int i = 0; i < reference.size(); ++i )
+	{
+		if ( labels.at(i) == reference.at(i).second )
+			++hits;
+	}
+	std::cout << "Training accuracy : " << std::setprecision(4) << static_cast<double>(hits) / reference.size() << std::endl;
+
+	if ( not passedOptions.count("queries") )
+		return 0;
+
+	PlainTextDataset queries( passedOptions["queries"].as<std::string>() );
+	unsigned int nQueries = queries.size();
+	if ( nQueries == 0 )
+	{
+		std::cerr << "knntest: The queries dataset is empty." << std::endl;
+		return 1;
+	}
+
+	std::vector<FeatureVector> queryVectors(0);
+	for ( unsigned int i = 0; i < nQueries; ++i )
+		queryVectors.push_back(queries.at(i).first);
+
+	// Exact KNN search
+	SampleMatrix matrix(reference);
+	std::vector<double> buffer(0);
+	NeighbourList neighbours(k);
+	unsigned int knnHits = 0;
+
+	start = boost::posix_time::microsec_clock::universal_time();
+	for ( unsigned int i = 0; i < nQueries; ++i )
+	{
+		matrix.load(queryVectors.at(i), buffer);
+		neighbours.clear();
+		matrix.search(&buffer[0], neighbours);
+
+		if ( vote(matrix, neighbours) == queries.at(i).second )
+			++knnHits;
+	}
+	double knnTime = elapsedTime(start);
+
+	// Quantized model
+	start = boost::posix_time::microsec_clock::universal_time();
+	labels = loaded.classify(queryVectors);
+	double modelTime = elapsedTime(start);
+
+	hits = 0;
+	for ( unsigned int i = 0; i < nQueries; ++i )
+	{
+		if ( labels.at(i) == queries.at(i).second )
+			++hits;
+	}
+
+	std::cout << std::endl << std::setw(12) << "engine" << std::setw(10) << "accuracy" << std::setw(10) << "time(s)" << std::setw(9) << "speedup" << std::endl;
+	std::cout << std::setw(12) << "knn" << std::setw(10) << static_cast<double>(knnHits) / nQueries << std::setw(10) << knnTime << std::setw(9) << 1.0 << std::endl;
+	std::cout << std::setw(12) << "perceptron" << std::setw(10) << static_cast<double>(hits) / nQueries << std::setw(10) << modelTime
+		<< std::setw(9) << ( modelTime > 0.0 ? knnTime / modelTime : 0.0 ) << std::endl;
+
+	return 0;
+}
+
+
+///	@brief	Search the queries in a matrix of samples and count the hits of the exact KNN classification.
+///
+///	@param	matrix	Matrix of reference samples.
+///	@param	queries	Feature vectors of the queries.
+///	@param	labels	Expected label of every query.
+///	@param	k		Number of neighbours.
+///	@param	time	Elapsed time while searching, in seconds.
+///
+///	@return	Number of queries classified into their expected class.
+static unsigned int countHits (const SampleMatrix& matrix, const std::vector<FeatureVector>& queries, const std::vector<unsigned int>& labels,
+							   const unsigned int& k, double& time)
+{
+	std::vector<double> buffer(0);
+	NeighbourList neighbours(k);
+	unsigned int hits = 0;
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for ( unsigned int i = 0; i < queries.size(); ++i )
+	{
+		matrix.load(queries.at(i), buffer);
+		neighbours.clear();
+		matrix.search(&buffer[0], neighbours);
+
+		if ( vote(matrix, neighbours) == labels.at(i) )
+			++hits;
+	}
+	time = elapsedTime(start);
+
+	return hits;
+}
+
+
+///	@brief	Fit a FeatureProjection on the reference dataset, save the projected samples with the projection next to them, and print the accuracy
+///			and search time of an exact KNN search before and after the projection.
+///
+///	@param	passedOptions	Command line options.
+///
+///	@return	0 if the dataset was projected, 1 otherwise.
+static int projectDataset (const po::variables_map& passedOptions)
+{
+	unsigned int k = passedOptions["knn"].as<unsigned int>();
+	std::string filename( passedOptions["project"].as<std::string>() );
+
+	PlainTextDataset reference( passedOptions["file"].as<std::string>() );
+	if ( not reference.projection().empty() )
+	{
+		std::cerr << "knntest: The reference dataset has already been projected." << std::endl;
+		return 1;
+	}
+
+	FeatureProjection projection;
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	double explained = projection.fit(reference, passedOptions["components"].as<unsigned int>());
+	double fitTime = elapsedTime(start);
+
+	std::cout << "Reference samples : " << reference.size() << std::endl;
+	std::cout << "Features          : " << projection.inputs() << " -> " << projection.outputs() << std::endl;
+	std::cout << "Variance explained: " << std::fixed << std::setprecision(4) << explained << std::endl;
+	std::cout << "Fitting time      : " << fitTime << " s" << std::endl;
+
+	// The projection is saved first, so that the new dataset picks it up when it is opened
+	std::ofstream outputFile( filename.data(), std::ios::trunc );
+	if ( not outputFile.is_open() or not outputFile.good() )
+	{
+		std::cerr << "knntest: The file " << filename << " could not be created." << std::endl;
+		return 1;
+	}
+	outputFile << projection.outputs() << std::endl;
+	outputFile.close();
+	projection.save(filename + ".projection");
+
+	{
+		PlainTextDataset output(filename);
+		for ( unsigned int i = 0; i < reference.size(); ++i )
+			output.addSample(Sample(projection.project(reference.at(i).first), reference.at(i).second));
+
+		output.compact();
+	}
+
+	if ( not passedOptions.count("queries") )
+		return 0;
+
+	PlainTextDataset queries( passedOptions["queries"].as<std::string>() );
+	unsigned int nQueries = queries.size();
+	if ( nQueries == 0 )
+	{
+		std::cerr << "knntest: The queries dataset is empty." << std::endl;
+		return 1;
+	}
+
+	std::vector<FeatureVector> rawQueries(0);
+	std::vector<FeatureVector> projectedQueries(0);
+	std::vector<unsigned int> labels(0);
+	for ( unsigned int i = 0; i < nQueries; ++i )
+	{
+		rawQueries.push_back(queries.at(i).first);
+		projectedQueries.push_back(projection.project(queries.at(i).first));
+		labels.push_back(queries.at(i).second);
+	}
+
+	double rawTime, projectedTime;
+	unsigned int rawHits		= countHits(SampleMatrix(reference), rawQueries, labels, k, rawTime);
+	unsigned int projectedHits	= countHits(SampleMatrix(PlainTextDataset(filename)), projectedQueries, labels, k, projectedTime);
+
+	std::cout << std::endl << std::setw(12) << "space" << std::setw(10) << "features" << std::setw(10) << "accuracy" << std::setw(10) << "time(s)"
+		<< std::setw(9) << "speedup" << std::endl;
+	std::cout << std::setw(12) << "moments" << std::setw(10) << projection.inputs() << std::setw(10) << static_cast<double>(rawHits) / nQueries
+		<< std::setw(10) << rawTime << std::setw(9) << 1.0 << std::endl;
+	std::cout << std::setw(12) << "projected" << std::setw(10) << projection.outputs() << std::setw(10) << static_cast<double>(projectedHits) / nQueries
+		<< std::setw(10) << projectedTime << std::setw(9) << ( projectedTime > 0.0 ? rawTime / projectedTime : 0.0 ) << std::endl;
+
+	return 0;
+}
+
+
+///	@brief	Convert the reference dataset from plain text to binary or the other way round, and print the time it takes to load it in each format.
+///
+///	@param	passedOptions	Command line options.
+///
+///	@return	0 if the dataset was converted, 1 otherwise.
+static int convertDataset (const po::variables_map& passedOptions)
+{
+	std::string input( passedOptions["file"].as<std::string>() );
+	std::string output( passedOptions["convert"].as<std::string>() );
+	bool toText = BinaryDataset::recognizes(input);
+
+	double textTime, binaryTime;
+	unsigned int samples, features;
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+	if ( toText )
+	{
+		BinaryDataset reference(input);
+		binaryTime	= elapsedTime(start);
+		samples		= reference.size();
+		features	= reference.features();
+
+		// The projection and the geometry are saved first, so that the new dataset picks them up when it is opened
+		std::ofstream outputFile( output.data(), std::ios::trunc );
+		if ( not outputFile.is_open() or not outputFile.good() )
+		{
+			std::cerr << "knntest: The file " << output << " could not be created." << std::endl;
+			return 1;
+		}
+		outputFile << features << std::endl;
+		outputFile.close();
+
+		if ( not reference.projection().empty() )
+			reference.projection().save(output + ".projection");
+
+		if ( not reference.geometry().empty() )
+			reference.geometry().save(output + ".geometry");
+
+		{
+			PlainTextDataset text(output);
+			for ( unsigned int i = 0; i < samples; ++i )
+				text.addSample(reference.at(i));
+
+			text.compact();
+		}
+
+		start = boost::posix_time::microsec_clock::universal_time();
+		PlainTextDataset text(output);
+		textTime = elapsedTime(start);
+	}
+	else
+	{
+		PlainTextDataset reference(input);
+		textTime	= elapsedTime(start);
+		samples		= reference.size();
+		features	= reference.features();
+
+		BinaryDataset::save(reference, output);
+
+		start = boost::posix_time::microsec_clock::universal_time();
+		BinaryDataset binary(output);
+		binaryTime = elapsedTime(start);
+	}
+
+	std::cout << "Samples           : " << samples << std::endl;
+	std::cout << "Features          : " << features << std::endl;
+	std::cout << "Format written    : " << ( toText ? "plain text" : "binary" ) << std::endl;
+	std::cout << std::fixed << std::setprecision(4);
+	std::cout << "Plain text loading: " << textTime << " s" << std::endl;
+	std::cout << "Binary loading    : " << binaryTime << " s" << std::endl;
+	std::cout << "Speedup           : " << std::setprecision(2) << ( binaryTime > 0.0 ? textTime / binaryTime : 0.0 ) << std::endl;
+
+	return 0;
+}
+
+
+///	@brief	Classify the queries and the reference samples by leave-one-out with every number of neighbours up to a maximum, searching the
+///			neighbours once, and print a table with the accuracy and the estimated latency of every number of neighbours.
+///
+///	@param	passedOptions	Command line options.
+///
+///	@return	0 if the measures were taken, 1 otherwise.
+static int sweepNeighbours (const po::variables_map& passedOptions)
+{
+	unsigned int kMax		= passedOptions["sweep"].as<unsigned int>();
+	unsigned int threads	= passedOptions["threads"].as<unsigned int>();
+	if ( kMax == 0 )
+	{
+		std::cerr << "knntest: The number of neighbours must be greater than zero." << std::endl;
+		return 1;
+	}
+
+	PlainTextDataset reference( passedOptions["file"].as<std::string>() );
+	KnnEvaluator evaluator(reference, threads);
+
+	std::cout << "Reference samples : " << reference.size() << std::endl;
+	std::cout << "Threads           : " << threads << std::endl;
+	std::cout << std::fixed << std::setprecision(4);
+
+	std::vector<double> accuracies(kMax, 0.0);
+	std::vector<double> latencies(kMax, 0.0);
+	if ( passedOptions.count("queries") )
+	{
+		PlainTextDataset queries( passedOptions["queries"].as<std::string>() );
+
+		// A single classification, as the reference of the cost of the sweep
+		boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+		evaluator.evaluate(queries, 1);
+		double singleTime = elapsedTime(start);
+
+		start = boost::posix_time::microsec_clock::universal_time();
+		evaluator.evaluate(queries, kMax);
+		double sweepTime = elapsedTime(start);
+
+		for ( unsigned int k = 1; k <= kMax; ++k )
+		{
+			accuracies[k-1]	= evaluator.accuracy(k);
+			latencies[k-1]	= evaluator.latency(k);
+		}
+
+		std::cout << "Queries           : " << evaluator.queries() << std::endl;
+		std::cout << "Single run (k=1)  : " << singleTime << " s" << std::endl;
+		std::cout << "Sweep up to k     : " << sweepTime << " s" << std::endl;
+	}
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	evaluator.leaveOneOut(kMax);
+	double looTime = elapsedTime(start);
+	std::cout << "Leave-one-out     : " << looTime << " s" << std::endl << std::endl;
+
+	std::cout << std::setw(4) << "k" << std::setw(10) << "accuracy" << std::setw(13) << "latency(us)" << std::setw(10) << "loo" << std::setw(13) << "latency(us)" << std::endl;
+	for ( unsigned int k = 1; k <= kMax; ++k )
+	{
+		std::cout << std::setw(4) << k;
+		if ( passedOptions.count("queries") )
+			std::cout << std::setw(10) << std::setprecision(2) << accuracies[k-1] << std::setw(13) << std::setprecision(1) << latencies[k-1] * 1e6;
+		else
+			std::cout << std::setw(10) << "-" << std::setw(13) << "-";
+
+		std::cout << std::setw(10) << std::setprecision(2) << evaluator.accuracy(k) << std::setw(13) << std::setprecision(1) << evaluator.latency(k) * 1e6 << std::endl;
+	}
+
+	return 0;
+}
+
+
+/// @param argc		Number of command line arguments.
+/// @param argv[]	Command line arguments.
+///
+/// @return 0 if the program executed successfully, 1 otherwise.
+///
+///	@details	The program either compares the search engines of KnnClassificationAlgorithm on a reference dataset and a queries dataset, or
+///	reduces the reference dataset with the --condense option, trains a perceptron model with the --train-model option, or projects the reference
+///	dataset with the --project option, or sweeps the number of neighbours with the --sweep option.
+///
+/// @author Eliezer Talón (elitalon@gmail.com)
+/// @date 2026-10-18
+int main (int argc, char *argv[])
+{
+	// Declare program arguments and options
+	std::vector<unsigned int> probes(0);
+	std::vector<unsigned int> pivots(0);
+	std::vector<unsigned int> classes(0);
+	std::vector<std::string> steps(0);
+
+	po::options_description visibleOptions("Options");
+	visibleOptions.add_options()
+		("file,f",				po::value<std::string>(), "Plain text file with the reference dataset.")
+		("queries,q",			po::value<std::string>(), "Plain text file with the samples to search. Their labels are used to measure the accuracy.")
+		("knn,k",				po::value<unsigned int>()->default_value(1), "Maximum number of neighbours when using the KNN algorithm.")
+		("lists",				po::value<unsigned int>()->default_value(64), "Number of inverted lists of the approximate search.")
+		("subquantizers",		po::value<unsigned int>()->default_value(4), "Number of bytes per sample of the approximate search.")
+		("probes",				po::value< std::vector<unsigned int> >(&probes)->multitoken(), "Numbers of inverted lists visited per query to measure. Defaults to 1 2 4 8.")
+		("pivots",				po::value< std::vector<unsigned int> >(&pivots)->multitoken(), "Numbers of pivot samples of the pruned exact search to measure. Defaults to 8 16 32.")
+		("classes",				po::value< std::vector<unsigned int> >(&classes)->multitoken(), "Numbers of classes with the nearest mean scanned first to measure, both exactly and alone (~). Defaults to 1 3 10.")
+		("condense",			po::value<std::string>(), "Reduce the reference dataset and save the prototypes kept in the file passed, instead of measuring the search engines.")
+		("steps",				po::value< std::vector<std::string> >(&steps)->multitoken(), "Reduction steps to apply in order, among duplicates, wilson and hart. Defaults to duplicates hart.")
+		("edit-knn",			po::value<unsigned int>()->default_value(3), "Number of neighbours of Wilson's editing when reducing the dataset.")
+		("train-model",			po::value<std::string>(), "Train a perceptron model on the reference dataset and save it in the file passed, instead of measuring the search engines.")
+		("hidden",				po::value<unsigned int>()->default_value(64), "Number of hidden units of the perceptron model. Zero means a linear model.")
+		("epochs",				po::value<unsigned int>()->default_value(30), "Number of passes over the reference dataset when training the perceptron model.")
+		("rate",				po::value<double>()->default_value(0.05), "Initial learning rate when training the perceptron model.")
+		("project",				po::value<std::string>(), "Project the reference dataset with a whitened PCA and save it in the file passed, with the projection next to it.")
+		("components",			po::value<unsigned int>()->default_value(0), "Number of principal components kept by the --project option. Zero means all of them.")
+		("convert",				po::value<std::string>(), "Convert the reference dataset to binary, or to plain text if it is binary, and save it in the file passed, instead of measuring the search engines.")
+		("sweep",				po::value<unsigned int>(), "Measure the accuracy of every number of neighbours up to the value passed, on the queries and by leave-one-out, instead of measuring the search engines.")
+		("threads,j",			po::value<unsigned int>()->default_value(1), "Number of threads used by the --sweep option.")
+		("help,h",				"Print this help message");
+
+
+	// Parse the command line
+	po::variables_map passedOptions;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, visibleOptions), passedOptions);
+		po::notify(passedOptions);
+	}
+	catch (std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+
+	// Show help message
+	if ( passedOptions.count("help") )
+	{
+		std::cout << std::endl << "Usage: knntest [options]" << std::endl;
+		std::cout << visibleOptions << std::endl;
+		return 0;
+	}
+
+
+	// Test program arguments
+	if ( not passedOptions.count("file") or (not passedOptions.count("queries") and not passedOptions.count("condense") and not passedOptions.count("train-model") and not passedOptions.count("project") and not passedOptions.count("sweep") and not passedOptions.count("convert")) )
+	{
+		std::cerr << "knntest: Missing reference or queries dataset." << std::endl;
+		std::cerr << std::endl << "Usage: knntest [options]" << std::endl;
+		std::cerr << visibleOptions << std::endl;
+		return 1;
+	}
+
+	if ( probes.empty() )
+	{
+		probes.push_back(1);
+		probes.push_back(2);
+		probes.push_back(4);
+		probes.push_back(8);
+	}
+
+	if ( pivots.empty() )
+	{
+		pivots.push_back(8);
+		pivots.push_back(16);
+		pivots.push_back(32);
+	}
+
+	if ( classes.empty() )
+	{
+		classes.push_back(1);
+		classes.push_back(3);
+		classes.push_back(10);
+	}
+
+	if ( steps.empty() )
+	{
+		steps.push_back("duplicates");
+		steps.push_back("hart");
+	}
+
+	unsigned int k = passedOptions["knn"].as<unsigned int>();
+	if ( k == 0 )
+	{
+		std::cerr << "knntest: The number of neighbours must be greater than zero." << std::endl;
+		return 1;
+	}
+
+	try
+	{
+		if ( passedOptions.count("condense") )
+			return condenseDataset(passedOptions, steps);
+		else if ( passedOptions.count("train-model") )
+			return trainModel(passedOptions);
+		else if ( passedOptions.count("project") )
+			return projectDataset(passedOptions);
+		else if ( passedOptions.count("sweep") )
+			return sweepNeighbours(passedOptions);
+		else if ( passedOptions.count("convert") )
+			return convertDataset(passedOptions);
+		else
+			return compareEngines(passedOptions, probes, pivots, classes);
+	}
+	catch (std::exception &e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+}
@@ -4,7 +4,11 @@
 #include <Magick++.h>
 #include "NessieOcr.hpp"
 #include "DatasetEngine.hpp"
+#include "BinaryDataset.hpp"
+#include "SqliteDataset.hpp"
 #include "KnnClassifier.hpp"
+#include "CascadeClassifier.hpp"
+#include "PerceptronClassifier.hpp"
 #include "Text.hpp"
 
 #include <boost/program_options.hpp>
@@ -30,13 +34,28 @@ int main (int argc, char *argv[])
 	// Declare program arguments and options
 	po::options_description visibleOptions("Options");
 	visibleOptions.add_options()
-		("file,f",				po::value<std::string>(), "Use a plain text file as classification dataset.")
+		("file,f",				po::value< std::vector<std::string> >(), "Use a plain text, binary or SQLite file as classification dataset. Repeat it to use several files as the shards of a single dataset.")
 		("database,d",			po::value<std::string>()->default_value("db_nessieocr"), "Use a database as classification dataset. Superseded by the --file option.")
 		("user,u",				po::value<std::string>()->default_value("nessieocr"), "Database user.")
 		("password,p",			po::value<std::string>()->default_value("nessieocr"), "Database user's password.")
+		("mysql",				"Use a MySQL database instead of a PostgreSQL one.")
+		("snapshot",			po::value<std::string>(), "Keep a local copy of a PostgreSQL dataset in this file, so that later runs only fetch the samples added since.")
+		("batch",				po::value<unsigned int>()->default_value(256), "Number of samples inserted at once in a MySQL database.")
 		("text-training,t",		po::value<std::string>(), "Use a plain text file as reference text to execute a training.")
 		("auto-training,a",		"Use the image names without extension as the ASCII code to execute a training. E.g. 65.bmp means A.")
 		("knn,k",				po::value<unsigned int>()->default_value(1), "Maximum number of neighbours when using the KNN algorithm.")
+		("threads,j",			po::value<unsigned int>()->default_value(1), "Number of threads used when classifying.")
+		("lists",				po::value<unsigned int>()->default_value(0), "Number of inverted lists of an approximate KNN search. Zero means an exact search.")
+		("subquantizers",		po::value<unsigned int>()->default_value(4), "Number of bytes per sample of an approximate KNN search.")
+		("probes",				po::value<unsigned int>()->default_value(1), "Number of inverted lists visited per query in an approximate KNN search.")
+		("pivots",				po::value<unsigned int>()->default_value(0), "Number of pivot samples used to prune an exact KNN search. Zero means a linear scan. Superseded by the --lists option.")
+		("classes",				po::value<unsigned int>()->default_value(0), "Number of classes with the nearest mean scanned first in a KNN search. Zero means a linear scan. Superseded by the --lists and --pivots options.")
+		("only-classes",		"Scan only the classes with the nearest mean, which makes the --classes option approximate.")
+		("metric",				po::value<std::string>()->default_value("euclidean"), "Distance used by the KNN algorithm: euclidean, manhattan or mahalanobis. The manhattan distance only works with an exact scan or the --shards option.")
+		("weights",				po::value< std::vector<double> >()->multitoken(), "Weight of every feature in a weighted euclidean distance. Supersedes the --metric option.")
+		("shards",				po::value<unsigned int>()->implicit_value(0), "Scan the shards of the dataset concurrently, either one per file or the number of equal shards passed. Superseded by the --lists, --pivots and --classes options.")
+		("model",				po::value<std::string>(), "Classify with a perceptron model file trained by knntest instead of KNN. Supersedes the KNN options.")
+		("cascade,m",			po::value<double>(), "Classify by the nearest class mean every character whose margin, between 0 and 1, is at least the value passed, and the rest by KNN.")
 		("create-patterns,c",	"Create an output BMP image for each pattern found in the input image.")
 		("statistics,s",		"Show statistical data regarding the OCR process.")
 		("help,h",				"Print this help message");
@@ -83,15 +102,53 @@ int main (int argc, char *argv[])
 		return 1;
 	}
 
+	DistanceMetric metric = DistanceMetric::Euclidean();
+	if ( passedOptions.count("weights") )
+		metric = DistanceMetric::WeightedEuclidean(passedOptions["weights"].as< std::vector<double> >());
+	else if ( passedOptions["metric"].as<std::string>() == "manhattan" )
+		metric = DistanceMetric::Manhattan();
+	else if ( passedOptions["metric"].as<std::string>() == "mahalanobis" )
+		metric = DistanceMetric::Mahalanobis();
+	else if ( passedOptions["metric"].as<std::string>() != "euclidean" )
+	{
+		std::cerr << "ocrtest: Unknown distance metric " << passedOptions["metric"].as<std::string>() << "." << std::endl;
+		return 1;
+	}
+
 		
 	// Define the classifier
 	std::auto_ptr<Classifier> classifier;
 	try
 	{
+		SearchEngine search = SearchEngine::Exact();
+		if ( passedOptions["lists"].as<unsigned int>() > 0 )
+			search = SearchEngine::InvertedFile(passedOptions["lists"].as<unsigned int>(), passedOptions["subquantizers"].as<unsigned int>(), passedOptions["probes"].as<unsigned int>());
+		else if ( passedOptions["pivots"].as<unsigned int>() > 0 )
+			search = SearchEngine::Pivots(passedOptions["pivots"].as<unsigned int>());
+		else if ( passedOptions["classes"].as<unsigned int>() > 0 )
+			search = SearchEngine::ClassFilter(passedOptions["classes"].as<unsigned int>(), not passedOptions.count("only-classes"));
+		else if ( passedOptions.count("shards") )
+			search = SearchEngine::Shards(passedOptions["shards"].as<unsigned int>());
+
 		if ( passedOptions.count("file") )
 		{
-			std::string filename (passedOptions["file"].as<std::string>());
-			classifier.reset( new KnnClassifier(passedOptions["knn"].as<unsigned int>(), DatasetEngine::PlainText(filename)) );
+			std::vector<std::string> filenames (passedOptions["file"].as< std::vector<std::string> >());
+			DatasetEngine engine = DatasetEngine::PlainText(filenames.front());
+			if ( filenames.size() > 1 )
+				engine = DatasetEngine::Sharded(filenames);
+			else if ( BinaryDataset::recognizes(filenames.front()) )
+				engine = DatasetEngine::Binary(filenames.front());
+#if defined(_WITH_SQLITE_DATASET_)
+			else if ( SqliteDataset::recognizes(filenames.front()) )
+				engine = DatasetEngine::Sqlite(filenames.front());
+#endif
+
+			if ( passedOptions.count("model") )
+				classifier.reset( new PerceptronClassifier(passedOptions["model"].as<std::string>(), engine) );
+			else if ( passedOptions.count("cascade") )
+				classifier.reset( new CascadeClassifier(passedOptions["knn"].as<unsigned int>(), engine, passedOptions["cascade"].as<double>(), passedOptions["threads"].as<unsigned int>(), search, metric) );
+			else
+				classifier.reset( new KnnClassifier(passedOptions["knn"].as<unsigned int>(), engine, passedOptions["threads"].as<unsigned int>(), search, metric) );
 		}
 		else
 		{
@@ -99,7 +156,20 @@ int main (int argc, char *argv[])
 			std::string username ( passedOptions["user"].as<std::string>() );
 			std::string password ( passedOptions["password"].as<std::string>() );
 
-			classifier.reset( new KnnClassifier(passedOptions["knn"].as<unsigned int>(), DatasetEngine::PostgreSql(database, username, password)) );
+			std::string snapshot;
+			if ( passedOptions.count("snapshot") )
+				snapshot = passedOptions["snapshot"].as<std::string>();
+
+			DatasetEngine engine = DatasetEngine::PostgreSql(database, username, password, snapshot);
+			if ( passedOptions.count("mysql") )
+				engine = DatasetEngine::MySql(database, username, password, passedOptions["batch"].as<unsigned int>());
+
+			if ( passedOptions.count("model") )
+				classifier.reset( new PerceptronClassifier(passedOptions["model"].as<std::string>(), engine) );
+			else if ( passedOptions.count("cascade") )
+				classifier.reset( new CascadeClassifier(passedOptions["knn"].as<unsigned int>(), engine, passedOptions["cascade"].as<double>(), passedOptions["threads"].as<unsigned int>(), search, metric) );
+			else
+				classifier.reset( new KnnClassifier(passedOptions["knn"].as<unsigned int>(), engine, passedOptions["threads"].as<unsigned int>(), search, metric) );
 		}
 	}
 	catch (std::exception& e)
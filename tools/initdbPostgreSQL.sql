@@ -28,6 +28,29 @@ CREATE INDEX iClass ON samples(id_class);
 COMMENT ON TABLE samples IS 'Feature vectors associated to a class of characters.';
 
 
+-- Alternatively, the features can be stored as double precision numbers, which take less space, are sent faster and keep every bit of the
+-- features computed. To use this variant, create the samples table with the following statement instead of the one above.
+--
+-- CREATE TABLE samples (
+-- 	id_sample	serial				PRIMARY KEY,
+-- 	m10			double precision	NOT NULL DEFAULT 0.0,
+-- 	m01			double precision	NOT NULL DEFAULT 0.0,
+-- 	m11			double precision	NOT NULL DEFAULT 0.0,
+-- 	m20			double precision	NOT NULL DEFAULT 0.0,
+-- 	m02			double precision	NOT NULL DEFAULT 0.0,
+-- 	m21			double precision	NOT NULL DEFAULT 0.0,
+-- 	m12			double precision	NOT NULL DEFAULT 0.0,
+-- 	m22			double precision	NOT NULL DEFAULT 0.0,
+-- 	m30			double precision	NOT NULL DEFAULT 0.0,
+-- 	m03			double precision	NOT NULL DEFAULT 0.0,
+-- 	m31			double precision	NOT NULL DEFAULT 0.0,
+-- 	m13			double precision	NOT NULL DEFAULT 0.0,
+-- 	m32			double precision	NOT NULL DEFAULT 0.0,
+-- 	m23			double precision	NOT NULL DEFAULT 0.0,
+-- 	id_class	integer				REFERENCES classes
+-- );
+
+
 -- Insert data
 INSERT INTO classes (id_class, label, asciiCode) VALUES
 	(DEFAULT, '0', 48),
@@ -0,0 +1,134 @@
+-- Create the database with: sqlite3 nessieocr.db < initdbSQLite.sql
+
+-- Write-ahead logging lets the samples be read while a training inserts new ones, and it is kept by the database file
+PRAGMA journal_mode = WAL;
+
+-- Number of features of every sample, which are packed in the features column
+PRAGMA user_version = 14;
+
+
+CREATE TABLE classes (
+	id_class	INTEGER		PRIMARY KEY,
+	label		VARCHAR(2)	NOT NULL,
+	asciiCode	INTEGER		NOT NULL
+);
+
+
+-- The features of a sample are stored as an array of double precision numbers in the byte order of the machine that wrote them
+CREATE TABLE samples (
+	id_sample	INTEGER	PRIMARY KEY,
+	features	BLOB	NOT NULL,
+	id_class	INTEGER	REFERENCES classes
+);
+CREATE INDEX iClass ON samples(id_class);
+
+
+-- Insert data
+INSERT INTO classes (id_class, label, asciiCode) VALUES
+	(NULL, '0', 48),
+	(NULL, '1', 49),
+	(NULL, '2', 50),
+	(NULL, '3', 51),
+	(NULL, '4', 52),
+	(NULL, '5', 53),
+	(NULL, '6', 54),
+	(NULL, '7', 55),
+	(NULL, '8', 56),
+	(NULL, '9', 57),
+	(NULL, 'A', 65),
+	(NULL, 'B', 66),
+	(NULL, 'C', 67),
+	(NULL, 'D', 68),
+	(NULL, 'E', 69),
+	(NULL, 'F', 70),
+	(NULL, 'G', 71),
+	(NULL, 'H', 72),
+	(NULL, 'I', 73),
+	(NULL, 'J', 74),
+	(NULL, 'K', 75),
+	(NULL, 'L', 76),
+	(NULL, 'M', 77),
+	(NULL, 'N', 78),
+	(NULL, 'O', 79),
+	(NULL, 'P', 80),
+	(NULL, 'Q', 81),
+	(NULL, 'R', 82),
+	(NULL, 'S', 83),
+	(NULL, 'T', 84),
+	(NULL, 'U', 85),
+	(NULL, 'V', 86),
+	(NULL, 'W', 87),
+	(NULL, 'X', 88),
+	(NULL, 'Y', 89),
+	(NULL, 'Z', 90),
+	(NULL, 'a', 97),
+	(NULL, 'b', 98),
+	(NULL, 'c', 99),
+	(NULL, 'd', 100),
+	(NULL, 'e', 101),
+	(NULL, 'f', 102),
+	(NULL, 'g', 103),
+	(NULL, 'h', 104),
+	(NULL, 'i', 105),
+	(NULL, 'j', 106),
+	(NULL, 'k', 107),
+	(NULL, 'l', 108),
+	(NULL, 'm', 109),
+	(NULL, 'n', 110),
+	(NULL, 'o', 111),
+	(NULL, 'p', 112),
+	(NULL, 'q', 113),
+	(NULL, 'r', 114),
+	(NULL, 's', 115),
+	(NULL, 't', 116),
+	(NULL, 'u', 117),
+	(NULL, 'v', 118),
+	(NULL, 'w', 119),
+	(NULL, 'x', 120),
+	(NULL, 'y', 121),
+	(NULL, 'z', 122),
+	(NULL, 'Ñ', 209),
+	(NULL, 'Ç', 199),
+	(NULL, 'Á', 193),
+	(NULL, 'É', 201),
+	(NULL, 'Í', 205),
+	(NULL, 'Ó', 211),
+	(NULL, 'Ú', 218),
+	(NULL, 'Ü', 220),
+	(NULL, 'ñ', 241),
+	(NULL, 'á', 225),
+	(NULL, 'é', 233),
+	(NULL, 'í', 237),
+	(NULL, 'ó', 243),
+	(NULL, 'ú', 250),
+	(NULL, 'ü', 252),
+	(NULL, 'ç', 231),
+	(NULL, ' ', 32),
+	(NULL, '¡', 161),
+	(NULL, '!', 33),
+	(NULL, '¿', 191),
+	(NULL, '?', 63),
+	(NULL, '.', 46),
+	(NULL, ',', 44),
+	(NULL, ':', 58),
+	(NULL, ';', 59),
+	(NULL, '-', 45),
+	(NULL, '(', 40),
+	(NULL, ')', 41),
+	(NULL, '{', 123),
+	(NULL, '}', 125),
+	(NULL, '[', 91),
+	(NULL, ']', 93),
+	(NULL, '''', 39),
+	(NULL, '<', 60),
+	(NULL, '>', 62),
+	(NULL, '+', 43),
+	(NULL, '*', 42),
+	(NULL, '/', 47),
+	(NULL, '=', 61),
+	(NULL, '#', 35),
+	(NULL, '@', 64),
+	(NULL, '%', 37),
+	(NULL, '$', 36),
+	(NULL, '&', 38);
+